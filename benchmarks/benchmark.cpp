@@ -1,24 +1,10 @@
 #include <smart_buffer.hpp>
+#include "benchmark_timer.hpp"
+#include <array>
 #include <chrono>
 #include <iostream>
 #include <vector>
 
-// Simple benchmark helper
-class Timer {
-public:
-    Timer(const std::string& name) : name_(name), start_(std::chrono::high_resolution_clock::now()) {}
-    
-    ~Timer() {
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
-        std::cout << name_ << ": " << duration.count() << " μs" << std::endl;
-    }
-    
-private:
-    std::string name_;
-    std::chrono::high_resolution_clock::time_point start_;
-};
-
 void benchmark_static_vs_dynamic() {
     const int iterations = 100000;
     
@@ -132,6 +118,36 @@ void benchmark_memory_access() {
               << checksum1 << ", " << checksum2 << std::endl << std::endl;
 }
 
+void benchmark_vector_growth() {
+    const int elements = 1000000;
+    
+    std::cout << "=== Vector Growth Benchmark (" << elements << " push_backs) ===" << std::endl;
+    
+    // Trivially copyable static buffers let std::vector relocate with memmove
+    {
+        Timer timer("std::vector<SmartBuffer<16>> growth");
+        std::vector<SmartBuffer<16>> buffers;
+        for (int i = 0; i < elements; ++i) {
+            buffers.emplace_back();
+            buffers.back()[0] = static_cast<uint8_t>(i);
+        }
+        std::cout << "Final capacity: " << buffers.capacity() << std::endl;
+    }
+    
+    // Plain std::array of the same size as a baseline
+    {
+        Timer timer("std::vector<std::array<uint8_t, 16>> growth");
+        std::vector<std::array<uint8_t, 16>> buffers;
+        for (int i = 0; i < elements; ++i) {
+            buffers.emplace_back();
+            buffers.back()[0] = static_cast<uint8_t>(i);
+        }
+        std::cout << "Final capacity: " << buffers.capacity() << std::endl;
+    }
+    
+    std::cout << std::endl;
+}
+
 void demonstrate_automatic_selection() {
     std::cout << "=== Automatic Allocation Selection ===" << std::endl;
     
@@ -170,6 +186,7 @@ int main() {
     benchmark_static_vs_dynamic();
     benchmark_copy_operations();
     benchmark_memory_access();
+    benchmark_vector_growth();
     
     std::cout << "Performance notes:" << std::endl;
     std::cout << "- Static allocation shows minimal overhead" << std::endl;
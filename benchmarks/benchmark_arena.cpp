@@ -0,0 +1,78 @@
+#include <smart_buffer_arena.hpp>
+#include <smart_buffer_small_vector.hpp>
+#include "benchmark_timer.hpp"
+#include <iostream>
+
+// Simulates a request handler that creates dozens of temporary dynamic SmartBuffers
+// (256 B .. 4 KiB) and drops them all when the request finishes.
+
+namespace {
+
+constexpr int kStages = 12;
+
+// All buffers stay alive until the request completes, as they would while a
+// request is parsed, transformed and serialized
+std::uint64_t handle_request(int request) {
+    SmartBufferSmallVector<SmartBuffer<256>, kStages> headers;
+    SmartBufferSmallVector<SmartBuffer<1024>, kStages> bodies;
+    SmartBufferSmallVector<SmartBuffer<4096>, kStages> scratch;
+    std::uint64_t sum = 0;
+    for (int i = 0; i < kStages; ++i) {
+        headers.emplace_back();
+        bodies.emplace_back();
+        scratch.emplace_back();
+        headers[i][i] = static_cast<std::uint8_t>(request);
+        bodies[i][i * 8] = static_cast<std::uint8_t>(i);
+        scratch[i][i * 64] = headers[i][i];
+        sum += headers[i][i] + bodies[i][i * 8] + scratch[i][i * 64];
+    }
+    return sum;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Arena Benchmark" << std::endl;
+    std::cout << "===========================" << std::endl << std::endl;
+    
+    const int requests = 100000;
+    std::uint64_t checksum = 0;
+    
+    std::cout << "=== " << requests << " requests x 36 dynamic buffers (~64 KiB) ===" << std::endl;
+    {
+        Timer timer("Global heap (operator new[]/delete[])");
+        for (int r = 0; r < requests; ++r) {
+            checksum += handle_request(r);
+        }
+    }
+    {
+        Timer timer("SmartBufferArena per request (8 KiB inline, 64 KiB chunks)");
+        for (int r = 0; r < requests; ++r) {
+            SmartBufferArena<8192> arena;
+            SmartBufferResourceScope scope(&arena);
+            checksum += handle_request(r);
+        }
+    }
+    {
+        Timer timer("SmartBufferArena reused with release()");
+        SmartBufferArena<8192> arena(128 * 1024);
+        for (int r = 0; r < requests; ++r) {
+            {
+                SmartBufferResourceScope scope(&arena);
+                checksum += handle_request(r);
+            }
+            arena.release();
+        }
+    }
+    {
+        Timer timer("std::pmr::monotonic_buffer_resource per request");
+        for (int r = 0; r < requests; ++r) {
+            std::pmr::monotonic_buffer_resource arena(64 * 1024);
+            SmartBufferResourceScope scope(&arena);
+            checksum += handle_request(r);
+        }
+    }
+    
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <smart_buffer_budget.hpp>
+#include "benchmark_timer.hpp"
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Measures the cost of budget accounting for threads that allocate and free dynamic
+// SmartBuffers well under the limit, against the plain heap and a single shared
+// atomic counter.
+
+namespace {
+
+constexpr int kIterations = 400000;
+
+// Unsharded accounting for comparison: every allocation hits one shared counter
+class SharedCounterResource : public std::pmr::memory_resource {
+public:
+    std::atomic<std::size_t> used{0};
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        used.fetch_add(bytes, std::memory_order_relaxed);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+        used.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+std::atomic<std::uint64_t> g_checksum{0};
+
+void run(const std::string& name, unsigned threads, std::pmr::memory_resource* resource) {
+    Timer timer(name);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([resource, t] {
+            SmartBufferResourceScope scope(resource);
+            std::uint64_t sum = 0;
+            for (int i = 0; i < kIterations; ++i) {
+                SmartBuffer<1024> buffer;
+                buffer[i % 1024] = static_cast<std::uint8_t>(i + t);
+                sum += buffer[i % 1024];
+            }
+            g_checksum += sum;
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Budget Benchmark" << std::endl;
+    std::cout << "============================" << std::endl << std::endl;
+    
+    for (unsigned threads : {1u, 4u}) {
+        std::cout << "=== " << threads << " thread" << (threads > 1 ? "s" : "") << " x " << kIterations
+                  << " SmartBuffer<1024> allocate/free, under budget ===" << std::endl;
+        run("Global heap (no accounting)", threads, nullptr);
+        run("std::pmr::new_delete_resource (no accounting)", threads, std::pmr::new_delete_resource());
+        SharedCounterResource shared;
+        run("Single shared atomic counter", threads, &shared);
+        SmartBufferBudget budget(std::size_t{1} << 30);
+        run("SmartBufferBudget (sharded credit)", threads, &budget);
+        std::cout << "  budget used after run: " << budget.used() << " bytes" << std::endl;
+    }
+    
+    std::cout << "Checksum: " << g_checksum.load() << std::endl;
+    return 0;
+}
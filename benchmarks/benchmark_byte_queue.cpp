@@ -0,0 +1,67 @@
+#include <smart_buffer_byte_queue.hpp>
+#include "benchmark_timer.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Simulates HTTP-style response assembly: a body built from many small fragments,
+// followed by a header prepended once the body length is known.
+
+constexpr std::size_t kChunkSize = 4096;
+
+int main() {
+    std::cout << "SmartBuffer Byte Queue Benchmark" << std::endl;
+    std::cout << "================================" << std::endl << std::endl;
+    
+    const int responses = 20000;
+    const int fragments = 400;  // ~20-40 KiB bodies
+    std::vector<std::string> pieces;
+    for (int i = 0; i < 16; ++i) {
+        pieces.emplace_back(static_cast<std::size_t>(32 + i * 4), static_cast<char>('a' + i));
+    }
+    const std::string header = "HTTP/1.1 200 OK\r\nContent-Length: 00000\r\n\r\n";
+    
+    std::uint64_t checksum = 0;
+    
+    std::cout << "=== " << responses << " responses x " << fragments << " fragments ===" << std::endl;
+    {
+        SmartBufferPool<kChunkSize> pool;
+        Timer timer("SmartBufferByteQueue (pooled 4 KiB chunks, prepend header)");
+        for (int r = 0; r < responses; ++r) {
+            SmartBufferByteQueue<kChunkSize> queue(pool, 128);
+            for (int f = 0; f < fragments; ++f) {
+                const std::string& piece = pieces[(r + f) % pieces.size()];
+                queue.append(piece.data(), piece.size());
+            }
+            queue.prepend(header.data(), header.size());
+            struct iovec iov[16];
+            checksum += queue.gather(iov, 16) + queue.size();
+        }
+    }
+    {
+        Timer timer("std::vector<uint8_t> (grow by append, insert header)");
+        for (int r = 0; r < responses; ++r) {
+            std::vector<std::uint8_t> response;
+            for (int f = 0; f < fragments; ++f) {
+                const std::string& piece = pieces[(r + f) % pieces.size()];
+                response.insert(response.end(), piece.begin(), piece.end());
+            }
+            response.insert(response.begin(), header.begin(), header.end());
+            checksum += response.size();
+        }
+    }
+    {
+        Timer timer("std::string (grow by append, insert header)");
+        for (int r = 0; r < responses; ++r) {
+            std::string response;
+            for (int f = 0; f < fragments; ++f) {
+                response += pieces[(r + f) % pieces.size()];
+            }
+            response.insert(0, header);
+            checksum += response.size();
+        }
+    }
+    
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
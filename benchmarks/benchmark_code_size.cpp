@@ -0,0 +1,58 @@
+#include <smart_buffer.hpp>
+#include "benchmark_timer.hpp"
+#include <iostream>
+#include <utility>
+
+// Instantiates SmartBuffer for many distinct sizes so the per-symbol code size
+// report (target smartbuffer_code_size_report) shows how much code each
+// instantiation contributes.
+
+constexpr std::size_t kInstantiations = 150;
+constexpr std::size_t kFirstSize = 40;  // First dynamic size with the default threshold
+
+// Escapes buffer contents so the compiler cannot elide the allocations
+const std::uint8_t* volatile g_sink = nullptr;
+
+// Exercises the size-dependent API of one instantiation; kept out of line so
+// every N shows up as its own symbol in the report.
+template<std::size_t N>
+SMART_BUFFER_NOINLINE std::uint32_t exercise(std::uint8_t seed) {
+    SmartBuffer<N> buffer;
+    buffer.fill(seed);
+    SmartBuffer<N> copy(buffer);
+    copy[N - 1] = static_cast<std::uint8_t>(seed + 1);
+    buffer = copy;
+    buffer.fill_all(seed);
+    SmartBuffer<N> moved(std::move(copy));
+    g_sink = buffer.data();
+    g_sink = moved.data();
+    return static_cast<std::uint32_t>(buffer[0]) + moved[N - 1];
+}
+
+template<std::size_t... I>
+std::uint32_t exercise_all(std::uint8_t seed, std::index_sequence<I...>) {
+    return (exercise<kFirstSize + I * 8>(seed) + ...);
+}
+
+int main() {
+    std::cout << "SmartBuffer Code Size Benchmark" << std::endl;
+    std::cout << "===============================" << std::endl << std::endl;
+    
+    const int iterations = 1000;
+    std::uint32_t checksum = 0;
+    
+    std::cout << "=== " << kInstantiations << " SmartBuffer<N> instantiations ("
+              << iterations << " iterations) ===" << std::endl;
+    {
+        Timer timer("Construct/copy/assign/fill across all sizes");
+        for (int i = 0; i < iterations; ++i) {
+            checksum += exercise_all(static_cast<std::uint8_t>(i),
+                                     std::make_index_sequence<kInstantiations>{});
+        }
+    }
+    
+    std::cout << "Checksum: " << checksum << std::endl;
+    std::cout << "Build target smartbuffer_code_size_report for per-symbol sizes." << std::endl;
+    
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <smart_buffer_digest.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Digests buffers from 4 KiB to 64 MiB and reports GB/s for SHA-256 (portable block
+// function and the dispatched one) and BLAKE3 on one and on several threads.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr std::size_t kBytesPerRun = 256 << 20;
+
+template<typename Fn>
+double gigabytes_per_second(std::size_t size, Fn&& fn) {
+    std::size_t passes = std::max<std::size_t>(1, kBytesPerRun / size);
+    auto start = Clock::now();
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+        fn();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(size * passes) / seconds / 1e9;
+}
+
+void run(const std::vector<std::uint8_t>& data, std::size_t size, unsigned threads, std::uint64_t& checksum) {
+    SmartBuffer<32> digest;
+    std::cout << "=== " << (size >= (1 << 20) ? size >> 20 : size >> 10) << (size >= (1 << 20) ? " MiB" : " KiB")
+              << " (GB/s) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  SHA-256 portable:      " << gigabytes_per_second(size, [&] {
+        std::uint32_t state[8];
+        std::copy(smart_buffer_detail::SHA256_IV, smart_buffer_detail::SHA256_IV + 8, state);
+        smart_buffer_detail::sha256_compress_portable(state, data.data(), size / 64);
+        checksum += state[0];
+    }) << std::endl;
+    std::cout << "  SHA-256" << (smart_buffer_sha256_accelerated() ? " (SHA-NI):      " : ":               ")
+              << gigabytes_per_second(size, [&] {
+        digest = smart_buffer_sha256(data.data(), size);
+    }) << std::endl;
+    checksum += digest[0];
+    std::cout << "  BLAKE3, 1 thread:      " << gigabytes_per_second(size, [&] {
+        digest = smart_buffer_blake3(data.data(), size);
+    }) << std::endl;
+    checksum += digest[0];
+    std::cout << "  BLAKE3, " << threads << " threads:     " << gigabytes_per_second(size, [&] {
+        digest = smart_buffer_blake3(data.data(), size, threads);
+    }) << std::endl << std::endl;
+    checksum += digest[0];
+}
+
+const char* isa_name(SmartBufferHashIsa isa) {
+    switch (isa) {
+    case SmartBufferHashIsa::Avx512: return "AVX-512 (16 chunks per pass)";
+    case SmartBufferHashIsa::Avx2: return "AVX2 (8 chunks per pass)";
+    case SmartBufferHashIsa::Scalar: return "portable";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Digest Benchmark" << std::endl;
+    std::cout << "============================" << std::endl << std::endl;
+    unsigned threads = std::max(4u, std::thread::hardware_concurrency());
+    std::cout << "SHA-256: " << (smart_buffer_sha256_accelerated() ? "SHA extensions" : "portable") << std::endl;
+    std::cout << "BLAKE3:  " << isa_name(smart_buffer_hash_isa()) << std::endl;
+    std::cout << "CPUs:    " << std::thread::hardware_concurrency() << std::endl << std::endl;
+
+    std::vector<std::uint8_t> data(64 << 20);
+    std::mt19937_64 rng(72);
+    for (auto& byte : data) {
+        byte = static_cast<std::uint8_t>(rng());
+    }
+
+    std::uint64_t checksum = 0;
+    for (std::size_t size : {std::size_t(4) << 10, std::size_t(64) << 10, std::size_t(1) << 20, std::size_t(64) << 20}) {
+        run(data, size, threads, checksum);
+    }
+
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
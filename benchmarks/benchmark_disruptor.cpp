@@ -0,0 +1,206 @@
+#include <smart_buffer_disruptor.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A producer feeds 64-byte events through three chained stages, each on its own thread.
+// Latency: one event in flight at a time, measured from publication to the end of the
+// last stage. Throughput: the producer keeps the ring full. The baseline moves
+// SmartBuffers through mutex/condition-variable queues between the stages.
+
+namespace {
+
+using Event = SmartBuffer<64>;
+using Clock = std::chrono::steady_clock;
+constexpr int kLatencyEvents = 20000;
+constexpr int kThroughputEvents = 200000;
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void put(Event& event, std::size_t offset, std::int64_t value) {
+    std::memcpy(event.data() + offset, &value, sizeof(value));
+}
+
+std::int64_t get(const Event& event, std::size_t offset) {
+    std::int64_t value = 0;
+    std::memcpy(&value, event.data() + offset, sizeof(value));
+    return value;
+}
+
+void print_row(const char* name, std::vector<std::int64_t>& latencies, double seconds, int events) {
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))]; };
+    std::cout << std::left << std::setw(26) << name << std::right
+              << std::setw(10) << percentile(0.5) << std::setw(10) << percentile(0.99)
+              << std::setw(14) << std::fixed << std::setprecision(2) << events / seconds / 1e6 << std::endl;
+}
+
+template<typename Wait>
+std::int64_t run_disruptor(const char* name) {
+    SmartBufferDisruptor<64, Wait> ring(1024);
+    auto& first = ring.add_stage();
+    auto& second = ring.add_stage({&first});
+    auto& third = ring.add_stage({&second});
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(kLatencyEvents);
+    std::int64_t checksum = 0;
+    const int total = kLatencyEvents + kThroughputEvents;
+    
+    auto stage_thread = [&](auto& stage, std::size_t offset) {
+        return std::thread([&ring, &stage, offset, total] {
+            for (int done = 0; done < total;) {
+                done += static_cast<int>(ring.consume(stage, [offset](Event& event, std::int64_t, bool) {
+                    put(event, offset, get(event, offset - 8) + 1);
+                }));
+            }
+        });
+    };
+    std::thread t1 = stage_thread(first, 16);
+    std::thread t2 = stage_thread(second, 24);
+    std::thread t3([&] {
+        for (int done = 0; done < total;) {
+            done += static_cast<int>(ring.consume(third, [&](Event& event, std::int64_t seq, bool) {
+                if (seq < kLatencyEvents) {
+                    latencies.push_back(now_ns() - get(event, 0));
+                }
+                checksum += get(event, 24);
+            }));
+        }
+    });
+    
+    for (int i = 0; i < kLatencyEvents; ++i) {
+        auto seq = ring.claim();
+        put(ring[seq], 8, i);
+        put(ring[seq], 0, now_ns());
+        ring.publish(seq);
+        while (third.sequence() < seq) {
+            std::this_thread::yield();
+        }
+    }
+    auto start = Clock::now();
+    for (int i = 0; i < kThroughputEvents;) {
+        int batch = std::min(64, kThroughputEvents - i);
+        auto seq = ring.claim(static_cast<std::size_t>(batch));
+        for (int k = 0; k < batch; ++k) {
+            put(ring[seq + k], 8, i + k);
+        }
+        ring.publish(seq, static_cast<std::size_t>(batch));
+        i += batch;
+    }
+    t1.join();
+    t2.join();
+    t3.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    print_row(name, latencies, seconds, kThroughputEvents);
+    return checksum;
+}
+
+// Baseline: SmartBuffers moved through locked queues
+struct LockedQueue {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Event> events;
+    
+    void push(Event&& event) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back(std::move(event));
+        }
+        ready.notify_one();
+    }
+    
+    Event pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return !events.empty(); });
+        Event event = std::move(events.front());
+        events.pop_front();
+        return event;
+    }
+};
+
+std::int64_t run_locked(const char* name) {
+    LockedQueue queues[4];
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(kLatencyEvents);
+    std::int64_t checksum = 0;
+    const int total = kLatencyEvents + kThroughputEvents;
+    std::atomic<int> finished{0};
+    
+    auto stage_thread = [&](int index, std::size_t offset) {
+        return std::thread([&queues, index, offset, total] {
+            for (int done = 0; done < total; ++done) {
+                Event event = queues[index].pop();
+                put(event, offset, get(event, offset - 8) + 1);
+                queues[index + 1].push(std::move(event));
+            }
+        });
+    };
+    std::thread t1 = stage_thread(0, 16);
+    std::thread t2 = stage_thread(1, 24);
+    std::thread t3([&] {
+        for (int done = 0; done < total; ++done) {
+            Event event = queues[2].pop();
+            if (done < kLatencyEvents) {
+                latencies.push_back(now_ns() - get(event, 0));
+            }
+            checksum += get(event, 24);
+            finished.store(done + 1, std::memory_order_release);
+        }
+    });
+    
+    for (int i = 0; i < kLatencyEvents; ++i) {
+        Event event;
+        put(event, 8, i);
+        put(event, 0, now_ns());
+        queues[0].push(std::move(event));
+        while (finished.load(std::memory_order_acquire) <= i) {
+            std::this_thread::yield();
+        }
+    }
+    auto start = Clock::now();
+    for (int i = 0; i < kThroughputEvents; ++i) {
+        Event event;
+        put(event, 8, i);
+        queues[0].push(std::move(event));
+    }
+    t1.join();
+    t2.join();
+    t3.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    print_row(name, latencies, seconds, kThroughputEvents);
+    return checksum;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Disruptor Benchmark" << std::endl;
+    std::cout << "===============================" << std::endl << std::endl;
+    unsigned cores = std::thread::hardware_concurrency();
+    std::cout << "Hardware threads: " << cores << std::endl << std::endl;
+    
+    std::int64_t checksum = 0;
+    std::cout << "=== Three-stage pipeline, 64-byte events ===" << std::endl;
+    std::cout << "handoff                     p50 (ns)  p99 (ns)  throughput (M/s)" << std::endl;
+    if (cores >= 4) {
+        checksum += run_disruptor<SmartBufferBusySpinWait>("disruptor, busy-spin");
+    } else {
+        std::cout << "disruptor, busy-spin      skipped: needs a core per stage" << std::endl;
+    }
+    checksum += run_disruptor<SmartBufferYieldWait>("disruptor, yield");
+    checksum += run_disruptor<SmartBufferFutexWait>("disruptor, futex");
+    checksum += run_locked("mutex + condvar queues");
+    
+    std::cout << std::endl << "Checksum: " << checksum << std::endl;
+    return 0;
+}
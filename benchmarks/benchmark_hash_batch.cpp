@@ -0,0 +1,93 @@
+#include <smart_buffer_hash_batch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Hashes a cache-resident set of equally sized SmartBuffers (4 MiB) repeatedly, one at
+// a time and with the batch API, and reports millions of hashes per second.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr std::size_t kDataBytes = 4 << 20;
+constexpr std::size_t kHashesPerRun = 32 << 20;
+
+template<typename Fn>
+double mhashes_per_second(std::size_t count, Fn&& fn) {
+    std::size_t passes = kHashesPerRun / count;
+    auto start = Clock::now();
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+        fn();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(count * passes) / seconds / 1e6;
+}
+
+const char* isa_name(SmartBufferHashIsa isa) {
+    switch (isa) {
+    case SmartBufferHashIsa::Avx512: return "AVX-512 (16 lanes)";
+    case SmartBufferHashIsa::Avx2: return "AVX2 (4 lanes)";
+    case SmartBufferHashIsa::Scalar: return "scalar";
+    }
+    return "?";
+}
+
+template<std::size_t Size>
+void run(std::uint64_t& checksum) {
+    constexpr std::size_t kCount = kDataBytes / Size;
+    std::mt19937_64 rng(Size);
+    std::vector<SmartBuffer<Size>> buffers(kCount);
+    for (auto& buffer : buffers) {
+        for (std::size_t i = 0; i < Size; i += 8) {
+            std::uint64_t word = rng();
+            std::memcpy(buffer.data() + i, &word, std::min<std::size_t>(8, Size - i));
+        }
+    }
+    std::vector<std::uint64_t> hashes(kCount);
+    std::vector<std::uint32_t> crcs(kCount);
+    
+    std::cout << "=== SmartBuffer<" << Size << ">, " << kCount << " buffers (M hashes/s) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  XXH64 one at a time:   " << mhashes_per_second(kCount, [&] {
+        for (std::size_t i = 0; i < kCount; ++i) {
+            hashes[i] = smart_buffer_hash(buffers[i]);
+        }
+    }) << std::endl;
+    checksum += hashes[kCount / 3];
+    std::cout << "  XXH64 batch:           " << mhashes_per_second(kCount, [&] {
+        smart_buffer_hash_batch(buffers.data(), kCount, hashes.data());
+    }) << std::endl;
+    checksum += hashes[kCount / 3];
+    std::cout << "  CRC32C one at a time:  " << mhashes_per_second(kCount, [&] {
+        for (std::size_t i = 0; i < kCount; ++i) {
+            crcs[i] = smart_buffer_crc32c(buffers[i].data(), Size);
+        }
+    }) << std::endl;
+    checksum += crcs[kCount / 3];
+    std::cout << "  CRC32C batch:          " << mhashes_per_second(kCount, [&] {
+        smart_buffer_crc32c_batch(buffers.data(), kCount, crcs.data());
+    }) << std::endl << std::endl;
+    checksum += crcs[kCount / 3];
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Batch Hash Benchmark" << std::endl;
+    std::cout << "================================" << std::endl << std::endl;
+    std::cout << "XXH64 batch kernel: " << isa_name(smart_buffer_hash_isa()) << std::endl << std::endl;
+    
+    std::uint64_t checksum = 0;
+    run<16>(checksum);
+    run<32>(checksum);
+    run<64>(checksum);
+    run<128>(checksum);
+    run<256>(checksum);
+    
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
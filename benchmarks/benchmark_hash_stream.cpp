@@ -0,0 +1,133 @@
+#include <smart_buffer_hash_stream.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Checksums a payload of SmartBuffer4K chunks: copied into one buffer and hashed
+// one-shot, streamed chunk by chunk, and split across threads whose CRC32Cs are merged
+// with smart_buffer_crc32c_combine(). Reports GB/s.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr std::size_t kChunks = 4096;   // 16 MiB payload
+constexpr std::size_t kPasses = 16;
+
+template<typename Fn>
+double gigabytes_per_second(Fn&& fn) {
+    auto start = Clock::now();
+    for (std::size_t pass = 0; pass < kPasses; ++pass) {
+        fn();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(kChunks * 4096 * kPasses) / seconds / 1e9;
+}
+
+std::uint32_t parallel_crc32c(const std::vector<SmartBuffer4K>& chunks, unsigned thread_count) {
+    std::vector<SmartBufferCrc32c> parts(thread_count);
+    std::vector<std::thread> threads;
+    std::size_t per_thread = (chunks.size() + thread_count - 1) / thread_count;
+    for (unsigned t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            std::size_t end = std::min(chunks.size(), (t + 1) * per_thread);
+            for (std::size_t i = t * per_thread; i < end; ++i) {
+                parts[t].update(chunks[i]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    SmartBufferCrc32c merged;
+    for (const auto& part : parts) {
+        merged.append(part);
+    }
+    return merged.finalize();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Streaming Hash Benchmark" << std::endl;
+    std::cout << "====================================" << std::endl << std::endl;
+
+    std::vector<SmartBuffer4K> chunks(kChunks);
+    std::mt19937_64 rng(73);
+    for (auto& chunk : chunks) {
+        for (std::size_t i = 0; i < chunk.size(); i += 8) {
+            std::uint64_t word = rng();
+            std::memcpy(chunk.data() + i, &word, 8);
+        }
+    }
+    std::vector<std::uint8_t> flat(kChunks * 4096);
+    unsigned threads = std::max(4u, std::thread::hardware_concurrency());
+    std::uint64_t checksum = 0;
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "=== CRC32C of " << kChunks << " x 4 KiB chunks (GB/s) ===" << std::endl;
+    std::uint32_t crc = 0;
+    std::cout << "  copy + one-shot:       " << gigabytes_per_second([&] {
+        for (std::size_t i = 0; i < kChunks; ++i) {
+            std::memcpy(flat.data() + i * 4096, chunks[i].data(), 4096);
+        }
+        crc = smart_buffer_crc32c(flat.data(), flat.size());
+    }) << std::endl;
+    checksum += crc;
+    std::cout << "  streaming:             " << gigabytes_per_second([&] {
+        SmartBufferCrc32c stream;
+        for (const auto& chunk : chunks) {
+            stream.update(chunk);
+        }
+        crc = stream.finalize();
+    }) << std::endl;
+    checksum += crc;
+    std::cout << "  per-chunk + combine:   " << gigabytes_per_second([&] {
+        std::vector<std::uint32_t> crcs(kChunks);
+        for (std::size_t i = 0; i < kChunks; ++i) {
+            crcs[i] = smart_buffer_crc32c(chunks[i].data(), 4096);
+        }
+        crc = smart_buffer_crc32c_combine(crcs.data(), kChunks, 4096);
+    }) << std::endl;
+    checksum += crc;
+    std::cout << "  " << threads << " threads + combine:   " << gigabytes_per_second([&] {
+        crc = parallel_crc32c(chunks, threads);
+    }) << std::endl << std::endl;
+    checksum += crc;
+
+    std::cout << "=== XXH64 of " << kChunks << " x 4 KiB chunks (GB/s) ===" << std::endl;
+    std::uint64_t hash = 0;
+    std::cout << "  copy + one-shot:       " << gigabytes_per_second([&] {
+        for (std::size_t i = 0; i < kChunks; ++i) {
+            std::memcpy(flat.data() + i * 4096, chunks[i].data(), 4096);
+        }
+        hash = smart_buffer_detail::xxh64(flat.data(), flat.size(), 0);
+    }) << std::endl;
+    checksum += hash;
+    std::cout << "  streaming:             " << gigabytes_per_second([&] {
+        SmartBufferXxh64 stream;
+        for (const auto& chunk : chunks) {
+            stream.update(chunk);
+        }
+        hash = stream.finalize();
+    }) << std::endl << std::endl;
+    checksum += hash;
+
+    std::cout << "=== smart_buffer_crc32c_combine (ns per call) ===" << std::endl;
+    constexpr std::size_t kCombines = 1 << 20;
+    auto start = Clock::now();
+    std::uint32_t combined = 0;
+    for (std::size_t i = 0; i < kCombines; ++i) {
+        combined = smart_buffer_crc32c_combine(combined, static_cast<std::uint32_t>(i), 4096 + (i & 1023));
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "  4-5 KiB pieces:        " << seconds * 1e9 / kCombines << std::endl << std::endl;
+    checksum += combined;
+
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
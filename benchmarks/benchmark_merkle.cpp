@@ -0,0 +1,98 @@
+#include <smart_buffer_merkle.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Measures Merkle tree construction over 256 MiB of 4 KiB blocks on one and several
+// threads, single-block updates against full rebuilds, and proof generation and
+// verification rates.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Tree = SmartBufferMerkleTree<4096>;
+constexpr std::size_t kBlocks = 64 * 1024;
+constexpr std::size_t kUpdates = 100000;
+constexpr std::size_t kProofs = 100000;
+
+template<typename Fn>
+double seconds(Fn&& fn) {
+    auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Merkle Tree Benchmark" << std::endl;
+    std::cout << "=================================" << std::endl << std::endl;
+
+    std::vector<SmartBuffer4K> blocks(kBlocks);
+    std::mt19937_64 rng(75);
+    for (auto& block : blocks) {
+        auto* words = reinterpret_cast<std::uint64_t*>(block.data());
+        for (std::size_t i = 0; i < block.size() / 8; ++i) {
+            words[i] = rng();
+        }
+    }
+    double bytes = static_cast<double>(kBlocks) * 4096;
+    unsigned many = std::max(4u, std::thread::hardware_concurrency());
+    std::uint64_t checksum = 0;
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "=== Build over " << kBlocks << " x 4 KiB blocks (GB/s, SHA-256 "
+              << (smart_buffer_sha256_accelerated() ? "SHA-NI" : "portable") << ") ===" << std::endl;
+    Tree tree;
+    double build_1 = seconds([&] { tree.build(blocks.data(), blocks.size(), 1); });
+    checksum += tree.root()[0];
+    std::cout << "  1 thread:   " << bytes / build_1 / 1e9 << std::endl;
+    double build_n = seconds([&] { tree.build(blocks.data(), blocks.size(), many); });
+    checksum += tree.root()[0];
+    std::cout << "  " << many << " threads:  " << bytes / build_n / 1e9
+              << "  (" << std::thread::hardware_concurrency() << " hardware threads)" << std::endl << std::endl;
+
+    std::cout << "=== Single-block updates ===" << std::endl;
+    std::vector<std::size_t> indices(kUpdates);
+    for (auto& index : indices) {
+        index = rng() % kBlocks;
+    }
+    double update = seconds([&] {
+        for (std::size_t index : indices) {
+            blocks[index][0] ^= 1;
+            tree.update(index, blocks[index]);
+        }
+    });
+    checksum += tree.root()[0];
+    std::cout << "  update():      " << std::setprecision(0) << static_cast<double>(kUpdates) / update
+              << " updates/s, " << std::setprecision(2) << update / kUpdates * 1e6 << " us each" << std::endl;
+    std::cout << "  full rebuild:  " << build_1 * 1e3 << " ms, "
+              << std::setprecision(0) << build_1 / (update / kUpdates) << "x slower per change" << std::endl
+              << std::endl;
+
+    std::cout << "=== Proofs (" << tree.level_count() - 1 << " siblings each) ===" << std::endl;
+    auto root = tree.root();
+    std::size_t verified = 0;
+    std::vector<Tree::Proof> proofs(kProofs);
+    double prove = seconds([&] {
+        for (std::size_t i = 0; i < kProofs; ++i) {
+            proofs[i] = tree.prove(indices[i % kUpdates]);
+        }
+    });
+    double verify = seconds([&] {
+        for (std::size_t i = 0; i < kProofs; ++i) {
+            verified += Tree::verify(root, tree.size(), blocks[proofs[i].index], proofs[i]) ? 1 : 0;
+        }
+    });
+    checksum += verified;
+    std::cout << "  prove():   " << static_cast<double>(kProofs) / prove << " proofs/s" << std::endl;
+    std::cout << "  verify():  " << static_cast<double>(kProofs) / verify << " proofs/s ("
+              << verified << "/" << kProofs << " valid)" << std::endl << std::endl;
+
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <smart_buffer_percpu.hpp>
+#include "benchmark_timer.hpp"
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Footprint: 2000 threads, each formats one message into a 16 KiB scratch buffer and
+// then parks (thread-per-connection service at rest); resident memory is compared for
+// thread_local scratch and per-CPU scratch. Each case runs in a fresh child process.
+// Access cost: one thread repeatedly formats a short message into its scratch buffer.
+
+namespace {
+
+using Scratch = SmartBuffer<16384>;
+constexpr int kThreads = 2000;
+constexpr int kIterations = 10000000;
+
+long resident_kib() {
+    long pages = 0;
+    long resident = 0;
+    if (FILE* file = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(file, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        std::fclose(file);
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+std::uint64_t format_message(Scratch& scratch, std::uint64_t id) {
+    // Touch the whole buffer, as a serializer that builds a full frame would
+    std::memset(scratch.data(), static_cast<int>(id), scratch.size());
+    return scratch[id % scratch.size()];
+}
+
+template<typename Use>
+void park_threads(const char* name, Use&& use) {
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        long before = resident_kib();
+        std::mutex mutex;
+        std::condition_variable release;
+        bool done = false;
+        int ready = 0;
+        std::vector<std::thread> threads;
+        threads.reserve(kThreads);
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                use(static_cast<std::uint64_t>(t));
+                std::unique_lock<std::mutex> lock(mutex);
+                ++ready;
+                release.notify_all();
+                release.wait(lock, [&] { return done; });
+            });
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            release.wait(lock, [&] { return ready == kThreads; });
+        }
+        long after = resident_kib();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        release.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        std::cout << "  " << name << ": +" << (after - before) / 1024 << " MiB resident with "
+                  << kThreads << " parked threads" << std::endl;
+        std::cout.flush();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+SmartBufferPerCpuScratch<16384> g_per_cpu;
+
+Scratch& thread_scratch() {
+    thread_local Scratch scratch;
+    return scratch;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Per-CPU Scratch Benchmark" << std::endl;
+    std::cout << "=====================================" << std::endl << std::endl;
+    std::cout << "Scratch slots (possible CPUs): " << g_per_cpu.slot_count()
+              << ", rseq cpu id: " << (SMART_BUFFER_HAS_RSEQ ? "yes" : "no") << std::endl << std::endl;
+    
+    std::cout << "=== Memory footprint, 16 KiB scratch ===" << std::endl;
+    park_threads("thread_local", [](std::uint64_t id) { format_message(thread_scratch(), id); });
+    park_threads("per-CPU     ", [](std::uint64_t id) {
+        g_per_cpu.with([id](Scratch& scratch) { format_message(scratch, id); });
+    });
+    std::cout << std::endl;
+    
+    std::cout << "=== Access cost (lease + 64-byte write), " << kIterations << " iterations ===" << std::endl;
+    std::uint64_t checksum = 0;
+    {
+        Timer timer("  thread_local");
+        for (int i = 0; i < kIterations; ++i) {
+            Scratch& scratch = thread_scratch();
+            std::memset(scratch.data(), i, 64);
+            checksum += scratch[static_cast<std::size_t>(i) & 63];
+        }
+    }
+    {
+        Timer timer("  per-CPU (cpu id + slot flag)");
+        for (int i = 0; i < kIterations; ++i) {
+            checksum += g_per_cpu.with([i](Scratch& scratch) {
+                std::memset(scratch.data(), i, 64);
+                return scratch[static_cast<std::size_t>(i) & 63];
+            });
+        }
+    }
+    {
+        Timer timer("  sched_getcpu() alone");
+        for (int i = 0; i < kIterations; ++i) {
+            checksum += static_cast<std::uint64_t>(sched_getcpu());
+        }
+    }
+    std::cout << "  fallbacks: " << g_per_cpu.stats().fallbacks << std::endl;
+    
+    std::cout << std::endl << "Checksum: " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <smart_buffer_rcu.hpp>
+#include "benchmark_timer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Readers look up 8 bytes at a pseudo-random offset of a 1 MiB table while a writer
+// publishes a new version every millisecond. Compares the read-side cost of RCU with a
+// std::shared_mutex and with std::atomic_load of a std::shared_ptr, then measures the
+// writer's update latency (copy + publish) and the time until the old version is freed.
+
+namespace {
+
+using Table = SmartBuffer<1 << 20>;
+constexpr auto kDuration = std::chrono::milliseconds(300);
+
+std::atomic<std::uint64_t> g_checksum{0};
+
+struct RcuTable {
+    SmartBufferRcu<Table> rcu;
+    
+    struct Reader {
+        SmartBufferRcu<Table>::Reader reader;
+        std::uint8_t lookup(std::size_t offset) const { return (*reader.read())[offset]; }
+    };
+    
+    Reader make_reader() { return Reader{rcu.make_reader()}; }
+    void update(std::uint8_t value) { rcu.update([&](Table& table) { table[value] = value; }); }
+};
+
+struct SharedMutexTable {
+    mutable std::shared_mutex mutex;
+    Table table;
+    
+    struct Reader {
+        const SharedMutexTable* owner;
+        std::uint8_t lookup(std::size_t offset) const {
+            std::shared_lock<std::shared_mutex> lock(owner->mutex);
+            return owner->table[offset];
+        }
+    };
+    
+    Reader make_reader() { return Reader{this}; }
+    void update(std::uint8_t value) {
+        Table next = table;  // Same copy-then-swap work as the RCU writer
+        next[value] = value;
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        table = std::move(next);
+    }
+};
+
+struct SharedPtrTable {
+    std::shared_ptr<const Table> current = std::make_shared<Table>();
+    
+    struct Reader {
+        const SharedPtrTable* owner;
+        std::uint8_t lookup(std::size_t offset) const {
+            return (*std::atomic_load(&owner->current))[offset];
+        }
+    };
+    
+    Reader make_reader() { return Reader{this}; }
+    void update(std::uint8_t value) {
+        auto next = std::make_shared<Table>(*std::atomic_load(&current));
+        (*next)[value] = value;
+        std::atomic_store(&current, std::shared_ptr<const Table>(std::move(next)));
+    }
+};
+
+template<typename Published>
+double ns_per_read(int readers) {
+    Published published;
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> total{0};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            auto reader = published.make_reader();
+            std::uint64_t count = 0;
+            std::uint64_t sum = 0;
+            std::size_t offset = static_cast<std::size_t>(r) * 4099;
+            while (!stop.load(std::memory_order_relaxed)) {
+                offset = (offset * 1103515245 + 12345) & ((1 << 20) - 1);
+                sum += reader.lookup(offset);
+                ++count;
+            }
+            total += count;
+            g_checksum += sum;
+        });
+    }
+    std::thread writer([&] {
+        std::uint8_t value = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            published.update(++value);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    std::this_thread::sleep_for(kDuration);
+    stop = true;
+    writer.join();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    // CPU time available to the readers, divided by reads
+    double reader_ns = std::chrono::duration<double, std::nano>(kDuration).count()
+                       * std::min<unsigned>(readers, std::max(1u, std::thread::hardware_concurrency()));
+    return reader_ns / static_cast<double>(total.load());
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer RCU Benchmark" << std::endl;
+    std::cout << "=========================" << std::endl << std::endl;
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl << std::endl;
+    
+    std::cout << "=== Read-side cost per lookup in a 1 MiB table (ns), one writer at 1 kHz ===" << std::endl;
+    std::cout << "readers   SmartBufferRcu   std::shared_mutex   atomic shared_ptr" << std::endl;
+    for (int readers : {1, 4, 16, 64}) {
+        double rcu = ns_per_read<RcuTable>(readers);
+        double mutex = ns_per_read<SharedMutexTable>(readers);
+        double shared = ns_per_read<SharedPtrTable>(readers);
+        std::cout << std::setw(7) << readers << std::fixed << std::setprecision(1)
+                  << std::setw(17) << rcu << std::setw(20) << mutex << std::setw(20) << shared << std::endl;
+    }
+    std::cout << std::endl;
+    
+    std::cout << "=== Update latency with 8 readers running ===" << std::endl;
+    {
+        SmartBufferRcu<Table> rcu;
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> threads;
+        for (int r = 0; r < 8; ++r) {
+            threads.emplace_back([&] {
+                auto reader = rcu.make_reader();
+                std::uint64_t sum = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto guard = reader.read();
+                    sum += (*guard)[sum & 0xFFFF];
+                }
+                g_checksum += sum;
+            });
+        }
+        constexpr int kUpdates = 200;
+        {
+            Timer timer("  update (copy 1 MiB + publish) x" + std::to_string(kUpdates));
+            for (int i = 0; i < kUpdates; ++i) {
+                rcu.update([i](Table& table) { table[i] = static_cast<std::uint8_t>(i); });
+            }
+        }
+        {
+            Timer timer("  synchronize (wait until old versions are freed)");
+            rcu.synchronize();
+        }
+        stop = true;
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+    
+    std::cout << std::endl << "Checksum: " << g_checksum.load() << std::endl;
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <smart_buffer_segmented.hpp>
+#include "benchmark_timer.hpp"
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Compares segmented storage with one contiguous SmartBuffer of the same size.
+
+constexpr std::size_t kSize = std::size_t{1} << 26;  // 64 MiB
+
+using Contiguous = SmartBuffer<kSize>;
+using Segmented = SmartBufferSegmented<kSize, 16>;
+using SegmentedLazy = SmartBufferSegmentedLazy<kSize, 16>;
+
+template<typename Buffer>
+std::uint64_t sequential_sum(const Buffer& buffer) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < kSize; ++i) {
+        sum += buffer[i];
+    }
+    return sum;
+}
+
+template<typename Buffer>
+std::uint64_t random_sum(const Buffer& buffer, const std::vector<std::uint32_t>& indices) {
+    std::uint64_t sum = 0;
+    for (std::uint32_t index : indices) {
+        sum += buffer[index];
+    }
+    return sum;
+}
+
+int main() {
+    std::cout << "SmartBuffer Segmented Storage Benchmark" << std::endl;
+    std::cout << "=======================================" << std::endl << std::endl;
+    
+    std::uint64_t checksum = 0;
+    
+    std::cout << "=== Construction (" << (kSize >> 20) << " MiB) ===" << std::endl;
+    std::unique_ptr<Contiguous> contiguous;
+    std::unique_ptr<Segmented> segmented;
+    std::unique_ptr<SegmentedLazy> lazy;
+    {
+        Timer timer("Contiguous SmartBuffer");
+        contiguous = std::make_unique<Contiguous>();
+    }
+    {
+        Timer timer("Segmented (eager, 64 KiB segments)");
+        segmented = std::make_unique<Segmented>();
+    }
+    {
+        Timer timer("Segmented (lazy)");
+        lazy = std::make_unique<SegmentedLazy>();
+    }
+    std::cout << std::endl;
+    
+    contiguous->fill(1);
+    segmented->fill(1);
+    
+    std::cout << "=== Sequential access ===" << std::endl;
+    {
+        Timer timer("Contiguous operator[]");
+        checksum += sequential_sum(*contiguous);
+    }
+    {
+        Timer timer("Segmented operator[] (shift/mask)");
+        checksum += sequential_sum(*segmented);
+    }
+    {
+        Timer timer("Segmented for_each_segment (bulk kernel)");
+        std::uint64_t sum = 0;
+        static_cast<const Segmented&>(*segmented).for_each_segment([&](std::size_t, SmartBufferConstSegment segment) {
+            for (std::size_t i = 0; i < segment.size; ++i) {
+                sum += segment.data[i];
+            }
+        });
+        checksum += sum;
+    }
+    std::cout << std::endl;
+    
+    std::cout << "=== Random access (4M reads) ===" << std::endl;
+    std::mt19937 rng(7);
+    std::vector<std::uint32_t> indices(1 << 22);
+    for (auto& index : indices) {
+        index = static_cast<std::uint32_t>(rng() % kSize);
+    }
+    {
+        Timer timer("Contiguous operator[]");
+        checksum += random_sum(*contiguous, indices);
+    }
+    {
+        Timer timer("Segmented operator[] (shift/mask)");
+        checksum += random_sum(*segmented, indices);
+    }
+    {
+        Timer timer("Segmented lazy writes (allocate on touch)");
+        for (std::size_t i = 0; i < indices.size(); i += 64) {
+            (*lazy)[indices[i]] = 1;
+        }
+    }
+    std::cout << "Lazy buffer allocated: " << (lazy->allocated_bytes() >> 20) << " MiB" << std::endl;
+    
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
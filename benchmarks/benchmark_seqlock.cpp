@@ -0,0 +1,92 @@
+#include <smart_buffer_seqlock.hpp>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+// One writer publishes a 64-byte snapshot every few microseconds while N readers copy
+// it in a loop. Reports total reads per second for the seqlock and for a
+// std::shared_mutex-protected SmartBuffer.
+
+namespace {
+
+using Snapshot = SmartBufferAlwaysStatic<64>;
+constexpr auto kDuration = std::chrono::milliseconds(300);
+
+struct SharedMutexSnapshot {
+    mutable std::shared_mutex mutex;
+    Snapshot buffer;
+    
+    template<typename Fn>
+    void write(Fn&& fn) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        fn(buffer);
+    }
+    
+    void read(Snapshot& out) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        out = buffer;
+    }
+};
+
+std::atomic<std::uint64_t> g_checksum{0};
+
+template<typename Published>
+double reads_per_second(Published& published, int readers) {
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> total{0};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            Snapshot out;
+            std::uint64_t count = 0;
+            std::uint64_t sum = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                published.read(out);
+                sum += out[r % 64];
+                ++count;
+            }
+            total += count;
+            g_checksum += sum;
+        });
+    }
+    std::thread writer([&] {
+        std::uint8_t value = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            published.write([&](Snapshot& buffer) { buffer.fill(++value); });
+            std::this_thread::sleep_for(std::chrono::microseconds(5));
+        }
+    });
+    std::this_thread::sleep_for(kDuration);
+    stop = true;
+    writer.join();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return static_cast<double>(total.load()) / std::chrono::duration<double>(kDuration).count();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Seqlock Benchmark" << std::endl;
+    std::cout << "=============================" << std::endl << std::endl;
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl << std::endl;
+    
+    std::cout << "=== Reads per second of a 64-byte snapshot, one writer ===" << std::endl;
+    std::cout << "readers   SmartBufferSeqlock   std::shared_mutex" << std::endl;
+    for (int readers : {1, 4, 16, 64}) {
+        SmartBufferSeqlock<64> seqlock;
+        SharedMutexSnapshot shared;
+        double fast = reads_per_second(seqlock, readers);
+        double slow = reads_per_second(shared, readers);
+        std::cout << std::setw(7) << readers << std::fixed << std::setprecision(1)
+                  << std::setw(19) << fast / 1e6 << " M" << std::setw(18) << slow / 1e6 << " M" << std::endl;
+    }
+    std::cout << std::endl << "Checksum: " << g_checksum.load() << std::endl;
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <smart_buffer_shm.hpp>
+#include "benchmark_timer.hpp"
+#include <cstring>
+#include <iostream>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Hands 4 KiB payloads from a producer process to a consumer process, once through a
+// Unix stream socket (copied into the kernel and out again) and once through the
+// shared-memory pool (written in place, handle passed through the ring).
+
+namespace {
+
+constexpr int kMessages = 200000;
+constexpr std::size_t kPayload = 4096;
+
+void produce(std::uint8_t* payload, int i) {
+    std::memset(payload, static_cast<int>(i & 0xFF), kPayload);
+    std::memcpy(payload, &i, sizeof(i));
+}
+
+std::uint64_t consume(const std::uint8_t* payload) {
+    int sequence = 0;
+    std::memcpy(&sequence, payload, sizeof(sequence));
+    return static_cast<std::uint64_t>(sequence) + payload[kPayload - 1];
+}
+
+bool write_all(int fd, const std::uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool read_all(int fd, std::uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t got = ::read(fd, data, size);
+        if (got <= 0) {
+            return false;
+        }
+        data += got;
+        size -= static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+// Returns the consumer's checksum folded into its exit status
+int wait_child(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Shared-Memory Pool Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl << std::endl;
+    
+    std::cout << "=== " << kMessages << " x 4 KiB payloads, producer -> consumer process ===" << std::endl;
+    {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            return 1;
+        }
+        Timer timer("Unix stream socket (SmartBuffer4K copied in and out)");
+        pid_t pid = fork();
+        if (pid == 0) {
+            ::close(fds[0]);
+            SmartBuffer4K buffer;
+            std::uint64_t checksum = 0;
+            for (int i = 0; i < kMessages && read_all(fds[1], buffer.data(), kPayload); ++i) {
+                checksum += consume(buffer.data());
+            }
+            _exit(static_cast<int>(checksum & 0x7F));
+        }
+        ::close(fds[1]);
+        SmartBuffer4K buffer;
+        for (int i = 0; i < kMessages; ++i) {
+            produce(buffer.data(), i);
+            write_all(fds[0], buffer.data(), kPayload);
+        }
+        ::close(fds[0]);
+        std::cout << "  consumer status " << wait_child(pid) << std::endl;
+    }
+    {
+        auto pool = SmartBufferShmPool<kPayload>::create(256, 128);
+        Timer timer("SmartBufferShmPool (in-place payload, handle ring, futex wake-ups)");
+        pid_t pid = fork();
+        if (pid == 0) {
+            auto consumer = SmartBufferShmPool<kPayload>::attach(pool.fd());
+            std::uint64_t checksum = 0;
+            for (int i = 0; i < kMessages; ++i) {
+                SmartBufferShmHandle handle = consumer.receive();
+                checksum += consume(consumer.data(handle));
+                consumer.free(handle);
+            }
+            _exit(static_cast<int>(checksum & 0x7F));
+        }
+        for (int i = 0; i < kMessages; ++i) {
+            SmartBufferShmHandle handle = pool.allocate();
+            handle.size = kPayload;
+            produce(pool.data(handle), i);
+            pool.send(handle);
+        }
+        std::cout << "  consumer status " << wait_child(pid) << std::endl;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <smart_buffer_size_class.hpp>
+#include "benchmark_timer.hpp"
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Compares size-class dispatch to compile-time specialized kernels against the
+// same operations written as generic runtime-length loops over std::vector, and
+// the cost of constructing each (inline up to 256 bytes, one allocation above).
+
+void benchmark_lengths(const char* label, std::size_t max_length, int buffers, int iterations) {
+    std::cout << "=== " << label << " (" << buffers << " buffers x " << iterations
+              << " iterations) ===" << std::endl;
+    
+    // Payload lengths are runtime values
+    std::mt19937 rng(42);
+    std::vector<SmartBufferSizeClassPow2> classed;
+    std::vector<std::vector<uint8_t>> generic;
+    classed.reserve(buffers);
+    generic.reserve(buffers);
+    for (int i = 0; i < buffers; ++i) {
+        std::size_t length = 1 + rng() % max_length;
+        classed.emplace_back(length);
+        generic.emplace_back(length);
+    }
+    std::vector<SmartBufferSizeClassPow2> classed_copy(classed);
+    std::vector<std::vector<uint8_t>> generic_copy(generic);
+    
+    std::uint64_t checksum = 0;
+    
+    {
+        // Classes above INLINE_LIMIT allocate on construction, like std::vector
+        Timer timer("Size-class construct + destroy");
+        for (int it = 0; it < iterations; ++it) {
+            for (const auto& buffer : classed) {
+                SmartBufferSizeClassPow2 temporary(buffer.size());
+                checksum += temporary.is_inline();
+            }
+        }
+    }
+    {
+        Timer timer("std::vector construct + destroy");
+        for (int it = 0; it < iterations; ++it) {
+            for (const auto& buffer : generic) {
+                std::vector<uint8_t> temporary(buffer.size());
+                checksum += temporary.size() & 1;
+            }
+        }
+    }
+    {
+        Timer timer("Size-class fill (jump table)");
+        for (int it = 0; it < iterations; ++it) {
+            for (auto& buffer : classed) {
+                buffer.fill(static_cast<uint8_t>(it));
+            }
+        }
+    }
+    {
+        Timer timer("Generic runtime-length fill");
+        for (int it = 0; it < iterations; ++it) {
+            for (auto& buffer : generic) {
+                std::memset(buffer.data(), it, buffer.size());
+            }
+        }
+    }
+    {
+        Timer timer("Size-class copy assignment");
+        for (int it = 0; it < iterations; ++it) {
+            for (int i = 0; i < buffers; ++i) {
+                classed_copy[i] = classed[i];
+            }
+        }
+    }
+    {
+        Timer timer("Generic runtime-length memcpy");
+        for (int it = 0; it < iterations; ++it) {
+            for (int i = 0; i < buffers; ++i) {
+                std::memcpy(generic_copy[i].data(), generic[i].data(), generic[i].size());
+            }
+        }
+    }
+    {
+        Timer timer("Size-class compare");
+        for (int it = 0; it < iterations; ++it) {
+            for (int i = 0; i < buffers; ++i) {
+                checksum += classed[i] == classed_copy[i];
+            }
+        }
+    }
+    {
+        Timer timer("Generic runtime-length memcmp");
+        for (int it = 0; it < iterations; ++it) {
+            for (int i = 0; i < buffers; ++i) {
+                checksum += std::memcmp(generic[i].data(), generic_copy[i].data(), generic[i].size()) == 0;
+            }
+        }
+    }
+    {
+        Timer timer("Size-class XXH64 (specialized)");
+        for (int it = 0; it < iterations; ++it) {
+            for (const auto& buffer : classed) {
+                checksum += buffer.hash();
+            }
+        }
+    }
+    {
+        Timer timer("Generic runtime-length XXH64");
+        for (int it = 0; it < iterations; ++it) {
+            for (const auto& buffer : generic) {
+                checksum += smart_buffer_hash_bytes(buffer.data(), buffer.size());
+            }
+        }
+    }
+    
+    std::cout << "Checksum: " << checksum << std::endl << std::endl;
+}
+
+int main() {
+    std::cout << "SmartBuffer Size-Class Dispatch Benchmark" << std::endl;
+    std::cout << "=========================================" << std::endl << std::endl;
+    
+    benchmark_lengths("Small payloads (1-256 bytes)", 256, 16384, 200);
+    benchmark_lengths("Medium payloads (1-4096 bytes)", 4096, 4096, 100);
+    benchmark_lengths("Large payloads (1-65536 bytes)", 65536, 512, 50);
+    
+    return 0;
+}
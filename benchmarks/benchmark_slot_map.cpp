@@ -0,0 +1,100 @@
+#include <smart_buffer_slot_map.hpp>
+#include "benchmark_timer.hpp"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// 100k SmartBuffer<64> records: a full scan, random lookups by handle or id, and an
+// erase/insert churn, for the slot map and std::unordered_map<id, SmartBuffer<64>>.
+
+namespace {
+
+using Record = SmartBuffer<64>;
+constexpr int kRecords = 100000;
+constexpr int kLookups = 2000000;
+constexpr int kScans = 100;
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Slot Map Benchmark" << std::endl;
+    std::cout << "==============================" << std::endl << std::endl;
+    
+    std::mt19937_64 rng(42);
+    std::uint64_t checksum = 0;
+    
+    SmartBufferSlotMap<64> slots;
+    std::vector<std::uint64_t> handles;
+    std::unordered_map<std::uint64_t, Record> map;
+    std::vector<std::uint64_t> ids;
+    for (int i = 0; i < kRecords; ++i) {
+        Record record;
+        record[0] = static_cast<std::uint8_t>(i);
+        handles.push_back(slots.insert(record));
+        ids.push_back(rng());
+        map.emplace(ids.back(), record);
+    }
+    std::vector<std::size_t> order(kLookups);
+    for (auto& index : order) {
+        index = static_cast<std::size_t>(rng() % kRecords);
+    }
+    
+    std::cout << "=== Scan all records x" << kScans << " ===" << std::endl;
+    {
+        Timer timer("  SmartBufferSlotMap");
+        for (int s = 0; s < kScans; ++s) {
+            for (const Record& record : slots) {
+                checksum += record[0];
+            }
+        }
+    }
+    {
+        Timer timer("  std::unordered_map");
+        for (int s = 0; s < kScans; ++s) {
+            for (const auto& entry : map) {
+                checksum += entry.second[0];
+            }
+        }
+    }
+    std::cout << std::endl;
+    
+    std::cout << "=== " << kLookups << " random lookups ===" << std::endl;
+    {
+        Timer timer("  SmartBufferSlotMap (handle)");
+        for (std::size_t index : order) {
+            checksum += (*slots.find(handles[index]))[0];
+        }
+    }
+    {
+        Timer timer("  std::unordered_map (id)");
+        for (std::size_t index : order) {
+            checksum += map.find(ids[index])->second[0];
+        }
+    }
+    std::cout << std::endl;
+    
+    std::cout << "=== " << kLookups / 4 << " erase + insert pairs ===" << std::endl;
+    {
+        Timer timer("  SmartBufferSlotMap");
+        for (int i = 0; i < kLookups / 4; ++i) {
+            std::size_t index = order[static_cast<std::size_t>(i)];
+            slots.erase(handles[index]);
+            handles[index] = slots.emplace();
+        }
+    }
+    {
+        Timer timer("  std::unordered_map");
+        for (int i = 0; i < kLookups / 4; ++i) {
+            std::size_t index = order[static_cast<std::size_t>(i)];
+            map.erase(ids[index]);
+            ids[index] = rng();
+            map.emplace(ids[index], Record());
+        }
+    }
+    checksum += slots.size() + map.size();
+    
+    std::cout << std::endl << "Checksum: " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <smart_buffer_small_vector.hpp>
+#include "benchmark_timer.hpp"
+#include <deque>
+#include <iostream>
+#include <vector>
+
+// Grows a container one element at a time so every reallocation relocates all
+// existing elements.
+template<typename Container>
+void grow(Container& container, int elements) {
+    for (int i = 0; i < elements; ++i) {
+        container.emplace_back();
+        container.back()[0] = static_cast<uint8_t>(i);
+    }
+}
+
+template<typename Buffer>
+void benchmark_reallocation(const char* label, int elements) {
+    std::cout << "=== Reallocation Benchmark: " << label << " (" << elements << " elements) ===" << std::endl;
+    
+    uint32_t checksum = 0;
+    
+    {
+        Timer timer("std::vector growth (move + destroy per element)");
+        std::vector<Buffer> buffers;
+        grow(buffers, elements);
+        checksum += buffers.back()[0];
+    }
+    
+    {
+        Timer timer("SmartBufferSmallVector growth (bulk memcpy)");
+        SmartBufferSmallVector<Buffer> buffers;
+        grow(buffers, elements);
+        checksum += buffers.back()[0];
+    }
+    
+    // Reallocation only: pre-filled containers forced to grow once more
+    {
+        std::vector<Buffer> buffers(static_cast<std::size_t>(elements));
+        Timer timer("std::vector single reallocation");
+        buffers.reserve(buffers.capacity() * 2);
+        checksum += buffers.front()[0];
+    }
+    
+    {
+        SmartBufferSmallVector<Buffer> buffers(static_cast<std::size_t>(elements));
+        Timer timer("SmartBufferSmallVector single reallocation");
+        buffers.reserve(buffers.capacity() * 2);
+        checksum += buffers.front()[0];
+    }
+    
+    std::cout << "Checksum: " << checksum << std::endl << std::endl;
+}
+
+// Same storage as Buffer, but not marked trivially relocatable, so the deque moves and
+// destroys each element when it grows
+template<typename Buffer>
+struct MoveRelocated {
+    Buffer buffer;
+    uint8_t& operator[](std::size_t index) { return buffer[index]; }
+};
+
+template<typename Deque>
+void fill_wrapped(Deque& deque, int elements) {
+    // Leave the live range wrapped around the end of the ring
+    for (int i = 0; i < elements; ++i) {
+        deque.emplace_back();
+    }
+    for (int i = 0; i < elements / 4; ++i) {
+        deque.pop_front();
+    }
+    while (deque.size() < deque.capacity()) {
+        deque.emplace_back();
+    }
+}
+
+template<typename Buffer>
+void benchmark_deque(const char* label, int elements) {
+    std::cout << "=== Deque Reallocation Benchmark: " << label << " (" << elements << " elements) ===" << std::endl;
+    
+    uint32_t checksum = 0;
+    
+    {
+        Timer timer("std::deque growth (block allocation, no relocation)");
+        std::deque<Buffer> buffers;
+        grow(buffers, elements);
+        checksum += buffers.back()[0];
+    }
+    
+    {
+        Timer timer("SmartBufferDeque growth (move + destroy per element)");
+        SmartBufferDeque<MoveRelocated<Buffer>> buffers;
+        grow(buffers, elements);
+        checksum += buffers.back()[0];
+    }
+    
+    {
+        Timer timer("SmartBufferDeque growth (bulk memcpy)");
+        SmartBufferDeque<Buffer> buffers;
+        grow(buffers, elements);
+        checksum += buffers.back()[0];
+    }
+    
+    // Reallocation only: a full, wrapped ring forced to grow once more
+    {
+        SmartBufferDeque<MoveRelocated<Buffer>> buffers;
+        fill_wrapped(buffers, elements);
+        Timer timer("SmartBufferDeque single reallocation (move + destroy)");
+        buffers.emplace_back();
+        checksum += buffers.front()[0];
+    }
+    
+    {
+        SmartBufferDeque<Buffer> buffers;
+        fill_wrapped(buffers, elements);
+        Timer timer("SmartBufferDeque single reallocation (bulk memcpy)");
+        buffers.emplace_back();
+        checksum += buffers.front()[0];
+    }
+    
+    std::cout << "Checksum: " << checksum << std::endl << std::endl;
+}
+
+int main() {
+    std::cout << "SmartBuffer Relocation Benchmark" << std::endl;
+    std::cout << "================================" << std::endl << std::endl;
+    
+    const int elements = 1000000;
+    benchmark_reallocation<SmartBuffer<16>>("SmartBuffer<16> (static)", elements);
+    benchmark_reallocation<SmartBuffer<64>>("SmartBuffer<64> (dynamic)", elements);
+    benchmark_deque<SmartBuffer<16>>("SmartBuffer<16> (static)", elements);
+    benchmark_deque<SmartBuffer<64>>("SmartBuffer<64> (dynamic)", elements);
+    
+    return 0;
+}
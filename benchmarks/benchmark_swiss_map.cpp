@@ -0,0 +1,123 @@
+#include <smart_buffer_swiss_map.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Insert, hit/miss lookups in random order, and erase of N SmartBuffer<32> keys with
+// 8-byte values, for SmartBufferSwissMap and std::unordered_map with SmartBufferHash.
+// Sizes run from 1K to 10M; pass the largest size as an argument (e.g. 100000000,
+// which needs about 10 GB for both maps).
+
+namespace {
+
+using Key = SmartBuffer<32>;
+using UnorderedMap = std::unordered_map<Key, std::uint64_t, SmartBufferHash, SmartBufferEqual>;
+using Clock = std::chrono::steady_clock;
+
+std::vector<Key> make_keys(std::size_t count, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<Key> keys(count);
+    for (Key& key : keys) {
+        for (std::size_t i = 0; i < 32; i += 8) {
+            std::uint64_t word = rng();
+            std::memcpy(key.data() + i, &word, 8);
+        }
+    }
+    return keys;
+}
+
+template<typename Fn>
+double ns_per_op(std::size_t count, Fn&& fn) {
+    auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(count);
+}
+
+struct Row {
+    double insert;
+    double hit;
+    double miss;
+    double erase;
+};
+
+template<typename Map, typename Insert, typename Find>
+Row run(const std::vector<Key>& keys, const std::vector<Key>& misses,
+        const std::vector<std::size_t>& order, Insert&& insert, Find&& find, std::uint64_t& checksum) {
+    Row row{};
+    std::size_t n = keys.size();
+    Map map;
+    row.insert = ns_per_op(n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            insert(map, keys[i], i);
+        }
+    });
+    row.hit = ns_per_op(n, [&] {
+        for (std::size_t index : order) {
+            checksum += find(map, keys[index]);
+        }
+    });
+    row.miss = ns_per_op(n, [&] {
+        for (const Key& key : misses) {
+            checksum += find(map, key);
+        }
+    });
+    row.erase = ns_per_op(n, [&] {
+        for (std::size_t index : order) {
+            map.erase(keys[index]);
+        }
+    });
+    checksum += map.size();
+    return row;
+}
+
+using SwissMap = SmartBufferSwissMap<32, std::uint64_t>;
+
+void print(const char* name, const Row& row) {
+    std::cout << "  " << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << row.insert << std::setw(9) << row.hit << std::setw(9) << row.miss
+              << std::setw(9) << row.erase << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::cout << "SmartBuffer Swiss Map Benchmark" << std::endl;
+    std::cout << "===============================" << std::endl << std::endl;
+    std::cout << "Group probe: " << (SMART_BUFFER_SWISS_SSE2 ? "SSE2" : "scalar") << std::endl << std::endl;
+    
+    std::size_t largest = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::uint64_t checksum = 0;
+    for (std::size_t n = 1000; n <= largest; n *= 10) {
+        std::vector<Key> keys = make_keys(n, n);
+        std::vector<Key> misses = make_keys(n, n + 1);
+        std::vector<std::size_t> order(n);
+        std::mt19937_64 rng(n);
+        for (std::size_t& index : order) {
+            index = static_cast<std::size_t>(rng() % n);
+        }
+        
+        std::cout << "=== " << n << " keys (ns/op) ===" << std::endl;
+        std::cout << "  map                   insert      hit     miss    erase" << std::endl;
+        print("SmartBufferSwissMap", run<SwissMap>(keys, misses, order, [](SwissMap& map, const Key& key, std::uint64_t value) {
+            map.insert(key, value);
+        }, [](SwissMap& map, const Key& key) {
+            const std::uint64_t* value = map.find(key);
+            return value != nullptr ? *value : 0;
+        }, checksum));
+        print("std::unordered_map", run<UnorderedMap>(keys, misses, order, [](UnorderedMap& map, const Key& key, std::uint64_t value) {
+            map.emplace(key, value);
+        }, [](UnorderedMap& map, const Key& key) {
+            auto it = map.find(key);
+            return it != map.end() ? it->second : 0;
+        }, checksum));
+        std::cout << std::endl;
+    }
+    
+    std::cout << "Checksum: " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// Simple benchmark helper
+class Timer {
+public:
+    Timer(const std::string& name) : name_(name), start_(std::chrono::high_resolution_clock::now()) {}
+    
+    ~Timer() {
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
+        std::cout << name_ << ": " << duration.count() << " μs" << std::endl;
+    }
+    
+private:
+    std::string name_;
+    std::chrono::high_resolution_clock::time_point start_;
+};
@@ -0,0 +1,134 @@
+#include <smart_buffer_pool.hpp>
+#include <smart_buffer_trimmer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Simulates traffic spikes against a pool of 64 KiB buffers and reports resident
+// memory after each phase together with acquire latency, with and without a
+// watermark trimmer. Each scenario runs in a forked child so RSS starts from scratch.
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr std::size_t kBufferSize = 65536;
+constexpr int kOpsPerPhase = 20000;
+
+struct Phase {
+    const char* name;
+    std::size_t live;
+};
+
+const Phase kPhases[] = {
+    {"base", 64}, {"spike", 1024}, {"base", 64}, {"base", 64}, {"spike", 1024}, {"base", 64},
+};
+
+double rss_mib() {
+    long pages = 0;
+    long resident = 0;
+    if (FILE* statm = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        std::fclose(statm);
+    }
+    return static_cast<double>(resident) * static_cast<double>(::sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+void run(SmartBufferPool<kBufferSize>& pool, SmartBufferPoolTrimmer* trimmer) {
+    std::deque<SmartBuffer<kBufferSize>> live;
+    std::vector<std::uint32_t> latencies;
+    auto clock = SmartBufferPoolTrimmer::Clock::now();
+    std::uint64_t checksum = 0;
+    
+    std::cout << "  phase   live   RSS (MiB)   acquire mean / p99 (ns)" << std::endl;
+    for (const Phase& phase : kPhases) {
+        latencies.clear();
+        for (int op = 0; op < kOpsPerPhase; ++op) {
+            // Keep the live count at the phase target: shrink or grow by one request
+            while (live.size() > phase.live) {
+                pool.release(std::move(live.front()));
+                live.pop_front();
+            }
+            if (live.size() == phase.live) {
+                pool.release(std::move(live.front()));
+                live.pop_front();
+            }
+            auto start = std::chrono::steady_clock::now();
+            live.push_back(pool.acquire());
+            auto end = std::chrono::steady_clock::now();
+            latencies.push_back(static_cast<std::uint32_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            live.back().fill(static_cast<std::uint8_t>(op));
+            checksum += live.back()[op % kBufferSize];
+            
+            if (trimmer != nullptr && op % 64 == 0) {
+                clock += 1ms;  // Simulated time: 64 requests per millisecond
+                trimmer->poll(clock);
+            }
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::uint64_t total = 0;
+        for (std::uint32_t latency : latencies) {
+            total += latency;
+        }
+        std::cout << "  " << std::left << std::setw(7) << phase.name << std::right << std::setw(5) << phase.live
+                  << std::setw(12) << std::fixed << std::setprecision(1) << rss_mib()
+                  << std::setw(12) << total / latencies.size() << " / " << latencies[latencies.size() * 99 / 100]
+                  << std::endl;
+    }
+    if (trimmer != nullptr) {
+        SmartBufferTrimStats stats = trimmer->stats();
+        std::cout << "  trims " << stats.watermark_trims << ", buffers freed " << stats.buffers_freed << std::endl;
+    }
+    std::cout << "  checksum " << checksum << std::endl;
+}
+
+template<typename Fn>
+void in_child(Fn&& fn) {
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        fn();
+        std::cout.flush();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Pool Trimming Benchmark" << std::endl;
+    std::cout << "===================================" << std::endl << std::endl;
+    
+    std::cout << "=== Pool without trimming ===" << std::endl;
+    in_child([] {
+        SmartBufferPool<kBufferSize> pool;
+        run(pool, nullptr);
+    });
+    
+    std::cout << "=== Watermark trimmer (high 32 MiB, low 8 MiB idle, 250 ms cooldown) ===" << std::endl;
+    in_child([] {
+        SmartBufferPool<kBufferSize> pool;
+        SmartBufferTrimConfig config;
+        config.high_watermark = 32u << 20;
+        config.low_watermark = 8u << 20;
+        config.cooldown = 250ms;
+        config.psi_threshold = 0;
+        config.use_cgroup_events = false;
+        SmartBufferPoolTrimmer trimmer(config);
+        trimmer.add(pool);
+        run(pool, &trimmer);
+    });
+    
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <smart_buffer_triple.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// A producer writes 2 KiB telemetry frames as fast as it can while a consumer keeps
+// picking up the latest one. Reports both rates for the triple buffer and for a
+// mutex-protected frame that the consumer copies out.
+
+namespace {
+
+using Frame = SmartBuffer<2048>;
+constexpr auto kDuration = std::chrono::milliseconds(500);
+
+void fill_frame(Frame& frame, std::uint64_t seq) {
+    std::memcpy(frame.data(), &seq, sizeof(seq));
+    std::memset(frame.data() + sizeof(seq), static_cast<int>(seq), frame.size() - sizeof(seq));
+}
+
+std::uint64_t frame_seq(const Frame& frame) {
+    std::uint64_t seq = 0;
+    std::memcpy(&seq, frame.data(), sizeof(seq));
+    return seq;
+}
+
+struct TripleHandoff {
+    SmartBufferTripleBuffer<Frame> triple;
+    
+    void produce(std::uint64_t seq) {
+        fill_frame(triple.write_buffer(), seq);
+        triple.publish();
+    }
+    
+    std::uint64_t consume() {
+        return frame_seq(triple.acquire_latest());
+    }
+};
+
+struct MutexHandoff {
+    std::mutex mutex;
+    Frame latest;
+    Frame scratch;
+    Frame local;
+    
+    void produce(std::uint64_t seq) {
+        fill_frame(scratch, seq);
+        std::lock_guard<std::mutex> lock(mutex);
+        latest = scratch;
+    }
+    
+    std::uint64_t consume() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            local = latest;
+        }
+        return frame_seq(local);
+    }
+};
+
+template<typename Handoff>
+void run(const char* name, std::uint64_t& checksum) {
+    Handoff handoff;
+    std::atomic<bool> stop{false};
+    std::uint64_t produced = 0;
+    std::uint64_t consumed = 0;
+    std::uint64_t distinct = 0;
+    
+    std::thread producer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            handoff.produce(++produced);
+        }
+    });
+    std::thread consumer([&] {
+        std::uint64_t last = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            std::uint64_t seq = handoff.consume();
+            distinct += seq != last;
+            last = seq;
+            ++consumed;
+        }
+        checksum += last;
+    });
+    std::this_thread::sleep_for(kDuration);
+    stop = true;
+    producer.join();
+    consumer.join();
+    
+    double seconds = std::chrono::duration<double>(kDuration).count();
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << produced / seconds / 1e6 << std::setw(12) << consumed / seconds / 1e6
+              << std::setw(14) << distinct << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Triple Buffer Benchmark" << std::endl;
+    std::cout << "===================================" << std::endl << std::endl;
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << std::endl << std::endl;
+    
+    std::uint64_t checksum = 0;
+    std::cout << "=== 2 KiB frames for 500 ms, rates in M/s ===" << std::endl;
+    std::cout << "handoff                 published    acquired    new frames seen" << std::endl;
+    run<TripleHandoff>("SmartBufferTripleBuffer", checksum);
+    run<MutexHandoff>("std::mutex + copy", checksum);
+    
+    std::cout << std::endl << "Checksum: " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include <smart_buffer_pool.hpp>
+#include <smart_buffer_warmup.hpp>
+#include "benchmark_timer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <string>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Measures time-to-steady-state after startup. Each scenario runs in a fresh child
+// process so the heap starts cold: one run records a profile of peak live counts, then
+// traffic is replayed cold and after warming the pools from that profile.
+
+namespace {
+
+constexpr int kRequests = 4096;
+constexpr int kInFlight = 64;
+constexpr int kWindow = 256;
+
+struct Pools {
+    SmartBufferPool<1024> small;
+    SmartBufferPool<4096> medium;
+    SmartBufferPool<65536> large;
+};
+
+struct Request {
+    std::deque<SmartBuffer<1024>> small;
+    std::deque<SmartBuffer<4096>> medium;
+    std::deque<SmartBuffer<65536>> large;
+};
+
+long minor_faults() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+// Replay the traffic, printing the mean request latency of the first windows and the last
+std::uint64_t replay(Pools& pools, bool print) {
+    std::deque<Request> in_flight;
+    std::uint64_t checksum = 0;
+    auto window_start = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRequests; ++r) {
+        Request request;
+        for (int i = 0; i < 8; ++i) {
+            request.small.push_back(pools.small.acquire());
+            request.small.back()[i] = static_cast<std::uint8_t>(r);
+        }
+        for (int i = 0; i < 4; ++i) {
+            request.medium.push_back(pools.medium.acquire());
+            request.medium.back()[i * 1000] = static_cast<std::uint8_t>(r);
+        }
+        request.large.push_back(pools.large.acquire());
+        request.large.back().fill(static_cast<std::uint8_t>(r));  // Response body
+        checksum += request.large.back()[r % 65536];
+        in_flight.push_back(std::move(request));
+        
+        if (in_flight.size() > kInFlight) {
+            Request& done = in_flight.front();
+            for (auto& buffer : done.small) {
+                pools.small.release(std::move(buffer));
+            }
+            for (auto& buffer : done.medium) {
+                pools.medium.release(std::move(buffer));
+            }
+            for (auto& buffer : done.large) {
+                pools.large.release(std::move(buffer));
+            }
+            in_flight.pop_front();
+        }
+        
+        if (r % kWindow == kWindow - 1) {
+            auto now = std::chrono::steady_clock::now();
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - window_start).count();
+            if (print && (r < 4 * kWindow || r == kRequests - 1)) {
+                std::cout << "  requests " << r + 1 - kWindow << ".." << r << ": "
+                          << elapsed / kWindow << " ns/request" << std::endl;
+            }
+            window_start = std::chrono::steady_clock::now();
+        }
+    }
+    return checksum;
+}
+
+template<typename Fn>
+void in_child(Fn&& fn) {
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        fn();
+        std::cout.flush();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SmartBuffer Warmup Benchmark" << std::endl;
+    std::cout << "============================" << std::endl << std::endl;
+    
+    const std::string profile_path = "smart_buffer_warmup_profile.txt";
+    
+    in_child([&] {
+        Pools pools;
+        replay(pools, false);
+        SmartBufferWarmupProfile profile;
+        profile.record(pools.small, pools.medium, pools.large);
+        profile.save_file(profile_path);
+    });
+    
+    std::cout << "=== Cold start (" << kInFlight << " requests in flight, ~5 MiB working set) ===" << std::endl;
+    in_child([] {
+        Pools pools;
+        long faults = minor_faults();
+        std::uint64_t checksum = replay(pools, true);
+        std::cout << "  page faults during traffic: " << minor_faults() - faults
+                  << ", checksum " << checksum << std::endl;
+    });
+    
+    for (unsigned threads : {1u, 4u}) {
+        std::cout << "=== Warmed from recorded profile (" << threads << " thread"
+                  << (threads > 1 ? "s" : "") << ") ===" << std::endl;
+        in_child([&] {
+            Pools pools;
+            SmartBufferWarmupProfile profile;
+            profile.load_file(profile_path);
+            {
+                Timer timer("  warmup");
+                smart_buffer_warmup(profile, threads, pools.small, pools.medium, pools.large);
+            }
+            long faults = minor_faults();
+            std::uint64_t checksum = replay(pools, true);
+            std::cout << "  page faults during traffic: " << minor_faults() - faults
+                      << ", checksum " << checksum << std::endl;
+        });
+    }
+    
+    std::remove(profile_path.c_str());
+    return 0;
+}
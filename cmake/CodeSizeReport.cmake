@@ -0,0 +1,63 @@
+# Generates a per-symbol code size report for a binary.
+#
+# Usage:
+#   cmake -DNM=<nm> -DBINARY=<binary> -DREPORT=<output file> -P CodeSizeReport.cmake
+#
+# Lists every text symbol that mentions SmartBuffer (largest first) and totals
+# the template instantiations against the shared out-of-line core.
+
+foreach(var NM BINARY REPORT)
+    if(NOT ${var})
+        message(FATAL_ERROR "CodeSizeReport.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${NM} -C -S --size-sort --reverse-sort ${BINARY}
+    OUTPUT_VARIABLE nm_output
+    RESULT_VARIABLE nm_result
+)
+if(NOT nm_result EQUAL 0)
+    message(FATAL_ERROR "CodeSizeReport.cmake: ${NM} failed on ${BINARY}")
+endif()
+
+string(REPLACE "\n" ";" nm_lines "${nm_output}")
+
+set(report "")
+set(template_total 0)
+set(template_count 0)
+set(core_total 0)
+set(core_count 0)
+
+foreach(line IN LISTS nm_lines)
+    # <address> <size> <type> <name>
+    if(NOT line MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) [tTwW] (.*)$")
+        continue()
+    endif()
+    set(size_hex "${CMAKE_MATCH_1}")
+    set(name "${CMAKE_MATCH_2}")
+    if(NOT name MATCHES "SmartBuffer|smart_buffer_detail|exercise<")
+        continue()
+    endif()
+
+    math(EXPR size "0x${size_hex}")
+    string(APPEND report "${size}\t${name}\n")
+
+    if(name MATCHES "^smart_buffer_detail::[a-z_]+\\(")
+        math(EXPR core_total "${core_total} + ${size}")
+        math(EXPR core_count "${core_count} + 1")
+    else()
+        math(EXPR template_total "${template_total} + ${size}")
+        math(EXPR template_count "${template_count} + 1")
+    endif()
+endforeach()
+
+set(summary "SmartBuffer code size report for ${BINARY}\n")
+string(APPEND summary "  Template instantiations: ${template_count} symbols, ${template_total} bytes\n")
+string(APPEND summary "  Shared core:             ${core_count} symbols, ${core_total} bytes\n\n")
+string(APPEND summary "Size (bytes)\tSymbol\n")
+
+file(WRITE ${REPORT} "${summary}${report}")
+message(STATUS "Template instantiations: ${template_count} symbols, ${template_total} bytes")
+message(STATUS "Shared core: ${core_count} symbols, ${core_total} bytes")
+message(STATUS "Code size report written to ${REPORT}")
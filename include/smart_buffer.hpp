@@ -1,11 +1,234 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
+#include <utility>
 #include <array>
 #include <type_traits>
 #include <algorithm>
 
+/**
+ * @brief Marks a class as trivially relocatable on compilers implementing the
+ *        P1144 [[trivially_relocatable]] attribute; expands to nothing elsewhere.
+ */
+#if defined(__has_cpp_attribute)
+#  if __has_cpp_attribute(trivially_relocatable)
+#    define SMART_BUFFER_TRIVIALLY_RELOCATABLE [[trivially_relocatable]]
+#  endif
+#endif
+#ifndef SMART_BUFFER_TRIVIALLY_RELOCATABLE
+#  define SMART_BUFFER_TRIVIALLY_RELOCATABLE
+#endif
+
+/**
+ * @brief Trait telling containers that a move followed by destroying the source
+ *        is equivalent to a memcpy of the object representation.
+ *
+ * Defaults to std::is_trivially_copyable; specialize it for owning types whose
+ * state is position-independent (e.g. a heap pointer).
+ */
+template<typename T>
+struct smart_buffer_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+inline constexpr bool smart_buffer_trivially_relocatable_v =
+    smart_buffer_trivially_relocatable<T>::value;
+
+/**
+ * @brief Keeps a function out of line so that every caller shares one copy.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#  define SMART_BUFFER_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#  define SMART_BUFFER_NOINLINE __declspec(noinline)
+#else
+#  define SMART_BUFFER_NOINLINE
+#endif
+
+namespace smart_buffer_detail {
+
+/*
+ * Size-independent core shared by every dynamic SmartBuffer instantiation.
+ *
+ * These functions take the size at runtime and are kept out of line, so a program
+ * using many different SmartBuffer<N> sizes carries a single copy of the allocation,
+ * copy and fill logic instead of one per N. Static buffers keep fully specialized
+ * inline code, where the compile-time size lets the compiler emit a few stores.
+ */
+
+/*
+ * Every dynamic allocation goes through allocate_*()/deallocate(). A null resource
+ * means the global heap (operator new[]/delete[]); otherwise the block comes from the
+ * given std::pmr::memory_resource.
+ */
+
+// Alignment requested from memory resources (matches operator new[])
+inline constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+inline std::uint8_t* allocate_block(std::size_t size, std::pmr::memory_resource* resource) {
+    if (resource != nullptr) {
+        return static_cast<std::uint8_t*>(resource->allocate(size, BLOCK_ALIGNMENT));
+    }
+    return new std::uint8_t[size];
+}
+
+// Allocate a zero-initialized block of size bytes
+SMART_BUFFER_NOINLINE inline std::uint8_t* allocate_zeroed(std::size_t size,
+                                                           std::pmr::memory_resource* resource = nullptr) {
+    std::uint8_t* block = allocate_block(size, resource);
+    std::memset(block, 0, size);
+    return block;
+}
+
+// Allocate a block of size bytes holding a copy of source
+SMART_BUFFER_NOINLINE inline std::uint8_t* allocate_copy(const std::uint8_t* source, std::size_t size,
+                                                         std::pmr::memory_resource* resource = nullptr) {
+    std::uint8_t* block = allocate_block(size, resource);
+    std::memcpy(block, source, size);
+    return block;
+}
+
+// Release a block obtained from allocate_zeroed()/allocate_copy() with the same resource
+SMART_BUFFER_NOINLINE inline void deallocate(std::uint8_t* block, std::size_t size,
+                                             std::pmr::memory_resource* resource) noexcept {
+    if (block == nullptr) {
+        return;
+    }
+    if (resource != nullptr) {
+        resource->deallocate(block, size, BLOCK_ALIGNMENT);
+    } else {
+        delete[] block;
+    }
+}
+
+// Resource installed for the current thread by SmartBufferResourceScope (null = heap)
+inline std::pmr::memory_resource*& scoped_resource() noexcept {
+    static thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+SMART_BUFFER_NOINLINE inline void copy_bytes(std::uint8_t* dest, const std::uint8_t* source, std::size_t size) noexcept {
+    std::memcpy(dest, source, size);
+}
+
+SMART_BUFFER_NOINLINE inline void fill_bytes(std::uint8_t* dest, std::size_t size, std::uint8_t value) noexcept {
+    std::memset(dest, value, size);
+}
+
+/**
+ * @brief Storage backing a SmartBuffer, specialized on the allocation strategy.
+ *
+ * The static specialization is a plain std::array with implicitly declared copy,
+ * move and destructor, so a static SmartBuffer is trivially copyable. The dynamic
+ * specialization owns a heap block and provides deep-copy semantics.
+ */
+template<std::size_t ActualSize, bool Static>
+class SmartBufferStorage;
+
+template<std::size_t ActualSize>
+class SmartBufferStorage<ActualSize, true> {
+public:
+    SmartBufferStorage() noexcept {
+        buffer_.fill(0);
+    }
+
+    // Static buffers never allocate, so the resource is ignored
+    explicit SmartBufferStorage(std::pmr::memory_resource*) noexcept : SmartBufferStorage() {}
+
+    std::uint8_t* get() noexcept { return buffer_.data(); }
+    const std::uint8_t* get() const noexcept { return buffer_.data(); }
+    std::pmr::memory_resource* resource() const noexcept { return nullptr; }
+
+private:
+    std::array<std::uint8_t, ActualSize> buffer_;
+};
+
+template<std::size_t ActualSize>
+class SmartBufferStorage<ActualSize, false> {
+public:
+    SmartBufferStorage() : SmartBufferStorage(scoped_resource()) {}
+
+    explicit SmartBufferStorage(std::pmr::memory_resource* resource)
+        : buffer_(allocate_zeroed(ActualSize, resource)), resource_(resource) {}
+
+    // Copies draw from the resource in scope, not from the source's resource
+    SmartBufferStorage(const SmartBufferStorage& other)
+        : buffer_(allocate_copy(other.buffer_, ActualSize, scoped_resource())), resource_(scoped_resource()) {}
+
+    SmartBufferStorage(SmartBufferStorage&& other) noexcept
+        : buffer_(std::exchange(other.buffer_, nullptr)), resource_(other.resource_) {}
+
+    SmartBufferStorage& operator=(const SmartBufferStorage& other) {
+        if (this != &other) {
+            if (!buffer_) {
+                resource_ = scoped_resource();
+                buffer_ = allocate_copy(other.buffer_, ActualSize, resource_);
+            } else {
+                copy_bytes(buffer_, other.buffer_, ActualSize);
+            }
+        }
+        return *this;
+    }
+
+    SmartBufferStorage& operator=(SmartBufferStorage&& other) noexcept {
+        if (this != &other) {
+            deallocate(buffer_, ActualSize, resource_);
+            buffer_ = std::exchange(other.buffer_, nullptr);
+            resource_ = other.resource_;
+        }
+        return *this;
+    }
+
+    ~SmartBufferStorage() {
+        deallocate(buffer_, ActualSize, resource_);
+    }
+
+    std::uint8_t* get() noexcept { return buffer_; }
+    const std::uint8_t* get() const noexcept { return buffer_; }
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+private:
+    std::uint8_t* buffer_;
+    std::pmr::memory_resource* resource_;
+};
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief Installs a memory resource for dynamic SmartBuffers created on this thread
+ *        while the scope is alive; the previous resource is restored on exit.
+ *
+ * Buffers remember the resource they were allocated from, so they may be destroyed
+ * after the scope ends, but never after the resource itself is gone.
+ */
+class SmartBufferResourceScope {
+public:
+    explicit SmartBufferResourceScope(std::pmr::memory_resource* resource) noexcept
+        : previous_(smart_buffer_detail::scoped_resource()) {
+        smart_buffer_detail::scoped_resource() = resource;
+    }
+
+    SmartBufferResourceScope(const SmartBufferResourceScope&) = delete;
+    SmartBufferResourceScope& operator=(const SmartBufferResourceScope&) = delete;
+
+    ~SmartBufferResourceScope() {
+        smart_buffer_detail::scoped_resource() = previous_;
+    }
+
+    /**
+     * @brief Get the resource currently installed on this thread (null = global heap)
+     */
+    static std::pmr::memory_resource* current() noexcept {
+        return smart_buffer_detail::scoped_resource();
+    }
+
+private:
+    std::pmr::memory_resource* previous_;
+};
+
 /**
  * @brief A template-based smart buffer that automatically chooses between 
  *        static and dynamic allocation based on buffer size and configurable threshold.
@@ -14,14 +237,19 @@
  * @tparam StaticThreshold Threshold for static vs dynamic allocation (default: 32)
  * 
  * For buffers <= StaticThreshold bytes: uses static allocation (std::array)
- * For buffers > StaticThreshold bytes: uses dynamic allocation (std::unique_ptr)
+ * For buffers > StaticThreshold bytes: uses dynamic allocation (heap or memory resource)
+ * 
+ * Dynamic buffers allocate from the global heap unless a std::pmr::memory_resource is
+ * passed explicitly or installed with SmartBufferResourceScope.
  * 
  * Buffer size is automatically rounded up to the nearest 8-byte boundary for optimal alignment.
+ * Static buffers are trivially copyable, movable and destructible, so they can be
+ * relocated with memcpy by containers and serialization code.
  * 
  * @requires C++17 or later
  */
 template<std::size_t Size, std::size_t StaticThreshold = 32>
-class SmartBuffer {
+class SMART_BUFFER_TRIVIALLY_RELOCATABLE SmartBuffer {
 private:
     // Round up to 8-byte alignment
     static constexpr std::size_t round_up_to_8(std::size_t size) noexcept {
@@ -32,12 +260,8 @@ private:
     static constexpr std::size_t STATIC_THRESHOLD = StaticThreshold;
     static constexpr bool use_static = ACTUAL_SIZE <= STATIC_THRESHOLD;
     
-    // Type alias for cleaner code
-    using StaticBuffer = std::array<std::uint8_t, ACTUAL_SIZE>;
-    using DynamicBuffer = std::unique_ptr<std::uint8_t[]>;
-    
     // Storage - either static array or dynamic pointer
-    typename std::conditional_t<use_static, StaticBuffer, DynamicBuffer> buffer_;
+    smart_buffer_detail::SmartBufferStorage<ACTUAL_SIZE, use_static> buffer_;
 
 public:
     /**
@@ -45,64 +269,33 @@ public:
      * For static buffers: initializes array to zero
      * For dynamic buffers: allocates memory and initializes to zero
      */
-    SmartBuffer() {
-        if constexpr (use_static) {
-            buffer_.fill(0);
-        } else {
-            buffer_ = std::make_unique<std::uint8_t[]>(ACTUAL_SIZE);
-            std::fill_n(buffer_.get(), ACTUAL_SIZE, 0);
-        }
-    }
+    SmartBuffer() = default;
     
     /**
-     * @brief Copy constructor
+     * @brief Construct a zero-initialized buffer whose dynamic storage comes from resource
+     * @param resource Memory resource to allocate from (null = global heap; ignored for static buffers)
      */
-    SmartBuffer(const SmartBuffer& other) {
-        if constexpr (use_static) {
-            buffer_ = other.buffer_;
-        } else {
-            buffer_ = std::make_unique<std::uint8_t[]>(ACTUAL_SIZE);
-            std::copy_n(other.buffer_.get(), ACTUAL_SIZE, buffer_.get());
-        }
-    }
+    explicit SmartBuffer(std::pmr::memory_resource* resource) : buffer_(resource) {}
     
     /**
-     * @brief Move constructor
+     * @brief Copy constructor (trivial for static buffers)
      */
-    SmartBuffer(SmartBuffer&& other) noexcept {
-        if constexpr (use_static) {
-            buffer_ = std::move(other.buffer_);
-        } else {
-            buffer_ = std::move(other.buffer_);
-        }
-    }
+    SmartBuffer(const SmartBuffer& other) = default;
     
     /**
-     * @brief Copy assignment operator
+     * @brief Move constructor (trivial for static buffers)
      */
-    SmartBuffer& operator=(const SmartBuffer& other) {
-        if (this != &other) {
-            if constexpr (use_static) {
-                buffer_ = other.buffer_;
-            } else {
-                if (!buffer_) {
-                    buffer_ = std::make_unique<std::uint8_t[]>(ACTUAL_SIZE);
-                }
-                std::copy_n(other.buffer_.get(), ACTUAL_SIZE, buffer_.get());
-            }
-        }
-        return *this;
-    }
+    SmartBuffer(SmartBuffer&& other) noexcept = default;
     
     /**
-     * @brief Move assignment operator
+     * @brief Copy assignment operator (trivial for static buffers)
      */
-    SmartBuffer& operator=(SmartBuffer&& other) noexcept {
-        if (this != &other) {
-            buffer_ = std::move(other.buffer_);
-        }
-        return *this;
-    }
+    SmartBuffer& operator=(const SmartBuffer& other) = default;
+    
+    /**
+     * @brief Move assignment operator (trivial for static buffers)
+     */
+    SmartBuffer& operator=(SmartBuffer&& other) noexcept = default;
     
     /**
      * @brief Destructor (default is sufficient)
@@ -114,11 +307,7 @@ public:
      * @return Pointer to the buffer data
      */
     operator std::uint8_t*() {
-        if constexpr (use_static) {
-            return buffer_.data();
-        } else {
-            return buffer_.get();
-        }
+        return buffer_.get();
     }
     
     /**
@@ -126,11 +315,7 @@ public:
      * @return Const pointer to the buffer data
      */
     operator const std::uint8_t*() const {
-        if constexpr (use_static) {
-            return buffer_.data();
-        } else {
-            return buffer_.get();
-        }
+        return buffer_.get();
     }
     
     /**
@@ -173,6 +358,14 @@ public:
         return use_static;
     }
     
+    /**
+     * @brief Get the memory resource backing a dynamic buffer
+     * @return The resource, or nullptr for the global heap and for static buffers
+     */
+    std::pmr::memory_resource* resource() const noexcept {
+        return buffer_.resource();
+    }
+    
     /**
      * @brief Get the static threshold value
      * @return The threshold value used for static vs dynamic allocation
@@ -204,7 +397,11 @@ public:
      * @param value Value to fill the buffer with
      */
     void fill(std::uint8_t value) {
-        std::fill_n(data(), Size, value);  // Only fill requested size
+        if constexpr (use_static) {
+            std::fill_n(data(), Size, value);  // Only fill requested size
+        } else {
+            smart_buffer_detail::fill_bytes(data(), Size, value);
+        }
     }
     
     /**
@@ -219,7 +416,11 @@ public:
      * @param value Value to fill the buffer with
      */
     void fill_all(std::uint8_t value) {
-        std::fill_n(data(), ACTUAL_SIZE, value);  // Fill entire allocated buffer
+        if constexpr (use_static) {
+            std::fill_n(data(), ACTUAL_SIZE, value);  // Fill entire allocated buffer
+        } else {
+            smart_buffer_detail::fill_bytes(data(), ACTUAL_SIZE, value);
+        }
     }
     
     /**
@@ -230,6 +431,27 @@ public:
     }
 };
 
+/**
+ * @brief A contiguous run of writable bytes inside a larger buffer structure
+ */
+struct SmartBufferSegment {
+    std::uint8_t* data;
+    std::size_t size;
+};
+
+/**
+ * @brief A contiguous run of read-only bytes inside a larger buffer structure
+ */
+struct SmartBufferConstSegment {
+    const std::uint8_t* data;
+    std::size_t size;
+};
+
+// Both storage strategies are position-independent: a static buffer is a plain
+// array and a dynamic buffer is a single owning pointer.
+template<std::size_t Size, std::size_t StaticThreshold>
+struct smart_buffer_trivially_relocatable<SmartBuffer<Size, StaticThreshold>> : std::true_type {};
+
 // Convenience type aliases with default threshold (32 bytes)
 using SmartBuffer8 = SmartBuffer<8>;
 using SmartBuffer16 = SmartBuffer<16>;
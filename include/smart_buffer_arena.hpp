@@ -0,0 +1,150 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+/**
+ * @brief A monotonic bump-pointer arena for short-lived dynamic SmartBuffers.
+ *
+ * @tparam InlineBytes Size of the first chunk, stored inside the arena object itself
+ *                     (on the stack when the arena is a local variable)
+ *
+ * Allocation bumps a pointer within the current chunk; when it is exhausted a new
+ * chunk twice the previous size is taken from the upstream resource. Deallocation is
+ * a no-op: all memory is returned at once by release() or the destructor.
+ *
+ * Typical use is one arena per request:
+ * @code
+ *   SmartBufferArena<8192> arena;
+ *   SmartBufferResourceScope scope(&arena);   // dynamic SmartBuffers now use the arena
+ *   SmartBuffer1K scratch;                    // bump allocation, free destruction
+ * @endcode
+ *
+ * Every buffer allocated from the arena must be destroyed before the arena.
+ * The arena is not thread-safe.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t InlineBytes = 4096>
+class SmartBufferArena : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Construct an arena
+     * @param chunk_size Size of the first heap chunk (later chunks double)
+     * @param upstream Resource supplying heap chunks
+     */
+    explicit SmartBufferArena(std::size_t chunk_size = 64 * 1024,
+                              std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream_(upstream), initial_chunk_size_(std::max<std::size_t>(chunk_size, 256)) {
+        reset_to_inline();
+    }
+
+    SmartBufferArena(const SmartBufferArena&) = delete;
+    SmartBufferArena& operator=(const SmartBufferArena&) = delete;
+
+    ~SmartBufferArena() override {
+        release_chunks();
+    }
+
+    /**
+     * @brief Return every heap chunk upstream and rewind to the inline chunk
+     */
+    void release() noexcept {
+        release_chunks();
+        reset_to_inline();
+    }
+
+    /**
+     * @brief Get the number of bytes handed out since construction or the last release()
+     */
+    std::size_t bytes_allocated() const noexcept { return bytes_allocated_; }
+
+    /**
+     * @brief Get the number of heap chunks currently held
+     */
+    std::size_t chunk_count() const noexcept { return chunk_count_; }
+
+    /**
+     * @brief Check if a pointer lies in the inline chunk
+     */
+    bool is_inline(const void* p) const noexcept {
+        auto* byte = static_cast<const unsigned char*>(p);
+        return byte >= inline_ && byte < inline_ + sizeof(inline_);
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        unsigned char* p = align_up(cursor_, alignment);
+        if (p + bytes > limit_ || p < cursor_) {
+            grow(bytes, alignment);
+            p = align_up(cursor_, alignment);
+        }
+        cursor_ = p + bytes;
+        bytes_allocated_ += bytes;
+        return p;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) noexcept override {
+        // Monotonic: memory is reclaimed by release()
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    // Header placed at the start of each heap chunk
+    struct alignas(std::max_align_t) ChunkHeader {
+        ChunkHeader* next;
+        std::size_t size;
+    };
+
+    static unsigned char* align_up(unsigned char* p, std::size_t alignment) noexcept {
+        auto address = reinterpret_cast<std::uintptr_t>(p);
+        return reinterpret_cast<unsigned char*>((address + alignment - 1) & ~(alignment - 1));
+    }
+
+    void grow(std::size_t bytes, std::size_t alignment) {
+        std::size_t needed = sizeof(ChunkHeader) + bytes + alignment;
+        std::size_t size = std::max(next_chunk_size_, needed);
+        auto* header = static_cast<ChunkHeader*>(upstream_->allocate(size, alignof(ChunkHeader)));
+        header->next = chunks_;
+        header->size = size;
+        chunks_ = header;
+        ++chunk_count_;
+        cursor_ = reinterpret_cast<unsigned char*>(header + 1);
+        limit_ = reinterpret_cast<unsigned char*>(header) + size;
+        next_chunk_size_ = size * 2;
+    }
+
+    void release_chunks() noexcept {
+        while (chunks_ != nullptr) {
+            ChunkHeader* next = chunks_->next;
+            upstream_->deallocate(chunks_, chunks_->size, alignof(ChunkHeader));
+            chunks_ = next;
+        }
+        chunk_count_ = 0;
+    }
+
+    void reset_to_inline() noexcept {
+        cursor_ = inline_;
+        limit_ = inline_ + InlineBytes;
+        next_chunk_size_ = initial_chunk_size_;
+        bytes_allocated_ = 0;
+    }
+
+    alignas(std::max_align_t) unsigned char inline_[InlineBytes == 0 ? 1 : InlineBytes];
+    std::pmr::memory_resource* upstream_;
+    std::size_t initial_chunk_size_;
+    std::size_t next_chunk_size_ = 0;
+    unsigned char* cursor_ = nullptr;
+    unsigned char* limit_ = nullptr;
+    ChunkHeader* chunks_ = nullptr;
+    std::size_t chunk_count_ = 0;
+    std::size_t bytes_allocated_ = 0;
+};
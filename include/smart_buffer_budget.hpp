@@ -0,0 +1,350 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+
+/**
+ * @brief What a SmartBufferBudget does when an allocation does not fit
+ */
+enum class SmartBufferBudgetMode {
+    Block,   // Wait until enough bytes are refunded
+    Fail,    // Throw std::bad_alloc
+};
+
+/**
+ * @brief Counters describing a SmartBufferBudget
+ */
+struct SmartBufferBudgetStats {
+    std::size_t limit = 0;
+    std::size_t used = 0;          // Bytes charged by live allocations
+    std::size_t blocked = 0;       // Allocations that had to wait
+    std::size_t rejected = 0;      // Allocations refused in Fail mode or by try_make()
+};
+
+/**
+ * @brief A memory resource that caps the bytes held by the allocations made through it
+ *        and applies backpressure when the cap is reached.
+ *
+ * Dynamic SmartBuffers are charged when their storage is allocated (construction or
+ * copy) and refunded when it is freed, by allocating them from the budget: pass it to
+ * the SmartBuffer constructor or install it with SmartBufferResourceScope. One budget
+ * per process or per tenant; a tenant budget can use the process budget as upstream.
+ *
+ * Accounting is sharded: each thread charges a cache-line-sized shard that holds a small
+ * credit drawn in batches from the global counter, so allocations under budget touch no
+ * shared cache line. Credit held by shards counts as used, so the limit is never
+ * exceeded; when an allocation does not fit, the idle credit of every shard is
+ * returned first.
+ *
+ * Over budget, allocation blocks or throws depending on the mode; try_make() never
+ * blocks, and wait_async() returns a future that becomes ready when a size fits.
+ *
+ * @requires C++17 or later
+ */
+class SmartBufferBudget : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Construct a budget
+     * @param limit Maximum bytes held through this budget
+     * @param upstream Resource that performs the allocations
+     * @param mode Behaviour of allocations that do not fit
+     */
+    explicit SmartBufferBudget(std::size_t limit,
+                               std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(),
+                               SmartBufferBudgetMode mode = SmartBufferBudgetMode::Block)
+        : upstream_(upstream), mode_(mode), limit_(limit),
+          batch_(std::min<std::size_t>(MAX_BATCH, limit / (4 * SHARD_COUNT))) {}
+
+    SmartBufferBudget(const SmartBufferBudget&) = delete;
+    SmartBufferBudget& operator=(const SmartBufferBudget&) = delete;
+
+    /**
+     * @brief Charge bytes without allocating, if they fit
+     */
+    bool try_reserve(std::size_t bytes) noexcept {
+        if (charge(bytes)) {
+            return true;
+        }
+        reclaim_credit();  // Idle credit in other shards may cover it
+        return charge(bytes);
+    }
+
+    /**
+     * @brief Charge bytes without allocating, waiting until they fit
+     */
+    void reserve(std::size_t bytes) {
+        if (!try_reserve(bytes)) {
+            wait_and_charge(bytes, nullptr);
+        }
+    }
+
+    /**
+     * @brief Charge bytes without allocating, waiting at most timeout
+     * @return false if the bytes did not fit in time
+     */
+    template<typename Rep, typename Period>
+    bool reserve_for(std::size_t bytes, std::chrono::duration<Rep, Period> timeout) {
+        if (try_reserve(bytes)) {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        return wait_and_charge(bytes, &deadline);
+    }
+
+    /**
+     * @brief Refund bytes charged by reserve()/try_reserve()
+     * @throws std::system_error if waking blocked waiters fails; the bytes are
+     *         refunded either way
+     */
+    void unreserve(std::size_t bytes) {
+        refund(bytes);
+    }
+
+    /**
+     * @brief Construct a buffer from this budget without blocking
+     * @return The buffer, or nothing if it does not fit
+     */
+    template<typename Buffer>
+    std::optional<Buffer> try_make() {
+        NonBlockingScope scope;
+        try {
+            return Buffer(this);
+        } catch (const std::bad_alloc&) {
+            return std::nullopt;
+        }
+    }
+
+    /**
+     * @brief Get a future that becomes ready once bytes fit under the budget
+     * Readiness is a hint: the bytes are not reserved, so the caller retries
+     * try_make()/try_reserve() and may have to wait again.
+     */
+    std::future<void> wait_async(std::size_t bytes) {
+        std::promise<void> promise;
+        std::future<void> future = promise.get_future();
+        std::lock_guard<std::mutex> lock(mutex_);
+        reclaim_credit();
+        if (global_.load(std::memory_order_relaxed) + bytes <= limit_.load(std::memory_order_relaxed)) {
+            promise.set_value();
+        } else {
+            async_waiters_.push_back(AsyncWaiter{bytes, std::move(promise)});
+            waiters_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return future;
+    }
+
+    /**
+     * @brief Change the limit; raising it wakes waiters
+     */
+    void set_limit(std::size_t limit) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            limit_.store(limit, std::memory_order_relaxed);
+        }
+        wake_waiters();
+    }
+
+    std::size_t limit() const noexcept { return limit_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the bytes charged by live allocations (shard credit excluded)
+     */
+    std::size_t used() const noexcept {
+        std::ptrdiff_t credit = 0;
+        for (const Shard& shard : shards_) {
+            credit += shard.credit.load(std::memory_order_relaxed);
+        }
+        auto used = static_cast<std::ptrdiff_t>(global_.load(std::memory_order_relaxed)) - credit;
+        return used > 0 ? static_cast<std::size_t>(used) : 0;
+    }
+
+    SmartBufferBudgetMode mode() const noexcept { return mode_; }
+
+    SmartBufferBudgetStats stats() const {
+        SmartBufferBudgetStats snapshot;
+        snapshot.limit = limit();
+        snapshot.used = used();
+        snapshot.blocked = blocked_.load(std::memory_order_relaxed);
+        snapshot.rejected = rejected_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (!try_reserve(bytes)) {
+            if (mode_ == SmartBufferBudgetMode::Fail || non_blocking()) {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                throw std::bad_alloc();
+            }
+            wait_and_charge(bytes, nullptr);
+        }
+        try {
+            return upstream_->allocate(bytes, alignment);
+        } catch (...) {
+            refund(bytes);
+            throw;
+        }
+    }
+
+    void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override {
+        upstream_->deallocate(block, bytes, alignment);
+        refund(bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    static constexpr std::size_t SHARD_COUNT = 16;
+    static constexpr std::size_t MAX_BATCH = 256 * 1024;
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) Shard {
+        // Bytes drawn from global_ but not charged; briefly negative while a charge
+        // that did not fit is being undone
+        std::atomic<std::ptrdiff_t> credit{0};
+    };
+
+    struct AsyncWaiter {
+        std::size_t bytes;
+        std::promise<void> promise;
+    };
+
+    // Marks the current thread's allocations as non-blocking (used by try_make)
+    struct NonBlockingScope {
+        NonBlockingScope() noexcept : previous_(non_blocking()) { non_blocking() = true; }
+        ~NonBlockingScope() { non_blocking() = previous_; }
+        bool previous_;
+    };
+
+    static bool& non_blocking() noexcept {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    static std::size_t shard_index() noexcept {
+        static std::atomic<std::size_t> next{0};
+        static thread_local std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+        return index;
+    }
+
+    // Take bytes from the global counter if they fit under the limit
+    bool draw(std::size_t bytes) noexcept {
+        std::size_t current = global_.load(std::memory_order_relaxed);
+        do {
+            if (current + bytes > limit_.load(std::memory_order_relaxed) || current + bytes < current) {
+                return false;
+            }
+        } while (!global_.compare_exchange_weak(current, current + bytes, std::memory_order_relaxed));
+        return true;
+    }
+
+    // Charge bytes against the calling thread's shard, refilling it from the global counter
+    bool charge(std::size_t bytes) noexcept {
+        Shard& shard = shards_[shard_index()];
+        auto amount = static_cast<std::ptrdiff_t>(bytes);
+        if (shard.credit.fetch_sub(amount, std::memory_order_relaxed) >= amount) {
+            return true;
+        }
+        shard.credit.fetch_add(amount, std::memory_order_relaxed);
+        if (batch_ > bytes && draw(batch_)) {
+            shard.credit.fetch_add(static_cast<std::ptrdiff_t>(batch_) - amount, std::memory_order_relaxed);
+            return true;
+        }
+        return draw(bytes);
+    }
+
+    // Not noexcept: waking waiters locks mutex_. The credit is returned first, so an
+    // exception from the wakeup leaves the accounting intact.
+    void refund(std::size_t bytes) {
+        Shard& shard = shards_[shard_index()];
+        // seq_cst pairs with the waiter registration in wait_and_charge() so that either
+        // the waiter sees this credit or this thread sees the waiter (free on x86)
+        auto amount = static_cast<std::ptrdiff_t>(bytes);
+        std::ptrdiff_t credit = shard.credit.fetch_add(amount, std::memory_order_seq_cst) + amount;
+        auto batch = static_cast<std::ptrdiff_t>(batch_);
+        if (credit > 2 * batch) {
+            // Keep one batch locally and hand the rest back
+            if (shard.credit.compare_exchange_strong(credit, batch, std::memory_order_relaxed)) {
+                global_.fetch_sub(static_cast<std::size_t>(credit - batch), std::memory_order_relaxed);
+            }
+        }
+        if (waiters_.load(std::memory_order_seq_cst) != 0) {
+            wake_waiters();
+        }
+    }
+
+    // Return every shard's idle credit to the global counter
+    void reclaim_credit() noexcept {
+        for (Shard& shard : shards_) {
+            std::ptrdiff_t credit = shard.credit.exchange(0, std::memory_order_relaxed);
+            if (credit != 0) {
+                // Modular arithmetic: a negative credit correctly raises global_
+                global_.fetch_sub(static_cast<std::size_t>(credit), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool wait_and_charge(std::size_t bytes, const std::chrono::steady_clock::time_point* deadline) {
+        blocked_.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        bool charged = false;
+        while (!(charged = try_reserve(bytes))) {
+            if (deadline == nullptr) {
+                available_.wait(lock);
+            } else if (available_.wait_until(lock, *deadline) == std::cv_status::timeout) {
+                charged = try_reserve(bytes);
+                break;
+            }
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return charged;
+    }
+
+    void wake_waiters() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reclaim_credit();
+        std::size_t free_bytes = limit_.load(std::memory_order_relaxed);
+        std::size_t global = global_.load(std::memory_order_relaxed);
+        free_bytes = free_bytes > global ? free_bytes - global : 0;
+        for (auto it = async_waiters_.begin(); it != async_waiters_.end();) {
+            if (it->bytes <= free_bytes) {
+                it->promise.set_value();
+                it = async_waiters_.erase(it);
+                waiters_.fetch_sub(1, std::memory_order_relaxed);
+            } else {
+                ++it;
+            }
+        }
+        available_.notify_all();
+    }
+
+    std::pmr::memory_resource* upstream_;
+    SmartBufferBudgetMode mode_;
+    std::atomic<std::size_t> limit_;
+    std::size_t batch_;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> global_{0};   // Bytes charged or held as shard credit
+    Shard shards_[SHARD_COUNT];
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> waiters_{0};
+    std::atomic<std::size_t> blocked_{0};
+    std::atomic<std::size_t> rejected_{0};
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::list<AsyncWaiter> async_waiters_;
+};
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <utility>
+
+#include <sys/uio.h>
+
+/**
+ * @brief An append-only byte queue built from a chain of fixed-size pooled chunks
+ *        (IOBuf-style).
+ *
+ * @tparam ChunkSize Size of each SmartBuffer chunk in bytes
+ *
+ * Appending never moves bytes that are already queued: when the tail chunk is full a
+ * new SmartBuffer<ChunkSize> is taken from the pool. The front chunk keeps headroom so
+ * protocol headers can be prepended after the body is built. Consumers either gather
+ * the chain into an iovec array for vectored I/O or coalesce() just the prefix that
+ * must be contiguous.
+ *
+ * The pool must outlive the queue.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t ChunkSize>
+class SmartBufferByteQueue {
+public:
+    using Pool = SmartBufferPool<ChunkSize>;
+    using Chunk = SmartBuffer<ChunkSize>;
+
+    static_assert(ChunkSize > 0, "SmartBufferByteQueue requires a non-zero chunk size");
+
+    /**
+     * @brief Construct an empty queue drawing chunks from pool
+     * @param headroom Bytes left free at the front of the first chunk for prepend()
+     */
+    explicit SmartBufferByteQueue(Pool& pool, std::size_t headroom = 0)
+        : pool_(&pool), headroom_(std::min(headroom, ChunkSize)) {}
+
+    SmartBufferByteQueue(const SmartBufferByteQueue&) = delete;
+    SmartBufferByteQueue& operator=(const SmartBufferByteQueue&) = delete;
+
+    SmartBufferByteQueue(SmartBufferByteQueue&& other) noexcept
+        : pool_(other.pool_), headroom_(other.headroom_), chain_(std::move(other.chain_)), size_(other.size_) {
+        other.size_ = 0;
+    }
+
+    ~SmartBufferByteQueue() {
+        clear();
+    }
+
+    /**
+     * @brief Get the number of queued bytes
+     */
+    std::size_t size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Get the number of chunks in the chain
+     */
+    std::size_t chunk_count() const noexcept { return chain_.size(); }
+
+    /**
+     * @brief Append bytes at the end of the queue
+     */
+    void append(const void* data, std::size_t size) {
+        auto* source = static_cast<const std::uint8_t*>(data);
+        while (size > 0) {
+            if (chain_.empty() || chain_.back().end == ChunkSize) {
+                push_chunk_back(chain_.empty() ? headroom_ : 0);
+            }
+            Link& tail = chain_.back();
+            std::size_t count = std::min(size, ChunkSize - tail.end);
+            std::memcpy(tail.chunk.data() + tail.end, source, count);
+            tail.end += count;
+            size_ += count;
+            source += count;
+            size -= count;
+        }
+    }
+
+    /**
+     * @brief Get the free space at the end of the tail chunk for in-place writes,
+     *        taking a new chunk if the tail is full. Call commit_append() afterwards.
+     */
+    SmartBufferSegment append_region() {
+        if (chain_.empty() || chain_.back().end == ChunkSize) {
+            push_chunk_back(chain_.empty() ? headroom_ : 0);
+        }
+        Link& tail = chain_.back();
+        return {tail.chunk.data() + tail.end, ChunkSize - tail.end};
+    }
+
+    /**
+     * @brief Publish bytes written into append_region()
+     */
+    void commit_append(std::size_t size) noexcept {
+        chain_.back().end += size;
+        size_ += size;
+    }
+
+    /**
+     * @brief Insert bytes before the current front, using the front chunk's headroom
+     * If the headroom is too small, a new chunk is linked in front and filled from its end,
+     * which leaves headroom for further prepends.
+     */
+    void prepend(const void* data, std::size_t size) {
+        auto* source = static_cast<const std::uint8_t*>(data);
+        while (size > 0) {
+            if (chain_.empty() || chain_.front().begin == 0) {
+                push_chunk_front();
+            }
+            Link& head = chain_.front();
+            std::size_t count = std::min(size, head.begin);
+            head.begin -= count;
+            std::memcpy(head.chunk.data() + head.begin, source + size - count, count);
+            size_ += count;
+            size -= count;
+        }
+    }
+
+    /**
+     * @brief Get the headroom available in the front chunk
+     */
+    std::size_t headroom() const noexcept {
+        return chain_.empty() ? headroom_ : chain_.front().begin;
+    }
+
+    /**
+     * @brief Drop size bytes from the front, returning emptied chunks to the pool
+     */
+    void trim_front(std::size_t size) {
+        size = std::min(size, size_);
+        size_ -= size;
+        while (size > 0) {
+            Link& head = chain_.front();
+            std::size_t count = std::min(size, head.end - head.begin);
+            head.begin += count;
+            size -= count;
+            if (head.begin == head.end) {
+                pop_chunk_front();
+            }
+        }
+    }
+
+    /**
+     * @brief Describe the queued bytes as an iovec array for writev/sendmsg
+     * @return Number of entries written (at most max_entries)
+     */
+    std::size_t gather(struct iovec* iov, std::size_t max_entries) const noexcept {
+        std::size_t count = 0;
+        for (const Link& link : chain_) {
+            if (count == max_entries) {
+                break;
+            }
+            if (link.end > link.begin) {
+                iov[count].iov_base = const_cast<std::uint8_t*>(link.chunk.data()) + link.begin;
+                iov[count].iov_len = link.end - link.begin;
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Invoke fn(SmartBufferConstSegment) for each chunk's queued bytes in order
+     */
+    template<typename Fn>
+    void for_each_chunk(Fn&& fn) const {
+        for (const Link& link : chain_) {
+            fn(SmartBufferConstSegment{link.chunk.data() + link.begin, link.end - link.begin});
+        }
+    }
+
+    /**
+     * @brief Make the first size bytes contiguous and return a pointer to them
+     * Copies only when the prefix spans several chunks; the copy lands in one pooled chunk.
+     * @throws std::length_error if size exceeds the queued bytes or ChunkSize
+     */
+    const std::uint8_t* coalesce(std::size_t size) {
+        if (size > size_ || size > ChunkSize) {
+            throw std::length_error("SmartBufferByteQueue: cannot coalesce more than one chunk or than queued");
+        }
+        if (size == 0) {
+            return chain_.empty() ? nullptr : chain_.front().chunk.data() + chain_.front().begin;
+        }
+        Link& head = chain_.front();
+        if (head.end - head.begin >= size) {
+            return head.chunk.data() + head.begin;
+        }
+
+        // Copy the prefix into a fresh chunk, keeping it right-aligned so any
+        // headroom survives, then splice it in front of the remaining bytes
+        Link merged{pool_->acquire(), ChunkSize - size, ChunkSize};
+        std::size_t copied = 0;
+        while (copied < size) {
+            Link& front = chain_.front();
+            std::size_t count = std::min(size - copied, front.end - front.begin);
+            std::memcpy(merged.chunk.data() + merged.begin + copied, front.chunk.data() + front.begin, count);
+            front.begin += count;
+            copied += count;
+            if (front.begin == front.end) {
+                pop_chunk_front();
+            }
+        }
+        chain_.push_front(std::move(merged));
+        return chain_.front().chunk.data() + chain_.front().begin;
+    }
+
+    /**
+     * @brief Copy size bytes from the front into out without consuming them
+     * @return Number of bytes copied
+     */
+    std::size_t copy_out(void* out, std::size_t size) const noexcept {
+        auto* dest = static_cast<std::uint8_t*>(out);
+        std::size_t copied = 0;
+        for (const Link& link : chain_) {
+            if (copied == size) {
+                break;
+            }
+            std::size_t count = std::min(size - copied, link.end - link.begin);
+            std::memcpy(dest + copied, link.chunk.data() + link.begin, count);
+            copied += count;
+        }
+        return copied;
+    }
+
+    /**
+     * @brief Drop all bytes and return every chunk to the pool
+     */
+    void clear() {
+        while (!chain_.empty()) {
+            pop_chunk_front();
+        }
+        size_ = 0;
+    }
+
+private:
+    // One chunk of the chain; queued bytes are [begin, end)
+    struct Link {
+        Chunk chunk;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    void push_chunk_back(std::size_t offset) {
+        chain_.push_back(Link{pool_->acquire(), offset, offset});
+    }
+
+    void push_chunk_front() {
+        chain_.push_front(Link{pool_->acquire(), ChunkSize, ChunkSize});
+    }
+
+    void pop_chunk_front() {
+        pool_->release(std::move(chain_.front().chunk));
+        chain_.pop_front();
+    }
+
+    Pool* pool_;
+    std::size_t headroom_;
+    std::deque<Link> chain_;
+    std::size_t size_ = 0;
+};
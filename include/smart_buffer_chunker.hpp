@@ -0,0 +1,431 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_digest.hpp"
+#include "smart_buffer_hash_batch.hpp"
+#include "smart_buffer_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+/**
+ * @brief Chunk size bounds of a content-defined chunker
+ *
+ * Cut points are never placed before min_size or after max_size bytes. avg_size is
+ * rounded down to a power of two and sets the cut probability.
+ */
+struct SmartBufferChunkerParams {
+    std::size_t min_size = 4 * 1024;
+    std::size_t avg_size = 16 * 1024;
+    std::size_t max_size = 64 * 1024;
+};
+
+namespace smart_buffer_detail {
+
+// Random 64-bit values per byte for the Gear rolling hash (splitmix64)
+struct GearTable {
+    std::array<std::uint64_t, 256> entries{};
+
+    constexpr GearTable() noexcept {
+        std::uint64_t state = 0x5EED5EED5EED5EEDULL;
+        for (auto& entry : entries) {
+            state += 0x9E3779B97F4A7C15ULL;
+            std::uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            entry = z ^ (z >> 31);
+        }
+    }
+};
+
+inline constexpr GearTable GEAR_TABLE{};
+
+// The Gear hash at a position covers only the 64 bytes ending there, so it can be
+// recomputed exactly from any earlier point, which is what lets the lanes below scan
+// independent stripes
+inline constexpr std::size_t GEAR_WINDOW = 64;
+
+/**
+ * @brief First position in [from, to) of a chunk whose Gear hash has no bit of mask
+ *        set, or to if none; hashing starts at min_size
+ */
+inline std::size_t gear_scan_scalar(const std::uint8_t* chunk, std::size_t from, std::size_t to,
+                                    std::size_t min_size, std::uint64_t mask) noexcept {
+    std::uint64_t fp = 0;
+    for (std::size_t j = std::max(min_size, from - std::min(from, GEAR_WINDOW)); j < from; ++j) {
+        fp = (fp << 1) + GEAR_TABLE.entries[chunk[j]];
+    }
+    for (std::size_t i = from; i < to; ++i) {
+        fp = (fp << 1) + GEAR_TABLE.entries[chunk[i]];
+        if ((fp & mask) == 0) {
+            return i;
+        }
+    }
+    return to;
+}
+
+#if SMART_BUFFER_X86_DISPATCH
+
+// The vector kernels split a window of 8 * GEAR_STRIPE bytes into one stripe per lane.
+// Each lane rolls its own hash after a warm-up over the 64 bytes before its stripe;
+// lane 0's warm-up may reach back before min_size, where hashing has not started.
+// Table lookups are gathers, and the byte stream of each lane comes from one 8-byte
+// gather every 8 positions.
+inline constexpr std::size_t GEAR_STRIPE = 512;
+
+__attribute__((target("avx2"))) SMART_BUFFER_NOINLINE
+inline std::size_t gear_scan_avx2(const std::uint8_t* chunk, std::size_t from, std::size_t to,
+                                  std::size_t min_size, std::uint64_t mask) noexcept {
+    constexpr std::size_t lanes = 4;
+    const auto* gear = reinterpret_cast<const long long*>(GEAR_TABLE.entries.data());
+    const __m256i stripe_offsets = _mm256_setr_epi64x(0, GEAR_STRIPE, 2 * GEAR_STRIPE, 3 * GEAR_STRIPE);
+    const __m256i byte_mask = _mm256_set1_epi64x(0xFF);
+    const __m256i hash_mask = _mm256_set1_epi64x(static_cast<long long>(mask));
+    const __m256i none = _mm256_set1_epi64x(GEAR_STRIPE);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; to - from >= lanes * GEAR_STRIPE; from += lanes * GEAR_STRIPE) {
+        const auto* base = reinterpret_cast<const long long*>(chunk + from - GEAR_WINDOW);
+        __m256i position = _mm256_add_epi64(stripe_offsets, _mm256_set1_epi64x(static_cast<long long>(from - GEAR_WINDOW)));
+        const __m256i before_min = _mm256_set1_epi64x(static_cast<long long>(min_size) - 1);
+        __m256i fp = zero;
+        for (std::size_t t = 0; t < GEAR_WINDOW; t += 8) {
+            __m256i words = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(
+                reinterpret_cast<const std::uint8_t*>(base) + t), stripe_offsets, 1);
+            for (int k = 0; k < 8; ++k) {
+                __m256i g = _mm256_i64gather_epi64(gear, _mm256_and_si256(_mm256_srli_epi64(words, 8 * k), byte_mask), 8);
+                fp = _mm256_add_epi64(_mm256_slli_epi64(fp, 1), g);
+                fp = _mm256_and_si256(fp, _mm256_cmpgt_epi64(position, before_min));
+                position = _mm256_add_epi64(position, _mm256_set1_epi64x(1));
+            }
+        }
+        const auto* stripe = reinterpret_cast<const std::uint8_t*>(base) + GEAR_WINDOW;
+        __m256i first = none;
+        for (std::size_t t = 0; t < GEAR_STRIPE; t += 8) {
+            __m256i words = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(stripe + t), stripe_offsets, 1);
+            for (int k = 0; k < 8; ++k) {
+                __m256i g = _mm256_i64gather_epi64(gear, _mm256_and_si256(_mm256_srli_epi64(words, 8 * k), byte_mask), 8);
+                fp = _mm256_add_epi64(_mm256_slli_epi64(fp, 1), g);
+                __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi64(_mm256_and_si256(fp, hash_mask), zero),
+                                               _mm256_cmpeq_epi64(first, none));
+                first = _mm256_blendv_epi8(first, _mm256_set1_epi64x(static_cast<long long>(t + k)), hit);
+            }
+        }
+        alignas(32) std::uint64_t hits[lanes];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(hits), first);
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            if (hits[lane] < GEAR_STRIPE) {
+                return from + lane * GEAR_STRIPE + hits[lane];
+            }
+        }
+    }
+    return gear_scan_scalar(chunk, from, to, min_size, mask);
+}
+
+__attribute__((target("avx512f"))) SMART_BUFFER_NOINLINE
+inline std::size_t gear_scan_avx512(const std::uint8_t* chunk, std::size_t from, std::size_t to,
+                                    std::size_t min_size, std::uint64_t mask) noexcept {
+    constexpr std::size_t lanes = 8;
+    const auto* gear = GEAR_TABLE.entries.data();
+    const __m512i stripe_offsets = _mm512_setr_epi64(0, GEAR_STRIPE, 2 * GEAR_STRIPE, 3 * GEAR_STRIPE,
+                                                     4 * GEAR_STRIPE, 5 * GEAR_STRIPE, 6 * GEAR_STRIPE, 7 * GEAR_STRIPE);
+    const __m512i byte_mask = _mm512_set1_epi64(0xFF);
+    const __m512i hash_mask = _mm512_set1_epi64(static_cast<long long>(mask));
+    // Masked forms with an explicit zero source; the unmasked ones trip -Wmaybe-uninitialized
+    const __m512i zero = _mm512_setzero_si512();
+    const __mmask8 all = 0xFF;
+    for (; to - from >= lanes * GEAR_STRIPE; from += lanes * GEAR_STRIPE) {
+        const std::uint8_t* base = chunk + from - GEAR_WINDOW;
+        __m512i position = _mm512_add_epi64(stripe_offsets, _mm512_set1_epi64(static_cast<long long>(from - GEAR_WINDOW)));
+        const __m512i min_position = _mm512_set1_epi64(static_cast<long long>(min_size));
+        __m512i fp = zero;
+        for (std::size_t t = 0; t < GEAR_WINDOW; t += 8) {
+            __m512i words = _mm512_mask_i64gather_epi64(zero, all, stripe_offsets, base + t, 1);
+            for (int k = 0; k < 8; ++k) {
+                __m512i g = _mm512_mask_i64gather_epi64(zero, all, _mm512_and_si512(_mm512_maskz_srli_epi64(all, words, 8 * k), byte_mask), gear, 8);
+                __mmask8 started = _mm512_cmpge_epu64_mask(position, min_position);
+                fp = _mm512_maskz_add_epi64(started, _mm512_add_epi64(fp, fp), g);
+                position = _mm512_add_epi64(position, _mm512_set1_epi64(1));
+            }
+        }
+        const std::uint8_t* stripe = base + GEAR_WINDOW;
+        __m512i first = _mm512_set1_epi64(GEAR_STRIPE);
+        __mmask8 found = 0;
+        for (std::size_t t = 0; t < GEAR_STRIPE; t += 8) {
+            __m512i words = _mm512_mask_i64gather_epi64(zero, all, stripe_offsets, stripe + t, 1);
+            for (int k = 0; k < 8; ++k) {
+                __m512i g = _mm512_mask_i64gather_epi64(zero, all, _mm512_and_si512(_mm512_maskz_srli_epi64(all, words, 8 * k), byte_mask), gear, 8);
+                fp = _mm512_add_epi64(_mm512_add_epi64(fp, fp), g);
+                __mmask8 hit = _mm512_mask_testn_epi64_mask(static_cast<__mmask8>(~found), fp, hash_mask);
+                first = _mm512_mask_mov_epi64(first, hit, _mm512_set1_epi64(static_cast<long long>(t + k)));
+                found = static_cast<__mmask8>(found | hit);
+            }
+        }
+        if (found != 0) {
+            alignas(64) std::uint64_t hits[lanes];
+            _mm512_store_si512(hits, first);
+            unsigned lane = static_cast<unsigned>(__builtin_ctz(found));
+            return from + lane * GEAR_STRIPE + hits[lane];
+        }
+    }
+    return gear_scan_scalar(chunk, from, to, min_size, mask);
+}
+
+#endif
+
+inline std::size_t gear_scan(const std::uint8_t* chunk, std::size_t from, std::size_t to,
+                             std::size_t min_size, std::uint64_t mask) noexcept {
+#if SMART_BUFFER_X86_DISPATCH
+    switch (smart_buffer_hash_isa()) {
+    case SmartBufferHashIsa::Avx512:
+        return gear_scan_avx512(chunk, from, to, min_size, mask);
+    case SmartBufferHashIsa::Avx2:
+        return gear_scan_avx2(chunk, from, to, min_size, mask);
+    case SmartBufferHashIsa::Scalar:
+        break;
+    }
+#endif
+    return gear_scan_scalar(chunk, from, to, min_size, mask);
+}
+
+/**
+ * @brief FastCDC cut rule: a stricter mask before avg_size and a looser one after it
+ *        (normalized chunking), so chunk sizes cluster around avg_size
+ */
+struct GearCutter {
+    std::size_t min_size;
+    std::size_t normal_size;
+    std::size_t max_size;
+    std::uint64_t mask_small;
+    std::uint64_t mask_large;
+
+    explicit GearCutter(const SmartBufferChunkerParams& params) {
+        if (params.min_size < GEAR_WINDOW || params.min_size >= params.avg_size || params.avg_size >= params.max_size) {
+            throw std::invalid_argument("SmartBufferChunker: need 64 <= min_size < avg_size < max_size");
+        }
+        unsigned bits = 63 - static_cast<unsigned>(__builtin_clzll(params.avg_size));
+        min_size = params.min_size;
+        normal_size = std::size_t(1) << bits;
+        max_size = params.max_size;
+        // Mask the top bits: they depend on all 64 bytes in the window
+        mask_small = ~std::uint64_t(0) << (64 - (bits + 2));
+        mask_large = ~std::uint64_t(0) << (64 - (bits - 2));
+        normal_size = std::max(normal_size, min_size);
+    }
+
+    /**
+     * @brief Length of the chunk starting at chunk, given available bytes of it of which
+     *        the first scanned were already found to hold no cut point
+     * @return 0 if more bytes are needed to decide
+     */
+    std::size_t cut(const std::uint8_t* chunk, std::size_t scanned, std::size_t available) const noexcept {
+        std::size_t end = std::min(available, max_size);
+        std::size_t from = std::max(scanned, min_size);
+        if (from < normal_size && from < end) {
+            std::size_t to = std::min(normal_size, end);
+            std::size_t hit = gear_scan(chunk, from, to, min_size, mask_small);
+            if (hit < to) {
+                return hit + 1;
+            }
+            from = to;
+        }
+        if (from < end) {
+            std::size_t hit = gear_scan(chunk, from, end, min_size, mask_large);
+            if (hit < end) {
+                return hit + 1;
+            }
+        }
+        return end == max_size ? max_size : 0;
+    }
+};
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief Length of the first content-defined chunk of a byte range
+ *
+ * Returns size when size is below max_size and no cut point is found, i.e. the range
+ * is treated as the end of the stream.
+ *
+ * @throws std::invalid_argument if the bounds are inconsistent
+ */
+inline std::size_t smart_buffer_cdc_cut(const void* data, std::size_t size, const SmartBufferChunkerParams& params = {}) {
+    smart_buffer_detail::GearCutter cutter(params);
+    std::size_t length = cutter.cut(static_cast<const std::uint8_t*>(data), 0, size);
+    return length != 0 ? length : size;
+}
+
+/**
+ * @brief Content-defined chunker (FastCDC with a Gear rolling hash) that emits pooled
+ *        SmartBuffer chunks with BLAKE3 fingerprints.
+ *
+ * @tparam MaxSize Size of the SmartBuffers chunks are copied into; bounds max_size
+ *
+ * Cut points depend only on the bytes around them, so inserting or deleting bytes
+ * changes the chunks near the edit and leaves the rest, and their fingerprints, the same
+ * (unlike fixed-size chunking, where every later chunk shifts).
+ *
+ * Input is pushed with update() in pieces of any size, or read from a file descriptor
+ * with read_fd(); each completed chunk is passed to emit(Chunk&&). Every input byte is
+ * copied once into its chunk's buffer, except the bytes of a piece that follow the last
+ * cut point, which are copied once more if that chunk is still open when the next
+ * piece begins. finish() emits the final, possibly short, chunk.
+ *
+ * The receiver owns emitted buffers and should give them back with pool().release().
+ * The pool must outlive the chunker.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t MaxSize = 64 * 1024>
+class SmartBufferChunker {
+public:
+    using Buffer = SmartBuffer<MaxSize>;
+    using Pool = SmartBufferPool<MaxSize>;
+
+    struct Chunk {
+        Buffer buffer;                  // Bytes [0, size) hold the chunk
+        std::size_t size;
+        std::uint64_t offset;           // Position of the chunk in the stream
+        SmartBuffer<32> fingerprint;    // BLAKE3 of the chunk
+    };
+
+    /**
+     * @throws std::invalid_argument if the bounds are inconsistent or exceed MaxSize
+     */
+    explicit SmartBufferChunker(Pool& pool, const SmartBufferChunkerParams& params = {})
+        : pool_(&pool), cutter_(params) {
+        if (params.max_size > MaxSize) {
+            throw std::invalid_argument("SmartBufferChunker: max_size exceeds the buffer size");
+        }
+    }
+
+    SmartBufferChunker(const SmartBufferChunker&) = delete;
+    SmartBufferChunker& operator=(const SmartBufferChunker&) = delete;
+
+    ~SmartBufferChunker() {
+        if (pending_) {
+            pool_->release(std::move(*pending_));
+        }
+    }
+
+    /**
+     * @brief Chunk the next piece of the stream
+     */
+    template<typename Emit>
+    void update(const void* data, std::size_t size, Emit&& emit) {
+        auto* p = static_cast<const std::uint8_t*>(data);
+        while (size > 0) {
+            if (!pending_ && size >= cutter_.max_size) {
+                // A whole chunk's worth is contiguous in the input: cut it in place
+                std::size_t length = cutter_.cut(p, 0, size);
+                Buffer buffer = pool_->acquire();
+                std::memcpy(buffer.data(), p, length);
+                emit_chunk(std::move(buffer), length, emit);
+                p += length;
+                size -= length;
+                continue;
+            }
+            if (!pending_) {
+                pending_.emplace(pool_->acquire());
+            }
+            std::size_t take = std::min(size, cutter_.max_size - pending_size_);
+            std::memcpy(pending_->data() + pending_size_, p, take);
+            std::size_t before = pending_size_;
+            pending_size_ += take;
+            std::size_t length = cutter_.cut(pending_->data(), scanned_, pending_size_);
+            if (length == 0) {
+                scanned_ = pending_size_;
+                p += take;
+                size -= take;
+                continue;
+            }
+            // Bytes past the cut return to the input instead of staying in this buffer
+            std::size_t consumed = length - before;
+            pending_size_ = length;
+            close_pending(emit);
+            p += consumed;
+            size -= consumed;
+        }
+    }
+
+    /**
+     * @brief Emit the last chunk, if any bytes are pending; the stream can then restart
+     */
+    template<typename Emit>
+    void finish(Emit&& emit) {
+        if (pending_ && pending_size_ > 0) {
+            close_pending(emit);
+        }
+    }
+
+    /**
+     * @brief Chunk everything readable from fd until end of file, then finish()
+     * @return Bytes read
+     * @throws std::system_error if read() fails
+     */
+    template<typename Emit>
+    std::uint64_t read_fd(int fd, Emit&& emit, std::size_t read_size = 1 << 20) {
+        std::vector<std::uint8_t> staging(std::max(read_size, cutter_.max_size));
+        std::uint64_t total = 0;
+        for (;;) {
+            ssize_t got = ::read(fd, staging.data(), staging.size());
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "SmartBufferChunker: read");
+            }
+            if (got == 0) {
+                break;
+            }
+            update(staging.data(), static_cast<std::size_t>(got), emit);
+            total += static_cast<std::uint64_t>(got);
+        }
+        finish(emit);
+        return total;
+    }
+
+    /**
+     * @brief Get the bytes chunked so far, including the open chunk
+     */
+    std::uint64_t offset() const noexcept { return offset_ + pending_size_; }
+
+    Pool& pool() noexcept { return *pool_; }
+
+private:
+    template<typename Emit>
+    void close_pending(Emit& emit) {
+        Buffer buffer = std::move(*pending_);
+        pending_.reset();
+        std::size_t length = pending_size_;
+        pending_size_ = 0;
+        scanned_ = 0;
+        emit_chunk(std::move(buffer), length, emit);
+    }
+
+    template<typename Emit>
+    void emit_chunk(Buffer&& buffer, std::size_t length, Emit& emit) {
+        SmartBuffer<32> fingerprint = smart_buffer_blake3(buffer.data(), length);
+        Chunk chunk{std::move(buffer), length, offset_, std::move(fingerprint)};
+        offset_ += length;
+        emit(std::move(chunk));
+    }
+
+    Pool* pool_;
+    smart_buffer_detail::GearCutter cutter_;
+    std::optional<Buffer> pending_;   // The open chunk
+    std::size_t pending_size_ = 0;
+    std::size_t scanned_ = 0;
+    std::uint64_t offset_ = 0;
+};
@@ -0,0 +1,772 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_hash.hpp"
+#include "smart_buffer_hash_batch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#if SMART_BUFFER_X86_DISPATCH
+#include <cpuid.h>
+#endif
+
+namespace smart_buffer_detail {
+
+SMART_BUFFER_ALWAYS_INLINE std::uint32_t load_be32(const std::uint8_t* p) noexcept {
+    return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16)
+         | (static_cast<std::uint32_t>(p[2]) << 8) | static_cast<std::uint32_t>(p[3]);
+}
+
+SMART_BUFFER_ALWAYS_INLINE void store_be32(std::uint8_t* p, std::uint32_t value) noexcept {
+    p[0] = static_cast<std::uint8_t>(value >> 24);
+    p[1] = static_cast<std::uint8_t>(value >> 16);
+    p[2] = static_cast<std::uint8_t>(value >> 8);
+    p[3] = static_cast<std::uint8_t>(value);
+}
+
+SMART_BUFFER_ALWAYS_INLINE void store_le32(std::uint8_t* p, std::uint32_t value) noexcept {
+    std::memcpy(p, &value, sizeof(value));
+}
+
+// ---------------------------------------------------------------------------
+// SHA-256 (FIPS 180-4)
+// ---------------------------------------------------------------------------
+
+inline constexpr std::uint32_t SHA256_IV[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+alignas(16) inline constexpr std::uint32_t SHA256_K[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2};
+
+SMART_BUFFER_ALWAYS_INLINE constexpr std::uint32_t rotr32(std::uint32_t x, int r) noexcept {
+    return (x >> r) | (x << (32 - r));
+}
+
+inline void sha256_compress_portable(std::uint32_t state[8], const std::uint8_t* data, std::size_t blocks) noexcept {
+    for (; blocks > 0; --blocks, data += 64) {
+        std::uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = load_be32(data + 4 * i);
+        }
+        for (int i = 16; i < 64; ++i) {
+            std::uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            std::uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            std::uint32_t t1 = h + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) + ((e & f) ^ (~e & g))
+                             + SHA256_K[i] + w[i];
+            std::uint32_t t2 = (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if SMART_BUFFER_X86_DISPATCH
+
+/**
+ * @brief SHA-256 block function on the SHA extensions (sha256rnds2/msg1/msg2)
+ */
+__attribute__((target("sha,sse4.1"))) SMART_BUFFER_NOINLINE
+inline void sha256_compress_shani(std::uint32_t state[8], const std::uint8_t* data, std::size_t blocks) noexcept {
+    const __m128i byte_swap = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+    // The instructions want the state as ABEF / CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (; blocks > 0; --blocks, data += 64) {
+        __m128i abef = state0;
+        __m128i cdgh = state1;
+        __m128i w[4];
+        for (int t = 0; t < 16; ++t) {
+            __m128i& x = w[t & 3];
+            if (t < 4) {
+                x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * t)), byte_swap);
+            } else {
+                // W[t] from W[t-4] (x), W[t-3], W[t-2] and W[t-1]
+                __m128i sum = _mm_add_epi32(_mm_sha256msg1_epu32(x, w[(t + 1) & 3]),
+                                            _mm_alignr_epi8(w[(t + 3) & 3], w[(t + 2) & 3], 4));
+                x = _mm_sha256msg2_epu32(sum, w[(t + 3) & 3]);
+            }
+            __m128i message = _mm_add_epi32(x, _mm_load_si128(reinterpret_cast<const __m128i*>(&SHA256_K[4 * t])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(message, 0x0E));
+        }
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+inline bool has_sha_extensions() noexcept {
+    static const bool supported = [] {
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        __builtin_cpu_init();
+        return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+    }();
+    return supported;
+}
+
+#else
+
+inline bool has_sha_extensions() noexcept {
+    return false;
+}
+
+#endif
+
+inline void sha256_compress(std::uint32_t state[8], const std::uint8_t* data, std::size_t blocks) noexcept {
+#if SMART_BUFFER_X86_DISPATCH
+    if (has_sha_extensions()) {
+        sha256_compress_shani(state, data, blocks);
+        return;
+    }
+#endif
+    sha256_compress_portable(state, data, blocks);
+}
+
+// ---------------------------------------------------------------------------
+// BLAKE3
+// ---------------------------------------------------------------------------
+
+inline constexpr std::size_t BLAKE3_BLOCK = 64;
+inline constexpr std::size_t BLAKE3_CHUNK = 1024;
+inline constexpr std::uint8_t BLAKE3_CHUNK_START = 1;
+inline constexpr std::uint8_t BLAKE3_CHUNK_END = 2;
+inline constexpr std::uint8_t BLAKE3_PARENT = 4;
+inline constexpr std::uint8_t BLAKE3_ROOT = 8;
+
+inline constexpr std::uint8_t BLAKE3_SCHEDULE[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13}};
+
+// The round function is written once for scalars and for vector-extension lanes
+#define SMART_BUFFER_B3_ROTR(x, r) (((x) >> (r)) | ((x) << (32 - (r))))
+#define SMART_BUFFER_B3_G(v, a, b, c, d, mx, my)                 \
+    v[a] = v[a] + v[b] + (mx);                                   \
+    v[d] = SMART_BUFFER_B3_ROTR(v[d] ^ v[a], 16);                \
+    v[c] = v[c] + v[d];                                          \
+    v[b] = SMART_BUFFER_B3_ROTR(v[b] ^ v[c], 12);                \
+    v[a] = v[a] + v[b] + (my);                                   \
+    v[d] = SMART_BUFFER_B3_ROTR(v[d] ^ v[a], 8);                 \
+    v[c] = v[c] + v[d];                                          \
+    v[b] = SMART_BUFFER_B3_ROTR(v[b] ^ v[c], 7);
+#define SMART_BUFFER_B3_ROUNDS(v, m)                                              \
+    for (int r = 0; r < 7; ++r) {                                                 \
+        const std::uint8_t* s = BLAKE3_SCHEDULE[r];                               \
+        SMART_BUFFER_B3_G(v, 0, 4, 8, 12, m[s[0]], m[s[1]])                       \
+        SMART_BUFFER_B3_G(v, 1, 5, 9, 13, m[s[2]], m[s[3]])                       \
+        SMART_BUFFER_B3_G(v, 2, 6, 10, 14, m[s[4]], m[s[5]])                      \
+        SMART_BUFFER_B3_G(v, 3, 7, 11, 15, m[s[6]], m[s[7]])                      \
+        SMART_BUFFER_B3_G(v, 0, 5, 10, 15, m[s[8]], m[s[9]])                      \
+        SMART_BUFFER_B3_G(v, 1, 6, 11, 12, m[s[10]], m[s[11]])                    \
+        SMART_BUFFER_B3_G(v, 2, 7, 8, 13, m[s[12]], m[s[13]])                     \
+        SMART_BUFFER_B3_G(v, 3, 4, 9, 14, m[s[14]], m[s[15]])                     \
+    }
+
+/**
+ * @brief BLAKE3 compression; writes the 16 output words
+ */
+inline void blake3_compress(const std::uint32_t cv[8], const std::uint8_t block[BLAKE3_BLOCK],
+                            std::uint8_t block_len, std::uint64_t counter, std::uint8_t flags,
+                            std::uint32_t out[16]) noexcept {
+    std::uint32_t m[16];
+    for (int i = 0; i < 16; ++i) {
+        m[i] = load_u32(block + 4 * i);
+    }
+    std::uint32_t v[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        SHA256_IV[0], SHA256_IV[1], SHA256_IV[2], SHA256_IV[3],
+        static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32), block_len, flags};
+    SMART_BUFFER_B3_ROUNDS(v, m)
+    for (int i = 0; i < 8; ++i) {
+        out[i] = v[i] ^ v[i + 8];
+        out[i + 8] = v[i + 8] ^ cv[i];
+    }
+}
+
+/**
+ * @brief Hash count inputs of blocks whole blocks each into 32-byte chaining values
+ * @param counter Counter of the first input; incremented per input if increment is set
+ */
+inline void blake3_hash_many_portable(const std::uint8_t* const* inputs, std::size_t count, std::size_t blocks,
+                                      const std::uint32_t key[8], std::uint64_t counter, bool increment,
+                                      std::uint8_t flags, std::uint8_t flags_start, std::uint8_t flags_end,
+                                      std::uint8_t* out) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t cv[8];
+        std::memcpy(cv, key, sizeof(cv));
+        for (std::size_t b = 0; b < blocks; ++b) {
+            std::uint8_t block_flags = flags | (b == 0 ? flags_start : 0) | (b + 1 == blocks ? flags_end : 0);
+            std::uint32_t words[16];
+            blake3_compress(cv, inputs[i] + b * BLAKE3_BLOCK, BLAKE3_BLOCK, counter, block_flags, words);
+            std::memcpy(cv, words, sizeof(cv));
+        }
+        for (int w = 0; w < 8; ++w) {
+            store_le32(out + 32 * i + 4 * w, cv[w]);
+        }
+        if (increment) {
+            ++counter;
+        }
+    }
+}
+
+#if SMART_BUFFER_X86_DISPATCH
+
+typedef std::uint32_t blake3_v8 __attribute__((vector_size(32)));
+typedef std::uint32_t blake3_v16 __attribute__((vector_size(64)));
+
+/**
+ * @brief blake3_hash_many for up to Lanes inputs, one per vector lane
+ * Lanes past active repeat the first input and their output is dropped.
+ */
+template<typename V, std::size_t Lanes>
+SMART_BUFFER_ALWAYS_INLINE void blake3_hash_lanes(const std::uint8_t* const* inputs, std::size_t active, std::size_t blocks,
+                                                  const std::uint32_t key[8], std::uint64_t counter, bool increment,
+                                                  std::uint8_t flags, std::uint8_t flags_start,
+                                                  std::uint8_t flags_end, std::uint8_t* out) noexcept {
+    const V zero = {};
+    V h[8];
+    for (int i = 0; i < 8; ++i) {
+        h[i] = zero + key[i];
+    }
+    V counter_lo = zero;
+    V counter_hi = zero;
+    for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        std::uint64_t c = counter + (increment ? lane : 0);
+        counter_lo[lane] = static_cast<std::uint32_t>(c);
+        counter_hi[lane] = static_cast<std::uint32_t>(c >> 32);
+    }
+    for (std::size_t b = 0; b < blocks; ++b) {
+        V m[16];
+        for (int w = 0; w < 16; ++w) {
+            for (std::size_t lane = 0; lane < Lanes; ++lane) {
+                m[w][lane] = load_u32(inputs[lane < active ? lane : 0] + b * BLAKE3_BLOCK + 4 * w);
+            }
+        }
+        std::uint32_t block_flags = flags | (b == 0 ? flags_start : 0) | (b + 1 == blocks ? flags_end : 0);
+        V v[16] = {h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+                   zero + SHA256_IV[0], zero + SHA256_IV[1], zero + SHA256_IV[2], zero + SHA256_IV[3],
+                   counter_lo, counter_hi, zero + static_cast<std::uint32_t>(BLAKE3_BLOCK), zero + block_flags};
+        SMART_BUFFER_B3_ROUNDS(v, m)
+        for (int i = 0; i < 8; ++i) {
+            h[i] = v[i] ^ v[i + 8];
+        }
+    }
+    for (std::size_t lane = 0; lane < active; ++lane) {
+        for (int w = 0; w < 8; ++w) {
+            store_le32(out + 32 * lane + 4 * w, h[w][lane]);
+        }
+    }
+}
+
+// A partial group still goes through the vector kernel when it fills a quarter of the
+// lanes; below that the portable function is faster
+__attribute__((target("avx2"))) SMART_BUFFER_NOINLINE
+inline std::size_t blake3_hash_many_avx2(const std::uint8_t* const* inputs, std::size_t count, std::size_t blocks,
+                                         const std::uint32_t key[8], std::uint64_t counter, bool increment,
+                                         std::uint8_t flags, std::uint8_t flags_start, std::uint8_t flags_end,
+                                         std::uint8_t* out) noexcept {
+    std::size_t i = 0;
+    for (; i < count && count - i >= 2; i += 8) {
+        blake3_hash_lanes<blake3_v8, 8>(inputs + i, std::min<std::size_t>(8, count - i), blocks, key,
+                                        counter + (increment ? i : 0), increment, flags, flags_start, flags_end,
+                                        out + 32 * i);
+    }
+    return std::min(i, count);
+}
+
+__attribute__((target("avx512f"))) SMART_BUFFER_NOINLINE
+inline std::size_t blake3_hash_many_avx512(const std::uint8_t* const* inputs, std::size_t count, std::size_t blocks,
+                                           const std::uint32_t key[8], std::uint64_t counter, bool increment,
+                                           std::uint8_t flags, std::uint8_t flags_start, std::uint8_t flags_end,
+                                           std::uint8_t* out) noexcept {
+    std::size_t i = 0;
+    for (; i < count && count - i >= 4; i += 16) {
+        blake3_hash_lanes<blake3_v16, 16>(inputs + i, std::min<std::size_t>(16, count - i), blocks, key,
+                                          counter + (increment ? i : 0), increment, flags, flags_start, flags_end,
+                                          out + 32 * i);
+    }
+    return std::min(i, count);
+}
+
+#endif
+
+#undef SMART_BUFFER_B3_ROTR
+#undef SMART_BUFFER_B3_G
+#undef SMART_BUFFER_B3_ROUNDS
+
+inline void blake3_hash_many(const std::uint8_t* const* inputs, std::size_t count, std::size_t blocks,
+                             const std::uint32_t key[8], std::uint64_t counter, bool increment,
+                             std::uint8_t flags, std::uint8_t flags_start, std::uint8_t flags_end,
+                             std::uint8_t* out) noexcept {
+    std::size_t done = 0;
+#if SMART_BUFFER_X86_DISPATCH
+    switch (smart_buffer_hash_isa()) {
+    case SmartBufferHashIsa::Avx512:
+        done = blake3_hash_many_avx512(inputs, count, blocks, key, counter, increment, flags, flags_start, flags_end, out);
+        break;
+    case SmartBufferHashIsa::Avx2:
+        done = blake3_hash_many_avx2(inputs, count, blocks, key, counter, increment, flags, flags_start, flags_end, out);
+        break;
+    case SmartBufferHashIsa::Scalar:
+        break;
+    }
+#endif
+    blake3_hash_many_portable(inputs + done, count - done, blocks, key, counter + (increment ? done : 0),
+                              increment, flags, flags_start, flags_end, out + 32 * done);
+}
+
+// Chunks hashed per batch; their chaining values are reduced on the stack
+inline constexpr std::size_t BLAKE3_BATCH_CHUNKS = 64;
+// Smallest subtree handed to a thread of its own (256 KiB)
+inline constexpr std::size_t BLAKE3_THREAD_CHUNKS = 256;
+
+inline void blake3_parent_cv(const std::uint8_t left_right[64], const std::uint32_t key[8], std::uint8_t out[32]) noexcept {
+    blake3_hash_many(&left_right, 1, 1, key, 0, false, BLAKE3_PARENT, 0, 0, out);
+}
+
+inline void blake3_subtree_cv(const std::uint8_t* input, std::size_t chunks, std::uint64_t counter,
+                              const std::uint32_t key[8], unsigned threads, std::uint8_t out[32]);
+
+/**
+ * @brief Chaining values of the two children of a perfect subtree of chunks whole
+ *        chunks (a power of two, at least 2), written to out[0..64)
+ */
+inline void blake3_subtree_children(const std::uint8_t* input, std::size_t chunks, std::uint64_t counter,
+                                    const std::uint32_t key[8], unsigned threads, std::uint8_t out[64]) {
+    std::size_t half = chunks / 2;
+    if (chunks <= BLAKE3_BATCH_CHUNKS) {
+        const std::uint8_t* inputs[BLAKE3_BATCH_CHUNKS] = {};
+        std::uint8_t cvs[BLAKE3_BATCH_CHUNKS * 32];
+        for (std::size_t i = 0; i < chunks; ++i) {
+            inputs[i] = input + i * BLAKE3_CHUNK;
+        }
+        blake3_hash_many(inputs, chunks, BLAKE3_CHUNK / BLAKE3_BLOCK, key, counter, true, 0,
+                         BLAKE3_CHUNK_START, BLAKE3_CHUNK_END, cvs);
+        // Each parent's block is two adjacent chaining values, so a level is hashed in
+        // place as a batch of 64-byte inputs
+        for (std::size_t n = chunks; n > 2; n /= 2) {
+            for (std::size_t i = 0; i < n / 2; ++i) {
+                inputs[i] = cvs + 64 * i;
+            }
+            blake3_hash_many(inputs, n / 2, 1, key, 0, false, BLAKE3_PARENT, 0, 0, cvs);
+        }
+        std::memcpy(out, cvs, 64);
+    } else if (threads > 1 && half >= BLAKE3_THREAD_CHUNKS) {
+        unsigned left_threads = threads / 2;
+        std::thread left([&] { blake3_subtree_cv(input, half, counter, key, left_threads, out); });
+        blake3_subtree_cv(input + half * BLAKE3_CHUNK, half, counter + half, key, threads - left_threads, out + 32);
+        left.join();
+    } else {
+        blake3_subtree_cv(input, half, counter, key, 1, out);
+        blake3_subtree_cv(input + half * BLAKE3_CHUNK, half, counter + half, key, 1, out + 32);
+    }
+}
+
+/**
+ * @brief Chaining value of a perfect subtree of chunks whole chunks (a power of two)
+ */
+inline void blake3_subtree_cv(const std::uint8_t* input, std::size_t chunks, std::uint64_t counter,
+                              const std::uint32_t key[8], unsigned threads, std::uint8_t out[32]) {
+    if (chunks == 1) {
+        blake3_hash_many(&input, 1, BLAKE3_CHUNK / BLAKE3_BLOCK, key, counter, true, 0,
+                         BLAKE3_CHUNK_START, BLAKE3_CHUNK_END, out);
+        return;
+    }
+    std::uint8_t children[64];
+    blake3_subtree_children(input, chunks, counter, key, threads, children);
+    blake3_parent_cv(children, key, out);
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief Whether SHA-256 runs on the CPU's SHA extensions
+ */
+inline bool smart_buffer_sha256_accelerated() noexcept {
+    return smart_buffer_detail::has_sha_extensions();
+}
+
+/**
+ * @brief Incremental SHA-256 with the digest returned as a SmartBuffer<32>
+ *
+ * Uses the SHA extensions (SHA-NI) when the CPU has them and a portable block function
+ * otherwise.
+ */
+class SmartBufferSha256 {
+public:
+    SmartBufferSha256() noexcept {
+        reset();
+    }
+
+    void reset() noexcept {
+        std::memcpy(state_, smart_buffer_detail::SHA256_IV, sizeof(state_));
+        buffered_ = 0;
+        length_ = 0;
+    }
+
+    SmartBufferSha256& update(const void* data, std::size_t size) noexcept {
+        auto* p = static_cast<const std::uint8_t*>(data);
+        length_ += size;
+        if (buffered_ > 0) {
+            std::size_t take = std::min(size, sizeof(block_) - buffered_);
+            std::memcpy(block_ + buffered_, p, take);
+            buffered_ += take;
+            p += take;
+            size -= take;
+            if (buffered_ < sizeof(block_)) {
+                return *this;
+            }
+            smart_buffer_detail::sha256_compress(state_, block_, 1);
+            buffered_ = 0;
+        }
+        std::size_t blocks = size / 64;
+        if (blocks > 0) {
+            smart_buffer_detail::sha256_compress(state_, p, blocks);
+            p += blocks * 64;
+            size -= blocks * 64;
+        }
+        std::memcpy(block_, p, size);
+        buffered_ = size;
+        return *this;
+    }
+
+    template<std::size_t Size, std::size_t StaticThreshold>
+    SmartBufferSha256& update(const SmartBuffer<Size, StaticThreshold>& buffer) noexcept {
+        return update(buffer.data(), Size);
+    }
+
+    SmartBufferSha256& update(SmartBufferConstSegment segment) noexcept {
+        return update(segment.data, segment.size);
+    }
+
+    /**
+     * @brief Get the digest of everything passed to update() since the last reset
+     */
+    SmartBuffer<32> finalize() const noexcept {
+        SmartBufferSha256 tail = *this;
+        std::uint64_t bits = length_ * 8;
+        std::uint8_t padding[72] = {0x80};
+        std::size_t pad = (buffered_ < 56 ? 56 : 120) - buffered_;
+        for (int i = 0; i < 8; ++i) {
+            padding[pad + i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+        }
+        tail.update(padding, pad + 8);
+        SmartBuffer<32> digest;
+        for (int i = 0; i < 8; ++i) {
+            smart_buffer_detail::store_be32(digest.data() + 4 * i, tail.state_[i]);
+        }
+        return digest;
+    }
+
+private:
+    std::uint32_t state_[8];
+    std::uint8_t block_[64];
+    std::size_t buffered_;
+    std::uint64_t length_;
+};
+
+/**
+ * @brief Incremental BLAKE3 (unkeyed, 32-byte output) with the digest returned as a
+ *        SmartBuffer<32>
+ *
+ * Runs of whole chunks are hashed as perfect subtrees: 16 (AVX-512) or 8 (AVX2) chunks
+ * at a time in SIMD lanes, and with threads > 1, subtrees of at least 512 KiB are split
+ * across threads. The digest does not depend on how the input is split between
+ * update() calls or on the thread count.
+ */
+class SmartBufferBlake3 {
+public:
+    /**
+     * @param threads Maximum threads used by update() for large inputs
+     */
+    explicit SmartBufferBlake3(unsigned threads = 1) noexcept : threads_(threads > 0 ? threads : 1) {
+        reset();
+    }
+
+    void reset() noexcept {
+        chunk_counter_ = 0;
+        chunk_length_ = 0;
+        stack_size_ = 0;
+        start_chunk();
+    }
+
+    SmartBufferBlake3& update(const void* data, std::size_t size) {
+        using namespace smart_buffer_detail;
+        auto* p = static_cast<const std::uint8_t*>(data);
+        if (chunk_length_ > 0) {
+            std::size_t take = std::min(size, BLAKE3_CHUNK - chunk_length_);
+            chunk_update(p, take);
+            p += take;
+            size -= take;
+            if (size == 0) {
+                return *this;
+            }
+            // The chunk is complete and more input follows, so it is not the root
+            std::uint8_t cv[32];
+            chunk_chaining_value(cv);
+            push_cv(cv, chunk_counter_);
+            ++chunk_counter_;
+            start_chunk();
+        }
+        while (size > BLAKE3_CHUNK) {
+            // Largest power-of-two run of whole chunks aligned to the counter
+            std::size_t chunks = std::size_t(1) << (63 - __builtin_clzll(size / BLAKE3_CHUNK));
+            while ((chunk_counter_ & (chunks - 1)) != 0) {
+                chunks /= 2;
+            }
+            if (chunks == 1) {
+                chunk_update(p, BLAKE3_CHUNK);
+                std::uint8_t cv[32];
+                chunk_chaining_value(cv);
+                push_cv(cv, chunk_counter_);
+                start_chunk();
+            } else {
+                // Push both children: if the input ends here, their parent is the root
+                std::uint8_t children[64];
+                blake3_subtree_children(p, chunks, chunk_counter_, SHA256_IV, threads_, children);
+                push_cv(children, chunk_counter_);
+                push_cv(children + 32, chunk_counter_ + chunks / 2);
+            }
+            chunk_counter_ += chunks;
+            p += chunks * BLAKE3_CHUNK;
+            size -= chunks * BLAKE3_CHUNK;
+        }
+        if (size > 0) {
+            chunk_update(p, size);
+            merge_stack(chunk_counter_);
+        }
+        return *this;
+    }
+
+    template<std::size_t Size, std::size_t StaticThreshold>
+    SmartBufferBlake3& update(const SmartBuffer<Size, StaticThreshold>& buffer) {
+        return update(buffer.data(), Size);
+    }
+
+    SmartBufferBlake3& update(SmartBufferConstSegment segment) {
+        return update(segment.data, segment.size);
+    }
+
+    /**
+     * @brief Get the digest of everything passed to update() since the last reset
+     */
+    SmartBuffer<32> finalize() const noexcept {
+        using namespace smart_buffer_detail;
+        Output output = chunk_output();
+        std::size_t remaining = stack_size_;
+        if (chunk_length_ == 0 && remaining >= 2) {
+            // The input ended on a subtree boundary: the root joins the top two entries
+            output = parent_output(stack_[remaining - 2], stack_[remaining - 1]);
+            remaining -= 2;
+        }
+        while (remaining > 0) {
+            std::uint8_t cv[32];
+            output.chaining_value(cv);
+            output = parent_output(stack_[remaining - 1], cv);
+            --remaining;
+        }
+        std::uint32_t words[16];
+        blake3_compress(output.cv, output.block, output.block_len, output.counter,
+                        static_cast<std::uint8_t>(output.flags | BLAKE3_ROOT), words);
+        SmartBuffer<32> digest;
+        for (int i = 0; i < 8; ++i) {
+            store_le32(digest.data() + 4 * i, words[i]);
+        }
+        return digest;
+    }
+
+private:
+    // A compression whose flags are not final yet (it may become the root)
+    struct Output {
+        std::uint32_t cv[8];
+        std::uint8_t block[64];
+        std::uint8_t block_len;
+        std::uint64_t counter;
+        std::uint8_t flags;
+
+        void chaining_value(std::uint8_t out[32]) const noexcept {
+            std::uint32_t words[16];
+            smart_buffer_detail::blake3_compress(cv, block, block_len, counter, flags, words);
+            for (int i = 0; i < 8; ++i) {
+                smart_buffer_detail::store_le32(out + 4 * i, words[i]);
+            }
+        }
+    };
+
+    static Output parent_output(const std::uint8_t left[32], const std::uint8_t right[32]) noexcept {
+        Output output;
+        std::memcpy(output.cv, smart_buffer_detail::SHA256_IV, sizeof(output.cv));
+        std::memcpy(output.block, left, 32);
+        std::memcpy(output.block + 32, right, 32);
+        output.block_len = 64;
+        output.counter = 0;
+        output.flags = smart_buffer_detail::BLAKE3_PARENT;
+        return output;
+    }
+
+    void start_chunk() noexcept {
+        std::memcpy(chunk_cv_, smart_buffer_detail::SHA256_IV, sizeof(chunk_cv_));
+        chunk_length_ = 0;
+        block_length_ = 0;
+        blocks_compressed_ = 0;
+    }
+
+    void chunk_update(const std::uint8_t* p, std::size_t size) noexcept {
+        using namespace smart_buffer_detail;
+        chunk_length_ += size;
+        while (size > 0) {
+            if (block_length_ == BLAKE3_BLOCK) {
+                // Only compressed once more input follows: the last block ends the chunk
+                std::uint32_t words[16];
+                blake3_compress(chunk_cv_, block_, BLAKE3_BLOCK, chunk_counter_, block_flags(), words);
+                std::memcpy(chunk_cv_, words, sizeof(chunk_cv_));
+                ++blocks_compressed_;
+                block_length_ = 0;
+            }
+            std::size_t take = std::min(size, BLAKE3_BLOCK - block_length_);
+            std::memcpy(block_ + block_length_, p, take);
+            block_length_ += take;
+            p += take;
+            size -= take;
+        }
+    }
+
+    std::uint8_t block_flags() const noexcept {
+        return blocks_compressed_ == 0 ? smart_buffer_detail::BLAKE3_CHUNK_START : 0;
+    }
+
+    Output chunk_output() const noexcept {
+        Output output;
+        std::memcpy(output.cv, chunk_cv_, sizeof(output.cv));
+        std::memset(output.block, 0, sizeof(output.block));
+        std::memcpy(output.block, block_, block_length_);
+        output.block_len = static_cast<std::uint8_t>(block_length_);
+        output.counter = chunk_counter_;
+        output.flags = static_cast<std::uint8_t>(block_flags() | smart_buffer_detail::BLAKE3_CHUNK_END);
+        return output;
+    }
+
+    void chunk_chaining_value(std::uint8_t out[32]) const noexcept {
+        chunk_output().chaining_value(out);
+    }
+
+    // Keep one stack entry per set bit of the chunk count, merging completed subtrees;
+    // the newest entry is merged lazily because it might be the root's child
+    void merge_stack(std::uint64_t total_chunks) noexcept {
+        auto target = static_cast<std::size_t>(__builtin_popcountll(total_chunks));
+        while (stack_size_ > target) {
+            std::uint8_t cv[32];
+            parent_output(stack_[stack_size_ - 2], stack_[stack_size_ - 1]).chaining_value(cv);
+            stack_size_ -= 2;
+            std::memcpy(stack_[stack_size_++], cv, 32);
+        }
+    }
+
+    void push_cv(const std::uint8_t cv[32], std::uint64_t chunk_counter) noexcept {
+        merge_stack(chunk_counter);
+        std::memcpy(stack_[stack_size_++], cv, 32);
+    }
+
+    unsigned threads_;
+    std::uint32_t chunk_cv_[8];
+    std::uint8_t block_[64];
+    std::size_t block_length_;
+    std::size_t blocks_compressed_;
+    std::size_t chunk_length_;
+    std::uint64_t chunk_counter_;
+    std::uint8_t stack_[54][32];   // Enough for 2^64 bytes
+    std::size_t stack_size_;
+};
+
+/**
+ * @brief SHA-256 of a byte range
+ */
+inline SmartBuffer<32> smart_buffer_sha256(const void* data, std::size_t size) noexcept {
+    return SmartBufferSha256().update(data, size).finalize();
+}
+
+template<std::size_t Size, std::size_t StaticThreshold>
+inline SmartBuffer<32> smart_buffer_sha256(const SmartBuffer<Size, StaticThreshold>& buffer) noexcept {
+    return smart_buffer_sha256(buffer.data(), Size);
+}
+
+/**
+ * @brief SHA-256 of the concatenation of count segments
+ */
+inline SmartBuffer<32> smart_buffer_sha256(const SmartBufferConstSegment* segments, std::size_t count) noexcept {
+    SmartBufferSha256 hasher;
+    for (std::size_t i = 0; i < count; ++i) {
+        hasher.update(segments[i]);
+    }
+    return hasher.finalize();
+}
+
+/**
+ * @brief BLAKE3 of a byte range, using up to threads threads for large inputs
+ */
+inline SmartBuffer<32> smart_buffer_blake3(const void* data, std::size_t size, unsigned threads = 1) {
+    return SmartBufferBlake3(threads).update(data, size).finalize();
+}
+
+template<std::size_t Size, std::size_t StaticThreshold>
+inline SmartBuffer<32> smart_buffer_blake3(const SmartBuffer<Size, StaticThreshold>& buffer, unsigned threads = 1) {
+    return smart_buffer_blake3(buffer.data(), Size, threads);
+}
+
+/**
+ * @brief BLAKE3 of the concatenation of count segments
+ */
+inline SmartBuffer<32> smart_buffer_blake3(const SmartBufferConstSegment* segments, std::size_t count,
+                                           unsigned threads = 1) {
+    SmartBufferBlake3 hasher(threads);
+    for (std::size_t i = 0; i < count; ++i) {
+        hasher.update(segments[i]);
+    }
+    return hasher.finalize();
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace smart_buffer_detail {
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief Disruptor wait strategy: spin on the CPU (lowest latency, burns a core per waiter)
+ */
+struct SmartBufferBusySpinWait {
+    template<typename Ready>
+    void wait(Ready&& ready) noexcept {
+        while (!ready()) {
+            smart_buffer_detail::cpu_relax();
+        }
+    }
+
+    void notify() noexcept {}
+};
+
+/**
+ * @brief Disruptor wait strategy: spin briefly, then yield the CPU between checks
+ */
+struct SmartBufferYieldWait {
+    static constexpr int SPIN_COUNT = 100;
+
+    template<typename Ready>
+    void wait(Ready&& ready) noexcept {
+        for (int spin = 0; !ready(); ++spin) {
+            if (spin < SPIN_COUNT) {
+                smart_buffer_detail::cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void notify() noexcept {}
+};
+
+/**
+ * @brief Disruptor wait strategy: spin briefly, then sleep in the kernel until notified
+ *
+ * Uses a futex on Linux, so notify() costs one atomic increment unless a waiter is
+ * asleep. Elsewhere it falls back to yielding.
+ */
+struct SmartBufferFutexWait {
+    static constexpr int SPIN_COUNT = 100;
+
+    template<typename Ready>
+    void wait(Ready&& ready) noexcept {
+        for (int spin = 0; spin < SPIN_COUNT; ++spin) {
+            if (ready()) {
+                return;
+            }
+            smart_buffer_detail::cpu_relax();
+        }
+        while (true) {
+            std::uint32_t seen = signal_.load(std::memory_order_seq_cst);
+            if (ready()) {
+                return;
+            }
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            if (!ready()) {
+#if defined(__linux__)
+                // Returns at once if signal_ moved since it was read
+                ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&signal_), FUTEX_WAIT_PRIVATE,
+                          seen, nullptr, nullptr, 0);
+#else
+                (void)seen;
+                std::this_thread::yield();
+#endif
+            }
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void notify() noexcept {
+        signal_.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) != 0) {
+#if defined(__linux__)
+            ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&signal_), FUTEX_WAKE_PRIVATE,
+                      INT_MAX, nullptr, nullptr, 0);
+#endif
+        }
+    }
+
+private:
+    std::atomic<std::uint32_t> signal_{0};
+    std::atomic<std::uint32_t> waiters_{0};
+};
+
+/**
+ * @brief A ring of preallocated SmartBuffer events handed through a pipeline of
+ *        consumer stages by sequence number (LMAX Disruptor pattern).
+ *
+ * @tparam Size Event size in bytes; every slot is a SmartBuffer<Size> allocated once
+ * @tparam Wait Wait strategy: SmartBufferBusySpinWait, SmartBufferYieldWait or SmartBufferFutexWait
+ *
+ * Producers claim a batch of sequences, write the events in place and publish the
+ * batch. Each consumer stage tracks the last sequence it finished with; it may depend on
+ * other stages, in which case it only sees events they have finished with. The
+ * producers gate on every stage, so a slot is reused only once the whole pipeline is
+ * done with it. Nothing is allocated, copied or moved after construction.
+ *
+ * Any number of producer threads may claim and publish. Each stage must be driven by
+ * one thread. Stages must be added before the first claim.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t Size, typename Wait = SmartBufferYieldWait>
+class SmartBufferDisruptor {
+public:
+    using Event = SmartBuffer<Size>;
+    using Sequence = std::int64_t;
+
+    /**
+     * @brief A consumer stage: the last sequence it finished and the stages it follows
+     */
+    class Stage {
+    public:
+        /**
+         * @brief Get the last sequence this stage finished with (-1 before the first)
+         */
+        Sequence sequence() const noexcept { return sequence_.load(std::memory_order_acquire); }
+
+    private:
+        friend class SmartBufferDisruptor;
+
+        alignas(64) std::atomic<Sequence> sequence_{-1};
+        std::vector<const Stage*> dependencies_;
+        Sequence cached_available_ = -1;   // Owner thread only
+    };
+
+    /**
+     * @brief Construct a ring
+     * @param capacity Number of event slots, a power of two
+     */
+    explicit SmartBufferDisruptor(std::size_t capacity)
+        : mask_(capacity - 1), events_(capacity), published_(new std::atomic<Sequence>[capacity]) {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("SmartBufferDisruptor: capacity must be a power of two");
+        }
+        for (std::size_t i = 0; i < capacity; ++i) {
+            published_[i].store(-1, std::memory_order_relaxed);
+        }
+    }
+
+    SmartBufferDisruptor(const SmartBufferDisruptor&) = delete;
+    SmartBufferDisruptor& operator=(const SmartBufferDisruptor&) = delete;
+
+    /**
+     * @brief Add a consumer stage
+     * @param after Stages whose finished events this stage consumes; empty for the
+     *              stages that consume published events directly
+     */
+    Stage& add_stage(std::initializer_list<const Stage*> after = {}) {
+        Stage& stage = stages_.emplace_back();
+        stage.dependencies_.assign(after.begin(), after.end());
+        gating_.push_back(&stage);
+        return stage;
+    }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    /**
+     * @brief Claim count consecutive sequences, waiting for free slots
+     * @return The first claimed sequence
+     * @throws std::invalid_argument if count is 0 or larger than capacity(); such a
+     *         batch could never fit in the ring
+     */
+    Sequence claim(std::size_t count = 1) {
+        if (count == 0 || count > capacity()) {
+            throw std::invalid_argument("SmartBufferDisruptor: claim count must be between 1 and capacity");
+        }
+        auto batch = static_cast<Sequence>(count);
+        Sequence first = claimed_.fetch_add(batch, std::memory_order_relaxed);
+        Sequence wrap = first + batch - 1 - static_cast<Sequence>(capacity());
+        if (wrap > gating_cache_.load(std::memory_order_relaxed)) {
+            wait_.wait([&] {
+                Sequence slowest = slowest_stage();
+                gating_cache_.store(slowest, std::memory_order_relaxed);
+                return wrap <= slowest;
+            });
+        }
+        return first;
+    }
+
+    /**
+     * @brief Get the event slot of a sequence
+     */
+    Event& operator[](Sequence sequence) noexcept {
+        return events_[static_cast<std::size_t>(sequence) & mask_];
+    }
+
+    const Event& operator[](Sequence sequence) const noexcept {
+        return events_[static_cast<std::size_t>(sequence) & mask_];
+    }
+
+    /**
+     * @brief Publish count claimed sequences starting at first
+     */
+    void publish(Sequence first, std::size_t count = 1) noexcept {
+        for (Sequence sequence = first; sequence < first + static_cast<Sequence>(count); ++sequence) {
+            published_[static_cast<std::size_t>(sequence) & mask_].store(sequence, std::memory_order_release);
+        }
+        wait_.notify();
+    }
+
+    /**
+     * @brief Wait until the stage has at least one event to process
+     * @return The last sequence the stage may process (the batch ends there)
+     */
+    Sequence wait_for(Stage& stage) {
+        Sequence next = stage.sequence_.load(std::memory_order_relaxed) + 1;
+        if (stage.cached_available_ < next) {
+            wait_.wait([&] {
+                stage.cached_available_ = available(stage, next);
+                return stage.cached_available_ >= next;
+            });
+        }
+        return stage.cached_available_;
+    }
+
+    /**
+     * @brief Mark every sequence up to and including sequence as finished by the stage
+     */
+    void release(Stage& stage, Sequence sequence) noexcept {
+        stage.sequence_.store(sequence, std::memory_order_release);
+        wait_.notify();
+    }
+
+    /**
+     * @brief Process the next batch of events for a stage, waiting if there is none
+     * @param fn Called as fn(Event&, Sequence, bool end_of_batch) for each event
+     * @return The number of events processed
+     */
+    template<typename Fn>
+    std::size_t consume(Stage& stage, Fn&& fn) {
+        Sequence next = stage.sequence_.load(std::memory_order_relaxed) + 1;
+        Sequence last = wait_for(stage);
+        for (Sequence sequence = next; sequence <= last; ++sequence) {
+            fn((*this)[sequence], sequence, sequence == last);
+        }
+        release(stage, last);
+        return static_cast<std::size_t>(last - next + 1);
+    }
+
+private:
+    // Highest sequence from next on that the stage may process, or next - 1 if none
+    Sequence available(const Stage& stage, Sequence next) const noexcept {
+        if (!stage.dependencies_.empty()) {
+            Sequence limit = SmartBufferDisruptor::max_sequence();
+            for (const Stage* dependency : stage.dependencies_) {
+                limit = std::min(limit, dependency->sequence_.load(std::memory_order_acquire));
+            }
+            return limit;
+        }
+        // Producers publish out of order; stop at the first gap
+        Sequence sequence = next;
+        Sequence end = next + static_cast<Sequence>(capacity());
+        while (sequence < end
+               && published_[static_cast<std::size_t>(sequence) & mask_].load(std::memory_order_acquire) == sequence) {
+            ++sequence;
+        }
+        return sequence - 1;
+    }
+
+    Sequence slowest_stage() const noexcept {
+        Sequence slowest = max_sequence();
+        for (const Stage* stage : gating_) {
+            slowest = std::min(slowest, stage->sequence_.load(std::memory_order_acquire));
+        }
+        return slowest;
+    }
+
+    static constexpr Sequence max_sequence() noexcept { return INT64_MAX; }
+
+    std::size_t mask_;
+    std::vector<Event> events_;
+    std::unique_ptr<std::atomic<Sequence>[]> published_;   // Sequence last published in each slot
+    std::deque<Stage> stages_;                              // Deque: stages never move
+    std::vector<const Stage*> gating_;
+    alignas(64) std::atomic<Sequence> claimed_{0};
+    alignas(64) std::atomic<Sequence> gating_cache_{-1};
+    alignas(64) Wait wait_;
+};
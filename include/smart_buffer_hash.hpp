@@ -0,0 +1,185 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Forces inlining so size-specialized kernels collapse to straight-line code.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#  define SMART_BUFFER_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#  define SMART_BUFFER_ALWAYS_INLINE __forceinline
+#else
+#  define SMART_BUFFER_ALWAYS_INLINE inline
+#endif
+
+namespace smart_buffer_detail {
+
+inline constexpr std::uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+inline constexpr std::uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+inline constexpr std::uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+inline constexpr std::uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+inline constexpr std::uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+SMART_BUFFER_ALWAYS_INLINE std::uint64_t load_u64(const std::uint8_t* p) noexcept {
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+SMART_BUFFER_ALWAYS_INLINE std::uint32_t load_u32(const std::uint8_t* p) noexcept {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+SMART_BUFFER_ALWAYS_INLINE constexpr std::uint64_t rotl64(std::uint64_t x, int r) noexcept {
+    return (x << r) | (x >> (64 - r));
+}
+
+SMART_BUFFER_ALWAYS_INLINE constexpr std::uint64_t xxh64_round(std::uint64_t acc, std::uint64_t input) noexcept {
+    acc += input * XXH_PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * XXH_PRIME64_1;
+}
+
+SMART_BUFFER_ALWAYS_INLINE constexpr std::uint64_t xxh64_merge_round(std::uint64_t acc, std::uint64_t val) noexcept {
+    acc ^= xxh64_round(0, val);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+SMART_BUFFER_ALWAYS_INLINE constexpr std::uint64_t xxh64_avalanche(std::uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= XXH_PRIME64_2;
+    h ^= h >> 29;
+    h *= XXH_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+/**
+ * @brief Hash the bytes left over after the 32-byte stripes and finish the digest
+ */
+SMART_BUFFER_ALWAYS_INLINE std::uint64_t xxh64_finalize(std::uint64_t h, const std::uint8_t* p,
+                                                       std::size_t remaining) noexcept {
+    while (remaining >= 8) {
+        h ^= xxh64_round(0, load_u64(p));
+        h = rotl64(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        p += 8;
+        remaining -= 8;
+    }
+    if (remaining >= 4) {
+        h ^= static_cast<std::uint64_t>(load_u32(p)) * XXH_PRIME64_1;
+        h = rotl64(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        p += 4;
+        remaining -= 4;
+    }
+    while (remaining > 0) {
+        h ^= static_cast<std::uint64_t>(*p) * XXH_PRIME64_5;
+        h = rotl64(h, 11) * XXH_PRIME64_1;
+        ++p;
+        --remaining;
+    }
+    return xxh64_avalanche(h);
+}
+
+/**
+ * @brief XXH64 of size bytes. When size is a compile-time constant at the call site
+ *        the loops are fully specialized after inlining.
+ */
+SMART_BUFFER_ALWAYS_INLINE std::uint64_t xxh64(const std::uint8_t* data, std::size_t size,
+                                              std::uint64_t seed) noexcept {
+    const std::uint8_t* p = data;
+    std::uint64_t h;
+    if (size >= 32) {
+        std::uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        std::uint64_t v2 = seed + XXH_PRIME64_2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - XXH_PRIME64_1;
+        const std::uint8_t* const limit = data + size - 32;
+        do {
+            v1 = xxh64_round(v1, load_u64(p));
+            v2 = xxh64_round(v2, load_u64(p + 8));
+            v3 = xxh64_round(v3, load_u64(p + 16));
+            v4 = xxh64_round(v4, load_u64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxh64_merge_round(h, v1);
+        h = xxh64_merge_round(h, v2);
+        h = xxh64_merge_round(h, v3);
+        h = xxh64_merge_round(h, v4);
+    } else {
+        h = seed + XXH_PRIME64_5;
+    }
+    h += static_cast<std::uint64_t>(size);
+    return xxh64_finalize(h, p, size - static_cast<std::size_t>(p - data));
+}
+
+/**
+ * @brief Compare two blocks of Bytes bytes word by word without early exit
+ */
+template<std::size_t Bytes>
+SMART_BUFFER_ALWAYS_INLINE bool equal_fixed(const std::uint8_t* a, const std::uint8_t* b) noexcept {
+    std::uint64_t diff = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= Bytes; i += 8) {
+        diff |= load_u64(a + i) ^ load_u64(b + i);
+    }
+    for (; i < Bytes; ++i) {
+        diff |= static_cast<std::uint64_t>(a[i] ^ b[i]);
+    }
+    return diff == 0;
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief XXH64 of a runtime-length byte range
+ */
+inline std::uint64_t smart_buffer_hash_bytes(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept {
+    return smart_buffer_detail::xxh64(static_cast<const std::uint8_t*>(data), size, seed);
+}
+
+/**
+ * @brief XXH64 of the requested bytes of a SmartBuffer, specialized on its size
+ */
+template<std::size_t Size, std::size_t StaticThreshold>
+inline std::uint64_t smart_buffer_hash(const SmartBuffer<Size, StaticThreshold>& buffer,
+                                       std::uint64_t seed = 0) noexcept {
+    return smart_buffer_detail::xxh64(buffer.data(), Size, seed);
+}
+
+/**
+ * @brief Compare the requested bytes of two equally sized SmartBuffers word by word
+ */
+template<std::size_t Size, std::size_t StaticThreshold>
+inline bool smart_buffer_equal(const SmartBuffer<Size, StaticThreshold>& a,
+                               const SmartBuffer<Size, StaticThreshold>& b) noexcept {
+    return smart_buffer_detail::equal_fixed<Size>(a.data(), b.data());
+}
+
+/**
+ * @brief Hash functor for SmartBuffer keys in hash containers
+ */
+struct SmartBufferHash {
+    template<std::size_t Size, std::size_t StaticThreshold>
+    std::size_t operator()(const SmartBuffer<Size, StaticThreshold>& buffer) const noexcept {
+        return static_cast<std::size_t>(smart_buffer_hash(buffer));
+    }
+};
+
+/**
+ * @brief Equality functor for SmartBuffer keys in hash containers
+ */
+struct SmartBufferEqual {
+    template<std::size_t Size, std::size_t StaticThreshold>
+    bool operator()(const SmartBuffer<Size, StaticThreshold>& a,
+                    const SmartBuffer<Size, StaticThreshold>& b) const noexcept {
+        return smart_buffer_equal(a, b);
+    }
+};
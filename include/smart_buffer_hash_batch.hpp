@@ -0,0 +1,363 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_hash.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// x86-64 only: the kernels use 64-bit intrinsics (_mm_crc32_u64, _mm_cvtsi128_si64)
+// that 32-bit x86 lacks, so i386 builds take the portable paths
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SMART_BUFFER_X86_DISPATCH 1
+#else
+#define SMART_BUFFER_X86_DISPATCH 0
+#endif
+
+/**
+ * @brief Instruction sets used by the batch hashing kernels, picked once at run time
+ */
+enum class SmartBufferHashIsa {
+    Scalar,    // One hash at a time
+    Avx2,      // XXH64: 4 lanes, 64-bit multiply emulated
+    Avx512,    // XXH64: 2 x 8 lanes with native 64-bit multiply
+};
+
+namespace smart_buffer_detail {
+
+#if SMART_BUFFER_X86_DISPATCH
+
+// Lanes of 64-bit words; GCC and Clang lower the operators to the instruction set of
+// the function they are inlined into
+typedef std::uint64_t xxh64_v4 __attribute__((vector_size(32)));
+typedef std::uint64_t xxh64_v16 __attribute__((vector_size(128)));
+
+// Macros rather than helper functions: the kernel must inline into the target-specific
+// callers below, and functions taking these vectors by value change ABI with the ISA
+#define SMART_BUFFER_XXH_ROTL(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+#define SMART_BUFFER_XXH_ROUND(acc, input) \
+    (SMART_BUFFER_XXH_ROTL((acc) + (input) * XXH_PRIME64_2, 31) * XXH_PRIME64_1)
+#define SMART_BUFFER_XXH_LOAD(x, type, load, offset)                      \
+    for (std::size_t lane = 0; lane < Lanes; ++lane) {                    \
+        (x)[lane] = static_cast<std::uint64_t>(load(data[lane] + (offset))); \
+    }
+
+/**
+ * @brief XXH64 of Size bytes for every lane of V at once, bit-identical to xxh64()
+ * @param data One pointer per lane
+ */
+template<std::size_t Size, typename V, std::size_t Lanes>
+SMART_BUFFER_ALWAYS_INLINE void xxh64_lanes(const std::uint8_t* const* data, std::uint64_t* out,
+                                            std::uint64_t seed) noexcept {
+    const V zero = {};
+    V x = zero;
+    V h;
+    std::size_t offset = 0;
+    if constexpr (Size >= 32) {
+        V v1 = zero + (seed + XXH_PRIME64_1 + XXH_PRIME64_2);
+        V v2 = zero + (seed + XXH_PRIME64_2);
+        V v3 = zero + seed;
+        V v4 = zero + (seed - XXH_PRIME64_1);
+        for (; offset + 32 <= Size; offset += 32) {
+            SMART_BUFFER_XXH_LOAD(x, std::uint64_t, load_u64, offset)
+            v1 = SMART_BUFFER_XXH_ROUND(v1, x);
+            SMART_BUFFER_XXH_LOAD(x, std::uint64_t, load_u64, offset + 8)
+            v2 = SMART_BUFFER_XXH_ROUND(v2, x);
+            SMART_BUFFER_XXH_LOAD(x, std::uint64_t, load_u64, offset + 16)
+            v3 = SMART_BUFFER_XXH_ROUND(v3, x);
+            SMART_BUFFER_XXH_LOAD(x, std::uint64_t, load_u64, offset + 24)
+            v4 = SMART_BUFFER_XXH_ROUND(v4, x);
+        }
+        h = SMART_BUFFER_XXH_ROTL(v1, 1) + SMART_BUFFER_XXH_ROTL(v2, 7)
+          + SMART_BUFFER_XXH_ROTL(v3, 12) + SMART_BUFFER_XXH_ROTL(v4, 18);
+        h ^= SMART_BUFFER_XXH_ROUND(zero, v1);
+        h = h * XXH_PRIME64_1 + XXH_PRIME64_4;
+        h ^= SMART_BUFFER_XXH_ROUND(zero, v2);
+        h = h * XXH_PRIME64_1 + XXH_PRIME64_4;
+        h ^= SMART_BUFFER_XXH_ROUND(zero, v3);
+        h = h * XXH_PRIME64_1 + XXH_PRIME64_4;
+        h ^= SMART_BUFFER_XXH_ROUND(zero, v4);
+        h = h * XXH_PRIME64_1 + XXH_PRIME64_4;
+    } else {
+        h = zero + (seed + XXH_PRIME64_5);
+    }
+    h += Size;
+    for (; offset + 8 <= Size; offset += 8) {
+        SMART_BUFFER_XXH_LOAD(x, std::uint64_t, load_u64, offset)
+        h ^= SMART_BUFFER_XXH_ROUND(zero, x);
+        h = SMART_BUFFER_XXH_ROTL(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+    if constexpr (Size % 8 >= 4) {
+        SMART_BUFFER_XXH_LOAD(x, std::uint32_t, load_u32, offset)
+        h ^= x * XXH_PRIME64_1;
+        h = SMART_BUFFER_XXH_ROTL(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        offset += 4;
+    }
+    for (; offset < Size; ++offset) {
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            x[lane] = data[lane][offset];
+        }
+        h ^= x * XXH_PRIME64_5;
+        h = SMART_BUFFER_XXH_ROTL(h, 11) * XXH_PRIME64_1;
+    }
+    h ^= h >> 33;
+    h *= XXH_PRIME64_2;
+    h ^= h >> 29;
+    h *= XXH_PRIME64_3;
+    h ^= h >> 32;
+    for (std::size_t lane = 0; lane < Lanes; ++lane) {
+        out[lane] = h[lane];
+    }
+}
+
+#undef SMART_BUFFER_XXH_ROTL
+#undef SMART_BUFFER_XXH_ROUND
+#undef SMART_BUFFER_XXH_LOAD
+
+template<std::size_t Size>
+__attribute__((target("avx2"))) SMART_BUFFER_NOINLINE
+void xxh64_batch_avx2(const std::uint8_t* const* data, std::size_t count, std::uint64_t* out,
+                      std::uint64_t seed) noexcept {
+    for (std::size_t i = 0; i + 4 <= count; i += 4) {
+        xxh64_lanes<Size, xxh64_v4, 4>(data + i, out + i, seed);
+    }
+}
+
+template<std::size_t Size>
+__attribute__((target("avx512f,avx512dq"))) SMART_BUFFER_NOINLINE
+void xxh64_batch_avx512(const std::uint8_t* const* data, std::size_t count, std::uint64_t* out,
+                        std::uint64_t seed) noexcept {
+    // Two vectors per step so that one multiply chain hides the other's latency
+    for (std::size_t i = 0; i + 16 <= count; i += 16) {
+        xxh64_lanes<Size, xxh64_v16, 16>(data + i, out + i, seed);
+    }
+}
+
+__attribute__((target("sse4.2")))
+inline std::uint32_t crc32c_hw(std::uint32_t crc, const std::uint8_t* data, std::size_t size) noexcept {
+    std::uint64_t state = crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        state = _mm_crc32_u64(state, load_u64(data));
+    }
+    auto c = static_cast<std::uint32_t>(state);
+    for (; size > 0; ++data, --size) {
+        c = _mm_crc32_u8(c, *data);
+    }
+    return c;
+}
+
+/**
+ * @brief CRC32C of Size bytes for Lanes buffers with their crc32 chains interleaved
+ */
+template<std::size_t Size, std::size_t Lanes>
+__attribute__((target("sse4.2"))) SMART_BUFFER_NOINLINE
+void crc32c_batch_hw(const std::uint8_t* const* data, std::size_t count, std::uint32_t* out) noexcept {
+    std::size_t i = 0;
+    for (; i + Lanes <= count; i += Lanes) {
+        std::uint64_t state[Lanes];
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            state[lane] = 0xFFFFFFFFu;
+        }
+        std::size_t offset = 0;
+        for (; offset + 8 <= Size; offset += 8) {
+            for (std::size_t lane = 0; lane < Lanes; ++lane) {
+                state[lane] = _mm_crc32_u64(state[lane], load_u64(data[i + lane] + offset));
+            }
+        }
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            out[i + lane] = ~crc32c_hw(static_cast<std::uint32_t>(state[lane]), data[i + lane] + offset, Size - offset);
+        }
+    }
+    for (; i < count; ++i) {
+        out[i] = ~crc32c_hw(0xFFFFFFFFu, data[i], Size);
+    }
+}
+
+inline SmartBufferHashIsa detect_hash_isa() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        return SmartBufferHashIsa::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SmartBufferHashIsa::Avx2;
+    }
+    return SmartBufferHashIsa::Scalar;
+}
+
+inline bool has_crc32_instruction() noexcept {
+    static const bool supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.2") != 0;
+    }();
+    return supported;
+}
+
+#else
+
+inline SmartBufferHashIsa detect_hash_isa() noexcept {
+    return SmartBufferHashIsa::Scalar;
+}
+
+inline bool has_crc32_instruction() noexcept {
+    return false;
+}
+
+#endif
+
+// Reflected Castagnoli polynomial
+inline constexpr std::uint32_t CRC32C_POLY = 0x82F63B78u;
+
+struct Crc32cTable {
+    std::array<std::uint32_t, 256> entries{};
+
+    constexpr Crc32cTable() noexcept {
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                c = (c >> 1) ^ ((c & 1) ? CRC32C_POLY : 0);
+            }
+            entries[i] = c;
+        }
+    }
+};
+
+inline constexpr Crc32cTable CRC32C_TABLE{};
+
+inline std::uint32_t crc32c_sw(std::uint32_t crc, const std::uint8_t* data, std::size_t size) noexcept {
+    for (; size > 0; ++data, --size) {
+        crc = CRC32C_TABLE.entries[(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+inline std::uint32_t crc32c_update(std::uint32_t crc, const std::uint8_t* data, std::size_t size) noexcept {
+#if SMART_BUFFER_X86_DISPATCH
+    if (has_crc32_instruction()) {
+        return crc32c_hw(crc, data, size);
+    }
+#endif
+    return crc32c_sw(crc, data, size);
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief Get the instruction set the XXH64 batch kernel uses on this machine
+ */
+inline SmartBufferHashIsa smart_buffer_hash_isa() noexcept {
+    static const SmartBufferHashIsa isa = smart_buffer_detail::detect_hash_isa();
+    return isa;
+}
+
+/**
+ * @brief CRC32C (Castagnoli) of a byte range, continuing from a previous result
+ * @param crc The CRC32C of the preceding bytes, or 0 to start
+ *
+ * Uses the SSE4.2 crc32 instruction when the CPU has it and a table otherwise.
+ */
+inline std::uint32_t smart_buffer_crc32c(const void* data, std::size_t size, std::uint32_t crc = 0) noexcept {
+    return ~smart_buffer_detail::crc32c_update(~crc, static_cast<const std::uint8_t*>(data), size);
+}
+
+/**
+ * @brief XXH64 of count equally sized buffers given by pointer
+ *
+ * Buffers are hashed 16 (AVX-512) or 4 (AVX2) at a time, one per SIMD lane, so the
+ * multiply chains of independent hashes run side by side. The digests equal
+ * smart_buffer_hash() of each buffer.
+ */
+template<std::size_t Size, std::size_t StaticThreshold>
+void smart_buffer_hash_batch(const SmartBuffer<Size, StaticThreshold>* const* buffers, std::size_t count,
+                             std::uint64_t* digests, std::uint64_t seed = 0) noexcept {
+    constexpr std::size_t BLOCK = 64;
+    const std::uint8_t* data[BLOCK];
+    for (std::size_t start = 0; start < count; start += BLOCK) {
+        std::size_t n = count - start < BLOCK ? count - start : BLOCK;
+        for (std::size_t i = 0; i < n; ++i) {
+            data[i] = buffers[start + i]->data();
+        }
+        std::size_t done = 0;
+#if SMART_BUFFER_X86_DISPATCH
+        switch (smart_buffer_hash_isa()) {
+        case SmartBufferHashIsa::Avx512:
+            smart_buffer_detail::xxh64_batch_avx512<Size>(data, n, digests + start, seed);
+            done = n - n % 16;
+            break;
+        case SmartBufferHashIsa::Avx2:
+            smart_buffer_detail::xxh64_batch_avx2<Size>(data, n, digests + start, seed);
+            done = n - n % 4;
+            break;
+        case SmartBufferHashIsa::Scalar:
+            break;
+        }
+#endif
+        for (std::size_t i = done; i < n; ++i) {
+            digests[start + i] = smart_buffer_detail::xxh64(data[i], Size, seed);
+        }
+    }
+}
+
+/**
+ * @brief XXH64 of count equally sized buffers stored contiguously
+ */
+template<std::size_t Size, std::size_t StaticThreshold>
+void smart_buffer_hash_batch(const SmartBuffer<Size, StaticThreshold>* buffers, std::size_t count,
+                             std::uint64_t* digests, std::uint64_t seed = 0) noexcept {
+    constexpr std::size_t BLOCK = 64;
+    const SmartBuffer<Size, StaticThreshold>* pointers[BLOCK];
+    for (std::size_t start = 0; start < count; start += BLOCK) {
+        std::size_t n = count - start < BLOCK ? count - start : BLOCK;
+        for (std::size_t i = 0; i < n; ++i) {
+            pointers[i] = &buffers[start + i];
+        }
+        smart_buffer_hash_batch(pointers, n, digests + start, seed);
+    }
+}
+
+/**
+ * @brief CRC32C of count equally sized buffers given by pointer
+ *
+ * The crc32 instruction has a latency of three cycles but a throughput of one per
+ * cycle, so eight buffers are processed with their dependency chains interleaved.
+ */
+template<std::size_t Size, std::size_t StaticThreshold>
+void smart_buffer_crc32c_batch(const SmartBuffer<Size, StaticThreshold>* const* buffers, std::size_t count,
+                               std::uint32_t* digests) noexcept {
+    constexpr std::size_t BLOCK = 64;
+    const std::uint8_t* data[BLOCK];
+    for (std::size_t start = 0; start < count; start += BLOCK) {
+        std::size_t n = count - start < BLOCK ? count - start : BLOCK;
+        for (std::size_t i = 0; i < n; ++i) {
+            data[i] = buffers[start + i]->data();
+        }
+#if SMART_BUFFER_X86_DISPATCH
+        if (smart_buffer_detail::has_crc32_instruction()) {
+            smart_buffer_detail::crc32c_batch_hw<Size, 8>(data, n, digests + start);
+            continue;
+        }
+#endif
+        for (std::size_t i = 0; i < n; ++i) {
+            digests[start + i] = ~smart_buffer_detail::crc32c_sw(0xFFFFFFFFu, data[i], Size);
+        }
+    }
+}
+
+/**
+ * @brief CRC32C of count equally sized buffers stored contiguously
+ */
+template<std::size_t Size, std::size_t StaticThreshold>
+void smart_buffer_crc32c_batch(const SmartBuffer<Size, StaticThreshold>* buffers, std::size_t count,
+                               std::uint32_t* digests) noexcept {
+    constexpr std::size_t BLOCK = 64;
+    const SmartBuffer<Size, StaticThreshold>* pointers[BLOCK];
+    for (std::size_t start = 0; start < count; start += BLOCK) {
+        std::size_t n = count - start < BLOCK ? count - start : BLOCK;
+        for (std::size_t i = 0; i < n; ++i) {
+            pointers[i] = &buffers[start + i];
+        }
+        smart_buffer_crc32c_batch(pointers, n, digests + start);
+    }
+}
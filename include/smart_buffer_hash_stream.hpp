@@ -0,0 +1,268 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_hash.hpp"
+#include "smart_buffer_hash_batch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace smart_buffer_detail {
+
+/**
+ * @brief Product of two polynomials modulo the CRC32C polynomial, in the reflected
+ *        bit order of CRC values (bit 31 is x^0)
+ */
+constexpr std::uint32_t crc32c_multiply_sw(std::uint32_t a, std::uint32_t b) noexcept {
+    std::uint32_t product = 0;
+    for (std::uint32_t bit = 1u << 31; a != 0; bit >>= 1) {
+        if (a & bit) {
+            product ^= b;
+            a ^= bit;
+        }
+        b = (b & 1) ? (b >> 1) ^ CRC32C_POLY : b >> 1;
+    }
+    return product;
+}
+
+#if SMART_BUFFER_X86_DISPATCH
+
+/**
+ * @brief crc32c_multiply_sw with a carry-less multiply; the crc32 instruction reduces
+ *        the upper half, since feeding 32 zero bits multiplies the register by x^32
+ */
+__attribute__((target("pclmul,sse4.2")))
+inline std::uint32_t crc32c_multiply_hw(std::uint32_t a, std::uint32_t b) noexcept {
+    __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(a)),
+                                           _mm_cvtsi32_si128(static_cast<int>(b)), 0x00);
+    auto wide = static_cast<std::uint64_t>(_mm_cvtsi128_si64(product)) << 1;
+    return static_cast<std::uint32_t>(wide >> 32) ^ _mm_crc32_u32(static_cast<std::uint32_t>(wide), 0);
+}
+
+inline bool has_clmul_instruction() noexcept {
+    static const bool supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.2");
+    }();
+    return supported;
+}
+
+#endif
+
+inline std::uint32_t crc32c_multiply(std::uint32_t a, std::uint32_t b) noexcept {
+#if SMART_BUFFER_X86_DISPATCH
+    if (has_clmul_instruction()) {
+        return crc32c_multiply_hw(a, b);
+    }
+#endif
+    return crc32c_multiply_sw(a, b);
+}
+
+// x^(2^k) modulo the polynomial, for k < 67 (covers shifts by up to 2^64 bytes)
+struct Crc32cPowers {
+    std::array<std::uint32_t, 67> entries{};
+
+    constexpr Crc32cPowers() noexcept {
+        entries[0] = 1u << 30;   // x^1
+        for (std::size_t k = 1; k < entries.size(); ++k) {
+            entries[k] = crc32c_multiply_sw(entries[k - 1], entries[k - 1]);
+        }
+    }
+};
+
+inline constexpr Crc32cPowers CRC32C_POWERS{};
+
+/**
+ * @brief x^(8 * bytes) modulo the polynomial: the operator that appends bytes zero
+ *        bytes to a CRC register. O(log bytes) multiplications.
+ */
+inline std::uint32_t crc32c_shift(std::uint64_t bytes) noexcept {
+    std::uint32_t power = 1u << 31;   // x^0
+    for (std::size_t k = 3; bytes != 0; bytes >>= 1, ++k) {
+        if (bytes & 1) {
+            power = crc32c_multiply(CRC32C_POWERS.entries[k], power);
+        }
+    }
+    return power;
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief CRC32C of the concatenation A || B from the CRC32Cs of A and B
+ * @param crc_a smart_buffer_crc32c() of A
+ * @param crc_b smart_buffer_crc32c() of B
+ * @param length_b Length of B in bytes
+ *
+ * Costs O(log length_b) and does not read the data, so the CRCs of the pieces of a
+ * payload can be computed on different threads and merged afterwards.
+ */
+inline std::uint32_t smart_buffer_crc32c_combine(std::uint32_t crc_a, std::uint32_t crc_b,
+                                                 std::uint64_t length_b) noexcept {
+    return smart_buffer_detail::crc32c_multiply(smart_buffer_detail::crc32c_shift(length_b), crc_a) ^ crc_b;
+}
+
+/**
+ * @brief CRC32C of count consecutive chunks of chunk_size bytes from their CRC32Cs
+ *
+ * The shift by one chunk is computed once, so each further chunk costs a single
+ * multiplication.
+ */
+inline std::uint32_t smart_buffer_crc32c_combine(const std::uint32_t* crcs, std::size_t count,
+                                                 std::uint64_t chunk_size) noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    std::uint32_t shift = smart_buffer_detail::crc32c_shift(chunk_size);
+    std::uint32_t crc = crcs[0];
+    for (std::size_t i = 1; i < count; ++i) {
+        crc = smart_buffer_detail::crc32c_multiply(shift, crc) ^ crcs[i];
+    }
+    return crc;
+}
+
+/**
+ * @brief Streaming CRC32C over a payload that arrives in pieces
+ *
+ * finalize() equals smart_buffer_crc32c() of everything passed to update(), without
+ * copying the pieces into one buffer. append() folds in a piece whose CRC was computed
+ * elsewhere, e.g. on another thread.
+ */
+class SmartBufferCrc32c {
+public:
+    SmartBufferCrc32c() noexcept = default;
+
+    void reset() noexcept {
+        crc_ = 0;
+        length_ = 0;
+    }
+
+    SmartBufferCrc32c& update(const void* data, std::size_t size) noexcept {
+        crc_ = smart_buffer_crc32c(data, size, crc_);
+        length_ += size;
+        return *this;
+    }
+
+    template<std::size_t Size, std::size_t StaticThreshold>
+    SmartBufferCrc32c& update(const SmartBuffer<Size, StaticThreshold>& buffer) noexcept {
+        return update(buffer.data(), Size);
+    }
+
+    SmartBufferCrc32c& update(SmartBufferConstSegment segment) noexcept {
+        return update(segment.data, segment.size);
+    }
+
+    /**
+     * @brief Continue with a piece of length bytes whose CRC32C is crc
+     */
+    SmartBufferCrc32c& append(std::uint32_t crc, std::uint64_t length) noexcept {
+        crc_ = smart_buffer_crc32c_combine(crc_, crc, length);
+        length_ += length;
+        return *this;
+    }
+
+    SmartBufferCrc32c& append(const SmartBufferCrc32c& other) noexcept {
+        return append(other.crc_, other.length_);
+    }
+
+    std::uint32_t finalize() const noexcept { return crc_; }
+    std::uint64_t length() const noexcept { return length_; }
+
+private:
+    std::uint32_t crc_ = 0;
+    std::uint64_t length_ = 0;
+};
+
+/**
+ * @brief Streaming XXH64 over a payload that arrives in pieces
+ *
+ * finalize() equals the one-shot XXH64 (smart_buffer_hash() for a single buffer) of
+ * everything passed to update() with the same seed. Stripes of 32 bytes are consumed
+ * straight from the input; only a partial stripe is copied between calls.
+ */
+class SmartBufferXxh64 {
+public:
+    explicit SmartBufferXxh64(std::uint64_t seed = 0) noexcept {
+        reset(seed);
+    }
+
+    void reset(std::uint64_t seed = 0) noexcept {
+        using namespace smart_buffer_detail;
+        seed_ = seed;
+        acc_[0] = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        acc_[1] = seed + XXH_PRIME64_2;
+        acc_[2] = seed;
+        acc_[3] = seed - XXH_PRIME64_1;
+        buffered_ = 0;
+        length_ = 0;
+    }
+
+    SmartBufferXxh64& update(const void* data, std::size_t size) noexcept {
+        auto* p = static_cast<const std::uint8_t*>(data);
+        length_ += size;
+        if (buffered_ > 0) {
+            std::size_t take = std::min(size, STRIPE - buffered_);
+            std::memcpy(stripe_ + buffered_, p, take);
+            buffered_ += take;
+            p += take;
+            size -= take;
+            if (buffered_ < STRIPE) {
+                return *this;
+            }
+            consume(stripe_);
+            buffered_ = 0;
+        }
+        for (; size >= STRIPE; p += STRIPE, size -= STRIPE) {
+            consume(p);
+        }
+        std::memcpy(stripe_, p, size);
+        buffered_ = size;
+        return *this;
+    }
+
+    template<std::size_t Size, std::size_t StaticThreshold>
+    SmartBufferXxh64& update(const SmartBuffer<Size, StaticThreshold>& buffer) noexcept {
+        return update(buffer.data(), Size);
+    }
+
+    SmartBufferXxh64& update(SmartBufferConstSegment segment) noexcept {
+        return update(segment.data, segment.size);
+    }
+
+    std::uint64_t finalize() const noexcept {
+        using namespace smart_buffer_detail;
+        std::uint64_t h;
+        if (length_ >= STRIPE) {
+            h = rotl64(acc_[0], 1) + rotl64(acc_[1], 7) + rotl64(acc_[2], 12) + rotl64(acc_[3], 18);
+            for (std::uint64_t acc : acc_) {
+                h = xxh64_merge_round(h, acc);
+            }
+        } else {
+            h = seed_ + XXH_PRIME64_5;
+        }
+        h += length_;
+        return xxh64_finalize(h, stripe_, buffered_);
+    }
+
+    std::uint64_t length() const noexcept { return length_; }
+
+private:
+    static constexpr std::size_t STRIPE = 32;
+
+    SMART_BUFFER_ALWAYS_INLINE void consume(const std::uint8_t* p) noexcept {
+        using namespace smart_buffer_detail;
+        acc_[0] = xxh64_round(acc_[0], load_u64(p));
+        acc_[1] = xxh64_round(acc_[1], load_u64(p + 8));
+        acc_[2] = xxh64_round(acc_[2], load_u64(p + 16));
+        acc_[3] = xxh64_round(acc_[3], load_u64(p + 24));
+    }
+
+    std::uint64_t seed_;
+    std::uint64_t acc_[4];
+    std::uint8_t stripe_[STRIPE];
+    std::size_t buffered_;
+    std::uint64_t length_;
+};
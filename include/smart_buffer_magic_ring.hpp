@@ -0,0 +1,202 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#if !defined(__linux__)
+#error "smart_buffer_magic_ring.hpp requires Linux (memfd_create + mmap)"
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief Single-producer/single-consumer byte ring whose storage is mapped twice,
+ *        back to back, in virtual memory.
+ *
+ * @tparam Capacity Ring size in bytes (power of two, multiple of the page size)
+ *
+ * Because byte i and byte i + Capacity alias the same physical page, every readable
+ * or writable region is contiguous even when it wraps past the end of the ring, so
+ * parsers can work on records in place without copying them into a temporary.
+ *
+ * The mapping is created with memfd_create + two MAP_FIXED mmaps over a reserved
+ * 2 * Capacity range. A heap-backed SmartBuffer<Capacity> cannot be double-mapped,
+ * so the ring owns its pages directly.
+ *
+ * Producer: write_region() / commit_write() or try_write().
+ * Consumer: read_region() / commit_read() or try_read().
+ *
+ * @requires C++17 or later, Linux
+ */
+template<std::size_t Capacity>
+class SmartBufferMagicRing {
+    static_assert(Capacity >= 4096, "Magic ring capacity must be at least one page");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Magic ring capacity must be a power of two");
+
+public:
+    static constexpr std::size_t CAPACITY = Capacity;
+
+    /**
+     * @brief Create the double mapping
+     * @throws std::invalid_argument if Capacity is not a multiple of the page size
+     * @throws std::system_error if memfd_create, ftruncate or mmap fails
+     */
+    SmartBufferMagicRing() {
+        long page_size = ::sysconf(_SC_PAGESIZE);
+        if (page_size <= 0 || Capacity % static_cast<std::size_t>(page_size) != 0) {
+            throw std::invalid_argument("SmartBufferMagicRing: capacity must be a multiple of the page size");
+        }
+
+        int fd = ::memfd_create("smart_buffer_ring", MFD_CLOEXEC);
+        if (fd < 0) {
+            throw_errno("memfd_create");
+        }
+        if (::ftruncate(fd, static_cast<off_t>(Capacity)) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw_errno("ftruncate", error);
+        }
+
+        // Reserve 2 * Capacity of address space, then map the file into both halves
+        void* reserved = ::mmap(nullptr, 2 * Capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            throw_errno("mmap (reserve)", error);
+        }
+        auto* base = static_cast<std::uint8_t*>(reserved);
+        for (std::size_t half = 0; half < 2; ++half) {
+            // MAP_POPULATE prefaults the pages so the first laps do not take page faults
+            void* view = ::mmap(base + half * Capacity, Capacity, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_FIXED | MAP_POPULATE, fd, 0);
+            if (view == MAP_FAILED) {
+                int error = errno;
+                ::munmap(reserved, 2 * Capacity);
+                ::close(fd);
+                throw_errno("mmap (view)", error);
+            }
+        }
+        ::close(fd);  // The mappings keep the memory alive
+        base_ = base;
+    }
+
+    SmartBufferMagicRing(const SmartBufferMagicRing&) = delete;
+    SmartBufferMagicRing& operator=(const SmartBufferMagicRing&) = delete;
+
+    ~SmartBufferMagicRing() {
+        ::munmap(base_, 2 * Capacity);
+    }
+
+    /**
+     * @brief Get the ring capacity in bytes
+     */
+    constexpr std::size_t capacity() const noexcept { return Capacity; }
+
+    /**
+     * @brief Get the number of readable bytes (approximate when called concurrently)
+     */
+    std::size_t size() const noexcept {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    // ---- Producer side -------------------------------------------------------
+
+    /**
+     * @brief Get the contiguous free region (producer only)
+     * The region is always contiguous, even when it crosses the end of the ring.
+     */
+    SmartBufferSegment write_region() noexcept {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        return {base_ + (head & MASK), Capacity - (head - cached_tail_)};
+    }
+
+    /**
+     * @brief Publish bytes written into write_region() (producer only)
+     */
+    void commit_write(std::size_t bytes) noexcept {
+        head_.store(head_.load(std::memory_order_relaxed) + bytes, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy bytes into the ring if there is room (producer only)
+     * @return false if fewer than size bytes are free
+     */
+    bool try_write(const void* data, std::size_t size) noexcept {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (Capacity - (head - cached_tail_) < size) {
+            // Only touch the consumer's cache line when the cached view is too small
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (Capacity - (head - cached_tail_) < size) {
+                return false;
+            }
+        }
+        std::memcpy(base_ + (head & MASK), data, size);
+        head_.store(head + size, std::memory_order_release);
+        return true;
+    }
+
+    // ---- Consumer side -------------------------------------------------------
+
+    /**
+     * @brief Get the contiguous readable region (consumer only)
+     */
+    SmartBufferConstSegment read_region() noexcept {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        cached_head_ = head_.load(std::memory_order_acquire);
+        return {base_ + (tail & MASK), cached_head_ - tail};
+    }
+
+    /**
+     * @brief Release bytes consumed from read_region() (consumer only)
+     */
+    void commit_read(std::size_t bytes) noexcept {
+        tail_.store(tail_.load(std::memory_order_relaxed) + bytes, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy bytes out of the ring if enough are available (consumer only)
+     * @return false if fewer than size bytes are readable
+     */
+    bool try_read(void* out, std::size_t size) noexcept {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (cached_head_ - tail < size) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (cached_head_ - tail < size) {
+                return false;
+            }
+        }
+        std::memcpy(out, base_ + (tail & MASK), size);
+        tail_.store(tail + size, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    [[noreturn]] static void throw_errno(const char* what, int error = errno) {
+        throw std::system_error(error, std::generic_category(), std::string("SmartBufferMagicRing: ") + what);
+    }
+
+    std::uint8_t* base_ = nullptr;
+
+    // Producer-owned line: write position and its cached view of the read position
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+
+    // Consumer-owned line: read position and its cached view of the write position
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0;
+};
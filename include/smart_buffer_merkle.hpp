@@ -0,0 +1,266 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_digest.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A Merkle tree over an array of SmartBuffer blocks.
+ *
+ * @tparam BlockSize Block size in bytes
+ *
+ * Hashes follow RFC 6962 (Certificate Transparency): a leaf is SHA-256(0x00 || block)
+ * and a node is SHA-256(0x01 || left || right). The prefixes keep a leaf from passing
+ * for a node. When a level has an odd number of nodes, the last one moves up unchanged,
+ * which gives the same root as RFC 6962's split at the largest power of two.
+ * SHA-256 runs on the SHA extensions when the CPU has them.
+ *
+ * Node hashes live in one array with no pointers, level after level starting with the
+ * leaves, and a node's position follows from its level and index. Every level starts
+ * on a cache line and two siblings share a 64-byte line, so an update or a proof
+ * touches one line per level and gets each sibling with the node on the path.
+ *
+ * build() hashes leaves and then each level across threads. update() rehashes the
+ * path from one block to the root in O(log n). prove() returns the sibling hashes on
+ * that path, which verify() checks against a root and tree size without the tree. As
+ * in RFC 9162, the root and the size must come from a trusted source, not the prover.
+ *
+ * Not thread-safe: updates need external synchronization.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t BlockSize = 4096>
+class SmartBufferMerkleTree {
+public:
+    using Block = SmartBuffer<BlockSize>;
+    using Digest = SmartBuffer<32>;
+
+    /**
+     * @brief The sibling hashes from a leaf up to the root
+     *
+     * A level where the node on the path has no sibling contributes no hash; index and
+     * the tree size tell the verifier which levels those are.
+     */
+    struct Proof {
+        std::size_t index = 0;
+        std::vector<Digest> siblings;
+    };
+
+    SmartBufferMerkleTree() = default;
+
+    /**
+     * @brief Build over count blocks
+     * @param threads Threads used to hash the leaves and the wide levels
+     */
+    SmartBufferMerkleTree(const Block* blocks, std::size_t count, unsigned threads = 1) {
+        build(blocks, count, threads);
+    }
+
+    /**
+     * @brief Rebuild over count blocks, replacing the current tree
+     */
+    void build(const Block* blocks, std::size_t count, unsigned threads = 1) {
+        layout(count);
+        threads = std::max(1u, threads);
+        parallel_for(count, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                store(node(0, i), hash_leaf(blocks[i]));
+            }
+        });
+        for (std::size_t level = 1; level < level_count(); ++level) {
+            std::size_t width = level_width_[level];
+            unsigned level_threads = width >= PARALLEL_NODES ? threads : 1;
+            parallel_for(width, level_threads, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    rehash(level, i);
+                }
+            });
+        }
+    }
+
+    /**
+     * @brief Record a new value for a block and rehash its path to the root
+     * @throws std::out_of_range if index is not below size()
+     */
+    void update(std::size_t index, const Block& block) {
+        check_index(index);
+        store(node(0, index), hash_leaf(block));
+        for (std::size_t level = 1; level < level_count(); ++level) {
+            index /= 2;
+            rehash(level, index);
+        }
+    }
+
+    /**
+     * @brief Get the root hash (SHA-256 of nothing for an empty tree)
+     */
+    Digest root() const noexcept {
+        if (leaf_count_ == 0) {
+            return SmartBufferSha256().finalize();
+        }
+        return load(node(level_count() - 1, 0));
+    }
+
+    /**
+     * @brief Get the leaf hash of a block
+     * @throws std::out_of_range if index is not below size()
+     */
+    Digest leaf(std::size_t index) const {
+        check_index(index);
+        return load(node(0, index));
+    }
+
+    /**
+     * @brief Get the proof that the block at index is part of the tree
+     * @throws std::out_of_range if index is not below size()
+     */
+    Proof prove(std::size_t index) const {
+        check_index(index);
+        Proof proof;
+        proof.index = index;
+        for (std::size_t level = 0; level + 1 < level_count(); ++level, index /= 2) {
+            std::size_t sibling = index ^ 1;
+            if (sibling < level_width_[level]) {
+                proof.siblings.push_back(load(node(level, sibling)));
+            }
+        }
+        return proof;
+    }
+
+    /**
+     * @brief Check that block sits at proof.index of a tree with the given root and size
+     *
+     * leaf_count must be trusted just like root: it decides which levels of the path
+     * have a sibling, so a size taken from the prover could move the block to another
+     * index.
+     */
+    static bool verify(const Digest& root, std::size_t leaf_count, const Block& block, const Proof& proof) {
+        if (proof.index >= leaf_count) {
+            return false;
+        }
+        Digest hash = hash_leaf(block);
+        std::size_t index = proof.index;
+        std::size_t width = leaf_count;
+        std::size_t used = 0;
+        for (; width > 1; index /= 2, width = (width + 1) / 2) {
+            if ((index ^ 1) >= width) {
+                continue;   // Promoted unchanged
+            }
+            if (used == proof.siblings.size()) {
+                return false;
+            }
+            const Digest& sibling = proof.siblings[used++];
+            hash = (index & 1) ? hash_node(sibling.data(), hash.data()) : hash_node(hash.data(), sibling.data());
+        }
+        return used == proof.siblings.size() && std::memcmp(hash.data(), root.data(), 32) == 0;
+    }
+
+    static Digest hash_leaf(const Block& block) noexcept {
+        const std::uint8_t prefix = 0x00;
+        return SmartBufferSha256().update(&prefix, 1).update(block).finalize();
+    }
+
+    static Digest hash_node(const std::uint8_t* left, const std::uint8_t* right) noexcept {
+        std::uint8_t input[65];
+        input[0] = 0x01;
+        std::memcpy(input + 1, left, 32);
+        std::memcpy(input + 33, right, 32);
+        return smart_buffer_sha256(input, sizeof(input));
+    }
+
+    std::size_t size() const noexcept { return leaf_count_; }
+
+    /**
+     * @brief Get the number of levels, leaves included (0 when empty)
+     */
+    std::size_t level_count() const noexcept { return level_width_.size(); }
+
+private:
+    // Two sibling hashes per cache line
+    struct alignas(64) NodePair {
+        std::uint8_t hash[2][32];
+    };
+
+    // Levels narrower than this are hashed on the calling thread
+    static constexpr std::size_t PARALLEL_NODES = 4096;
+
+    void layout(std::size_t count) {
+        leaf_count_ = count;
+        level_width_.clear();
+        level_start_.clear();
+        std::size_t pairs = 0;
+        for (std::size_t width = count; width > 0; width = width == 1 ? 0 : (width + 1) / 2) {
+            level_width_.push_back(width);
+            level_start_.push_back(pairs);
+            pairs += (width + 1) / 2;
+        }
+        nodes_.assign(pairs, NodePair{});
+    }
+
+    std::uint8_t* node(std::size_t level, std::size_t index) noexcept {
+        return nodes_[level_start_[level] + index / 2].hash[index & 1];
+    }
+
+    const std::uint8_t* node(std::size_t level, std::size_t index) const noexcept {
+        return nodes_[level_start_[level] + index / 2].hash[index & 1];
+    }
+
+    void rehash(std::size_t level, std::size_t index) noexcept {
+        std::size_t child = 2 * index;
+        if (child + 1 < level_width_[level - 1]) {
+            // Both children share one line
+            const NodePair& pair = nodes_[level_start_[level - 1] + index];
+            store(node(level, index), hash_node(pair.hash[0], pair.hash[1]));
+        } else {
+            std::memcpy(node(level, index), node(level - 1, child), 32);
+        }
+    }
+
+    static void store(std::uint8_t* slot, const Digest& digest) noexcept {
+        std::memcpy(slot, digest.data(), 32);
+    }
+
+    static Digest load(const std::uint8_t* slot) noexcept {
+        Digest digest;
+        std::memcpy(digest.data(), slot, 32);
+        return digest;
+    }
+
+    void check_index(std::size_t index) const {
+        if (index >= leaf_count_) {
+            throw std::out_of_range("SmartBufferMerkleTree: block index out of range");
+        }
+    }
+
+    template<typename Fn>
+    static void parallel_for(std::size_t count, unsigned threads, const Fn& fn) {
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(count, 1)));
+        if (threads <= 1) {
+            fn(0, count);
+            return;
+        }
+        std::vector<std::thread> workers;
+        std::size_t per_thread = (count + threads - 1) / threads;
+        for (unsigned t = 1; t < threads; ++t) {
+            std::size_t begin = std::min(count, t * per_thread);
+            std::size_t end = std::min(count, begin + per_thread);
+            workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+        }
+        fn(0, std::min(count, per_thread));
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t leaf_count_ = 0;
+    std::vector<std::size_t> level_width_;   // Nodes per level, leaves first
+    std::vector<std::size_t> level_start_;   // First NodePair of each level
+    std::vector<NodePair> nodes_;
+};
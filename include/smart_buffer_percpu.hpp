@@ -0,0 +1,193 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/sysinfo.h>
+#endif
+
+#if defined(__GLIBC__) && defined(__has_include) && defined(__has_builtin)
+#if __has_include(<sys/rseq.h>) && __has_builtin(__builtin_thread_pointer)
+#include <sys/rseq.h>
+#define SMART_BUFFER_HAS_RSEQ 1
+#endif
+#endif
+
+#ifndef SMART_BUFFER_HAS_RSEQ
+#define SMART_BUFFER_HAS_RSEQ 0
+#endif
+
+namespace smart_buffer_detail {
+
+/**
+ * @brief Get the CPU the calling thread is running on (0 if unknown)
+ *
+ * Reads the cpu_id the kernel keeps up to date in the thread's rseq area when glibc
+ * registered one (a plain load, no syscall), else calls sched_getcpu().
+ */
+inline unsigned current_cpu() noexcept {
+#if SMART_BUFFER_HAS_RSEQ
+    if (__rseq_size > 0) {
+        auto* area = reinterpret_cast<const volatile struct rseq*>(
+            static_cast<char*>(__builtin_thread_pointer()) + __rseq_offset);
+        auto cpu = static_cast<std::int32_t>(area->cpu_id);
+        if (cpu >= 0) {
+            return static_cast<unsigned>(cpu);
+        }
+    }
+#endif
+#if defined(__linux__)
+    int cpu = ::sched_getcpu();
+    return cpu >= 0 ? static_cast<unsigned>(cpu) : 0u;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Get the number of CPUs that may run threads of this process
+ */
+inline unsigned possible_cpus() noexcept {
+#if defined(__linux__)
+    int cpus = ::get_nprocs_conf();
+    if (cpus > 0) {
+        return static_cast<unsigned>(cpus);
+    }
+#endif
+    unsigned threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief Counters describing a SmartBufferPerCpuScratch
+ */
+struct SmartBufferPerCpuStats {
+    std::size_t slots = 0;       // One scratch buffer per possible CPU
+    std::size_t fallbacks = 0;   // Leases that found their CPU's slot busy
+};
+
+/**
+ * @brief One scratch SmartBuffer per CPU instead of one per thread.
+ *
+ * @tparam Size Scratch buffer size in bytes
+ *
+ * Services with thousands of threads but few CPUs pay for one thread_local scratch
+ * buffer per thread. Here a thread leases the buffer of the CPU it is running on for a
+ * short critical section. The CPU index is read from the rseq area the kernel maintains
+ * for the thread (glibc 2.35+), falling back to sched_getcpu().
+ *
+ * Because the thread can be preempted or migrated during the section, each slot has a
+ * busy flag. Taking it is an uncontended exchange on a cache line that stays local to
+ * the CPU. If the slot is already leased, by a thread that was preempted inside its
+ * section, the lease gets a private temporary buffer instead. Sections must therefore
+ * be short and must not block, or fallbacks (and their allocations) become common.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t Size>
+class SmartBufferPerCpuScratch {
+    struct Slot;
+
+public:
+    using Buffer = SmartBuffer<Size>;
+
+    /**
+     * @brief Exclusive use of a scratch buffer until destroyed
+     */
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept
+            : slot_(std::exchange(other.slot_, nullptr)), fallback_(std::move(other.fallback_)) {}
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+
+        ~Lease() {
+            if (slot_ != nullptr) {
+                slot_->busy.store(false, std::memory_order_release);
+            }
+        }
+
+        Buffer& buffer() noexcept { return slot_ != nullptr ? slot_->buffer : *fallback_; }
+        Buffer& operator*() noexcept { return buffer(); }
+        Buffer* operator->() noexcept { return &buffer(); }
+
+        /**
+         * @brief Check whether this lease got a temporary buffer instead of a CPU slot
+         */
+        bool is_fallback() const noexcept { return slot_ == nullptr; }
+
+    private:
+        friend class SmartBufferPerCpuScratch;
+
+        explicit Lease(Slot* slot) noexcept : slot_(slot) {}
+        explicit Lease(std::unique_ptr<Buffer> fallback) noexcept : slot_(nullptr), fallback_(std::move(fallback)) {}
+
+        Slot* slot_;
+        std::unique_ptr<Buffer> fallback_;
+    };
+
+    /**
+     * @brief Construct with one buffer per possible CPU
+     * @param cpus Number of slots; 0 means the number of possible CPUs
+     */
+    explicit SmartBufferPerCpuScratch(std::size_t cpus = 0)
+        : slot_count_(cpus != 0 ? cpus : smart_buffer_detail::possible_cpus()),
+          slots_(new Slot[slot_count_]) {}
+
+    SmartBufferPerCpuScratch(const SmartBufferPerCpuScratch&) = delete;
+    SmartBufferPerCpuScratch& operator=(const SmartBufferPerCpuScratch&) = delete;
+
+    /**
+     * @brief Lease the current CPU's scratch buffer
+     * The buffer keeps whatever a previous lease left in it.
+     */
+    Lease lease() {
+        Slot& slot = slots_[smart_buffer_detail::current_cpu() % slot_count_];
+        if (!slot.busy.exchange(true, std::memory_order_acquire)) {
+            return Lease(&slot);
+        }
+        fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        return Lease(std::make_unique<Buffer>());
+    }
+
+    /**
+     * @brief Run fn(Buffer&) on the current CPU's scratch buffer
+     * @return What fn returns
+     */
+    template<typename Fn>
+    decltype(auto) with(Fn&& fn) {
+        Lease held = lease();
+        return std::forward<Fn>(fn)(held.buffer());
+    }
+
+    std::size_t slot_count() const noexcept { return slot_count_; }
+
+    SmartBufferPerCpuStats stats() const noexcept {
+        SmartBufferPerCpuStats snapshot;
+        snapshot.slots = slot_count_;
+        snapshot.fallbacks = fallbacks_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<bool> busy{false};
+        Buffer buffer;
+    };
+
+    std::size_t slot_count_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::size_t> fallbacks_{0};
+};
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Counters describing a SmartBufferPool
+ */
+struct SmartBufferPoolStats {
+    std::size_t idle = 0;          // Buffers waiting in the pool
+    std::size_t live = 0;          // Buffers handed out and not yet released
+    std::size_t peak_live = 0;     // Highest live count observed
+    std::size_t allocations = 0;   // Buffers constructed because the pool was empty
+    std::size_t reuses = 0;        // Acquisitions served from the pool
+};
+
+namespace smart_buffer_detail {
+
+// Let the kernel reclaim the whole pages inside [data, data + size) while the block
+// stays allocated. Pages that are reclaimed read back as zeros, others keep their
+// contents, so the bytes must be treated as unspecified (or as zero if they already
+// were). Returns the number of bytes advised; a no-op outside Linux.
+inline std::size_t advise_free(std::uint8_t* data, std::size_t size) noexcept {
+#if defined(__linux__)
+    static const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto begin = (reinterpret_cast<std::uintptr_t>(data) + page_size - 1) & ~(page_size - 1);
+    auto end = (reinterpret_cast<std::uintptr_t>(data) + size) & ~(page_size - 1);
+    if (end <= begin) {
+        return 0;
+    }
+#if defined(MADV_FREE)
+    int advice = MADV_FREE;
+#else
+    int advice = MADV_DONTNEED;
+#endif
+    if (::madvise(reinterpret_cast<void*>(begin), end - begin, advice) != 0) {
+        return 0;
+    }
+    return end - begin;
+#else
+    (void)data;
+    (void)size;
+    return 0;
+#endif
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief A thread-safe free list of SmartBuffer objects of one size.
+ *
+ * @tparam Size Buffer size in bytes
+ * @tparam StaticThreshold Threshold forwarded to SmartBuffer
+ *
+ * acquire() hands out a recycled buffer when one is idle and constructs a new one
+ * otherwise; release() returns it. Since a dynamic SmartBuffer is a single owning
+ * pointer, moving buffers in and out of the pool never copies their contents.
+ *
+ * Recycled buffers keep whatever the previous user wrote; use acquire_zeroed() when
+ * clean contents are required.
+ *
+ * Pooled buffers outlive the code that acquired them, so the pool allocates from its
+ * own resource (the global heap by default) and ignores any SmartBufferResourceScope
+ * installed by the caller. Released buffers from another resource are freed, not pooled.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t Size, std::size_t StaticThreshold = 32>
+class SmartBufferPool {
+public:
+    using Buffer = SmartBuffer<Size, StaticThreshold>;
+
+    /**
+     * @brief Construct an empty pool
+     * @param max_idle Buffers released beyond this many idle ones are freed
+     * @param resource Resource for new buffers (null = global heap); must outlive the pool
+     */
+    explicit SmartBufferPool(std::size_t max_idle = SIZE_MAX, std::pmr::memory_resource* resource = nullptr)
+        : max_idle_(max_idle), resource_(resource) {}
+
+    SmartBufferPool(const SmartBufferPool&) = delete;
+    SmartBufferPool& operator=(const SmartBufferPool&) = delete;
+
+    /**
+     * @brief Get a buffer (contents unspecified if recycled)
+     */
+    Buffer acquire() {
+        bool recycled = false;
+        return acquire_impl(recycled);
+    }
+
+    /**
+     * @brief Get a buffer whose contents are all zero
+     */
+    Buffer acquire_zeroed() {
+        bool recycled = false;
+        Buffer buffer = acquire_impl(recycled);
+        if (recycled) {
+            buffer.clear_all();  // Fresh buffers are already zeroed by the constructor
+        }
+        return buffer;
+    }
+
+    /**
+     * @brief Return a buffer to the pool
+     */
+    void release(Buffer&& buffer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stats_.live != 0) {
+            --stats_.live;
+        }
+        if (buffer.data() != nullptr && owns(buffer) && idle_.size() < max_idle_) {
+            idle_.push_back(std::move(buffer));
+        }
+    }
+
+    /**
+     * @brief Make sure at least count buffers are idle
+     */
+    void reserve(std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.reserve(count);
+        while (idle_.size() < count) {
+            idle_.emplace_back(resource_);
+            ++stats_.allocations;
+        }
+    }
+
+    /**
+     * @brief Add buffers built elsewhere (e.g. by warmup threads) to the idle list
+     * Buffers beyond max_idle, or from another resource, are freed.
+     * @return Number of buffers kept
+     */
+    std::size_t adopt(std::vector<Buffer>&& buffers) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.allocations += buffers.size();
+        std::size_t kept = 0;
+        for (Buffer& buffer : buffers) {
+            if (idle_.size() == max_idle_) {
+                break;
+            }
+            if (!owns(buffer)) {
+                continue;
+            }
+            idle_.push_back(std::move(buffer));
+            ++kept;
+        }
+        buffers.clear();
+        return kept;
+    }
+
+    /**
+     * @brief Free idle buffers beyond keep
+     * @return Number of buffers freed
+     */
+    std::size_t trim(std::size_t keep) {
+        std::vector<Buffer> released;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (idle_.size() <= keep) {
+                return 0;
+            }
+            auto first = idle_.begin() + static_cast<std::ptrdiff_t>(keep);
+            released.assign(std::make_move_iterator(first), std::make_move_iterator(idle_.end()));
+            idle_.erase(first, idle_.end());
+        }
+        return released.size();  // Freed outside the lock
+    }
+
+    /**
+     * @brief Let the kernel reclaim the pages of idle buffers that stay pooled
+     * Recycled contents were already unspecified, so nothing observable changes.
+     * @return Number of bytes advised
+     */
+    std::size_t advise_idle() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t advised = 0;
+        for (Buffer& buffer : idle_) {
+            advised += smart_buffer_detail::advise_free(buffer.data(), buffer.actual_size());
+        }
+        return advised;
+    }
+
+    /**
+     * @brief Free every idle buffer
+     */
+    void shrink() {
+        std::vector<Buffer> released;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            released.swap(idle_);
+        }
+    }
+
+    /**
+     * @brief Get the number of idle buffers
+     */
+    std::size_t idle() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_.size();
+    }
+
+    /**
+     * @brief Get a snapshot of the pool counters
+     */
+    SmartBufferPoolStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SmartBufferPoolStats snapshot = stats_;
+        snapshot.idle = idle_.size();
+        return snapshot;
+    }
+
+    /**
+     * @brief Get the resource new buffers are allocated from (null = global heap)
+     */
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+    /**
+     * @brief Get the buffer size served by this pool
+     */
+    constexpr std::size_t buffer_size() const noexcept { return Size; }
+
+private:
+    void note_acquire() {
+        ++stats_.live;
+        if (stats_.live > stats_.peak_live) {
+            stats_.peak_live = stats_.live;
+        }
+    }
+
+    bool owns(const Buffer& buffer) const noexcept {
+        return buffer.is_static() || buffer.resource() == resource_;
+    }
+
+    Buffer acquire_impl(bool& recycled) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            note_acquire();
+            if (!idle_.empty()) {
+                Buffer buffer = std::move(idle_.back());
+                idle_.pop_back();
+                ++stats_.reuses;
+                recycled = true;
+                return buffer;
+            }
+            ++stats_.allocations;
+        }
+        return Buffer(resource_);  // Constructed outside the lock
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Buffer> idle_;
+    std::size_t max_idle_;
+    std::pmr::memory_resource* resource_;
+    SmartBufferPoolStats stats_;
+};
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Publishes immutable versions of a large buffer to wait-free readers and
+ *        reclaims old versions once no reader can see them (read-copy-update).
+ *
+ * @tparam Buffer The published type, typically a SmartBuffer holding a table
+ *
+ * The current version is an atomic pointer. Readers pin it for the duration of a read
+ * section and access it in place, without copying and without taking a lock. A writer
+ * builds a new version and swaps the pointer; the old version is retired and deleted
+ * once every reader has left the sections that might still use it.
+ *
+ * Reclamation is epoch based. Each reader owns a slot in which it announces the global
+ * epoch when a read section starts and clears it when the section ends. Publishing
+ * advances the epoch and tags the retired version with the previous one; a version is
+ * deleted once no slot announces an epoch at or below its tag. A stalled reader delays
+ * reclamation but never blocks the writer or other readers.
+ *
+ * Readers register once per thread with make_reader() and must not outlive the
+ * publisher. Writers are serialized internally.
+ *
+ * @requires C++17 or later
+ */
+template<typename Buffer>
+class SmartBufferRcu {
+    struct Slot;
+
+public:
+    static constexpr std::size_t DEFAULT_MAX_READERS = 256;
+
+    /**
+     * @brief A pinned version, readable until the guard is destroyed
+     */
+    class ReadGuard {
+    public:
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        ~ReadGuard() {
+            if (--slot_->depth == 0) {
+                slot_->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+        const Buffer& operator*() const noexcept { return *buffer_; }
+        const Buffer* operator->() const noexcept { return buffer_; }
+        const Buffer* get() const noexcept { return buffer_; }
+
+    private:
+        friend class SmartBufferRcu;
+
+        ReadGuard(Slot* slot, const Buffer* buffer) noexcept : slot_(slot), buffer_(buffer) {}
+
+        Slot* slot_;
+        const Buffer* buffer_;
+    };
+
+    /**
+     * @brief A registered reader; owned and used by a single thread
+     */
+    class Reader {
+    public:
+        Reader(Reader&& other) noexcept : rcu_(other.rcu_), slot_(std::exchange(other.slot_, nullptr)) {}
+        Reader& operator=(Reader&&) = delete;
+        Reader(const Reader&) = delete;
+
+        ~Reader() {
+            if (slot_ != nullptr) {
+                slot_->in_use.store(false, std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief Pin the current version; read sections on one reader may nest
+         */
+        ReadGuard read() const noexcept {
+            if (slot_->depth++ == 0) {
+                // seq_cst orders the announcement before the pointer load against the
+                // writer's pointer swap and slot scan
+                slot_->epoch.store(rcu_->epoch_.load(std::memory_order_acquire), std::memory_order_seq_cst);
+            }
+            return ReadGuard(slot_, rcu_->current_.load(std::memory_order_seq_cst));
+        }
+
+    private:
+        friend class SmartBufferRcu;
+
+        Reader(const SmartBufferRcu* rcu, Slot* slot) noexcept : rcu_(rcu), slot_(slot) {}
+
+        const SmartBufferRcu* rcu_;
+        Slot* slot_;
+    };
+
+    /**
+     * @brief Construct with an initial version
+     * @param initial The first published version
+     * @param max_readers Maximum number of concurrently registered readers
+     */
+    explicit SmartBufferRcu(std::unique_ptr<Buffer> initial = std::make_unique<Buffer>(),
+                            std::size_t max_readers = DEFAULT_MAX_READERS)
+        : slots_(max_readers), current_(initial.release()) {}
+
+    SmartBufferRcu(const SmartBufferRcu&) = delete;
+    SmartBufferRcu& operator=(const SmartBufferRcu&) = delete;
+
+    /**
+     * @brief Delete every version; no reader may be registered
+     */
+    ~SmartBufferRcu() {
+        delete current_.load(std::memory_order_relaxed);
+        for (Retired& retired : retired_) {
+            delete retired.buffer;
+        }
+    }
+
+    /**
+     * @brief Register the calling thread as a reader
+     * @throws std::length_error if max_readers readers are already registered
+     */
+    Reader make_reader() {
+        for (Slot& slot : slots_) {
+            bool expected = false;
+            if (!slot.in_use.load(std::memory_order_relaxed)
+                && slot.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                slot.depth = 0;
+                return Reader(this, &slot);
+            }
+        }
+        throw std::length_error("SmartBufferRcu: too many readers");
+    }
+
+    /**
+     * @brief Replace the current version and reclaim what readers no longer use
+     */
+    void publish(std::unique_ptr<Buffer> next) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        publish_locked(std::move(next));
+    }
+
+    /**
+     * @brief Publish a modified copy of the current version
+     * @param fn Called as fn(Buffer&) on the copy before it is published
+     */
+    template<typename Fn>
+    void update(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        auto next = std::make_unique<Buffer>(*current_.load(std::memory_order_relaxed));
+        fn(*next);
+        publish_locked(std::move(next));
+    }
+
+    /**
+     * @brief Delete the retired versions that no reader can still see
+     * @return The number of versions deleted
+     */
+    std::size_t reclaim() {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        return reclaim_locked();
+    }
+
+    /**
+     * @brief Wait until every retired version has been deleted
+     */
+    void synchronize() {
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(writer_mutex_);
+                reclaim_locked();
+                if (retired_.empty()) {
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Get the number of retired versions not yet deleted
+     */
+    std::size_t retired() const {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        return retired_.size();
+    }
+
+    /**
+     * @brief Get the number of versions published after the initial one
+     */
+    std::uint64_t version() const noexcept {
+        return epoch_.load(std::memory_order_relaxed) - 1;
+    }
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    // One per reader, on its own cache line so readers do not share lines
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<std::uint64_t> epoch{0};   // 0: outside any read section
+        std::atomic<bool> in_use{false};
+        std::size_t depth = 0;                 // Nesting level, touched only by the owner
+    };
+
+    struct Retired {
+        Buffer* buffer;
+        std::uint64_t epoch;
+    };
+
+    void publish_locked(std::unique_ptr<Buffer> next) {
+        Buffer* old = current_.exchange(next.release(), std::memory_order_seq_cst);
+        // Readers that announce a later epoch loaded the pointer after the swap
+        std::uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+        retired_.push_back(Retired{old, epoch});
+        reclaim_locked();
+    }
+
+    std::size_t reclaim_locked() {
+        std::uint64_t oldest = UINT64_MAX;
+        for (const Slot& slot : slots_) {
+            std::uint64_t epoch = slot.epoch.load(std::memory_order_seq_cst);
+            if (epoch != 0 && epoch < oldest) {
+                oldest = epoch;
+            }
+        }
+        std::size_t freed = 0;
+        std::size_t kept = 0;
+        for (Retired& retired : retired_) {
+            if (retired.epoch < oldest) {
+                delete retired.buffer;
+                ++freed;
+            } else {
+                retired_[kept++] = retired;
+            }
+        }
+        retired_.resize(kept);
+        return freed;
+    }
+
+    std::vector<Slot> slots_;
+    alignas(CACHE_LINE) std::atomic<Buffer*> current_;
+    std::atomic<std::uint64_t> epoch_{1};
+    mutable std::mutex writer_mutex_;
+    std::vector<Retired> retired_;
+};
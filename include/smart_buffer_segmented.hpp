@@ -0,0 +1,247 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/**
+ * @brief A very large fixed-size buffer stored as fixed-size segments behind an
+ *        indirection table instead of one contiguous allocation.
+ *
+ * @tparam Size Logical size of the buffer in bytes
+ * @tparam SegmentShift log2 of the segment size (default: 16, i.e. 64 KiB segments)
+ * @tparam LazyAllocation Allocate segments on first write instead of up front
+ *
+ * operator[] resolves an index with a shift and a mask. Segments can be visited with
+ * segment()/for_each_segment(), which hands bulk kernels contiguous spans and lets
+ * independent segments be processed in parallel.
+ *
+ * With lazy allocation, reading an unallocated segment through a const accessor sees
+ * zeros without allocating; non-const access allocates the segment zero-filled.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t Size, unsigned SegmentShift = 16, bool LazyAllocation = false>
+class SmartBufferSegmented {
+public:
+    static constexpr std::size_t SEGMENT_SIZE = std::size_t{1} << SegmentShift;
+    static constexpr std::size_t SEGMENT_MASK = SEGMENT_SIZE - 1;
+    static constexpr std::size_t SEGMENT_COUNT = (Size + SEGMENT_SIZE - 1) >> SegmentShift;
+
+    static_assert(Size > 0, "SmartBufferSegmented requires a non-zero size");
+    static_assert(SegmentShift >= 3 && SegmentShift < 8 * sizeof(std::size_t), "Invalid segment shift");
+
+    /**
+     * @brief Default constructor
+     * Eager mode allocates every segment zero-filled; lazy mode allocates nothing.
+     */
+    SmartBufferSegmented() : segments_(std::make_unique<Segment[]>(SEGMENT_COUNT)) {
+        if constexpr (!LazyAllocation) {
+            for (std::size_t i = 0; i < SEGMENT_COUNT; ++i) {
+                segments_[i].reset(smart_buffer_detail::allocate_zeroed(SEGMENT_SIZE));
+            }
+        }
+    }
+
+    /**
+     * @brief Copy constructor (copies only allocated segments)
+     */
+    SmartBufferSegmented(const SmartBufferSegmented& other)
+        : segments_(std::make_unique<Segment[]>(SEGMENT_COUNT)) {
+        for (std::size_t i = 0; i < SEGMENT_COUNT; ++i) {
+            if (other.segments_[i]) {
+                segments_[i].reset(smart_buffer_detail::allocate_copy(other.segments_[i].get(), SEGMENT_SIZE));
+            }
+        }
+    }
+
+    /**
+     * @brief Move constructor
+     */
+    SmartBufferSegmented(SmartBufferSegmented&& other) noexcept = default;
+
+    /**
+     * @brief Copy assignment operator
+     */
+    SmartBufferSegmented& operator=(const SmartBufferSegmented& other) {
+        if (this != &other) {
+            SmartBufferSegmented copy(other);
+            segments_ = std::move(copy.segments_);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator
+     */
+    SmartBufferSegmented& operator=(SmartBufferSegmented&& other) noexcept = default;
+
+    ~SmartBufferSegmented() = default;
+
+    /**
+     * @brief Get the logical size of the buffer
+     */
+    constexpr std::size_t size() const noexcept { return Size; }
+
+    /**
+     * @brief Get the size of one segment
+     */
+    constexpr std::size_t segment_size() const noexcept { return SEGMENT_SIZE; }
+
+    /**
+     * @brief Get the number of segments in the indirection table
+     */
+    constexpr std::size_t segment_count() const noexcept { return SEGMENT_COUNT; }
+
+    /**
+     * @brief Check if segments are allocated on first write
+     */
+    constexpr bool is_lazy() const noexcept { return LazyAllocation; }
+
+    /**
+     * @brief Check if a segment currently has backing memory
+     */
+    bool is_segment_allocated(std::size_t segment_index) const noexcept {
+        return static_cast<bool>(segments_[segment_index]);
+    }
+
+    /**
+     * @brief Get the number of bytes currently allocated for segments
+     */
+    std::size_t allocated_bytes() const noexcept {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < SEGMENT_COUNT; ++i) {
+            count += is_segment_allocated(i);
+        }
+        return count * SEGMENT_SIZE;
+    }
+
+    /**
+     * @brief Array subscript operator (shift/mask lookup)
+     * @param index Index to access (should be within size())
+     * @return Reference to the byte at the given index
+     */
+    std::uint8_t& operator[](std::size_t index) {
+        return writable_segment(index >> SegmentShift)[index & SEGMENT_MASK];
+    }
+
+    /**
+     * @brief Array subscript operator (const version, never allocates)
+     */
+    const std::uint8_t& operator[](std::size_t index) const {
+        return readable_segment(index >> SegmentShift)[index & SEGMENT_MASK];
+    }
+
+    /**
+     * @brief Get a writable span for one segment (allocates it in lazy mode)
+     */
+    SmartBufferSegment segment(std::size_t segment_index) {
+        return {writable_segment(segment_index), logical_segment_size(segment_index)};
+    }
+
+    /**
+     * @brief Get a read-only span for one segment (zeros if unallocated)
+     */
+    SmartBufferConstSegment segment(std::size_t segment_index) const {
+        return {readable_segment(segment_index), logical_segment_size(segment_index)};
+    }
+
+    /**
+     * @brief Invoke fn(segment_index, SmartBufferSegment) for every segment in order
+     */
+    template<typename Fn>
+    void for_each_segment(Fn&& fn) {
+        for (std::size_t i = 0; i < SEGMENT_COUNT; ++i) {
+            fn(i, segment(i));
+        }
+    }
+
+    /**
+     * @brief Invoke fn(segment_index, SmartBufferConstSegment) for every segment
+     */
+    template<typename Fn>
+    void for_each_segment(Fn&& fn) const {
+        for (std::size_t i = 0; i < SEGMENT_COUNT; ++i) {
+            fn(i, segment(i));
+        }
+    }
+
+    /**
+     * @brief Fill the buffer with a specific value
+     * In lazy mode, filling with zero releases every segment instead of touching memory.
+     */
+    void fill(std::uint8_t value) {
+        if constexpr (LazyAllocation) {
+            if (value == 0) {
+                release();
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < SEGMENT_COUNT; ++i) {
+            smart_buffer_detail::fill_bytes(writable_segment(i), logical_segment_size(i), value);
+        }
+    }
+
+    /**
+     * @brief Clear the buffer (fill with zeros)
+     */
+    void clear() {
+        fill(0);
+    }
+
+    /**
+     * @brief Release the memory of every segment (lazy mode only); contents read as zero
+     */
+    void release() noexcept {
+        static_assert(LazyAllocation, "release() requires lazy segment allocation");
+        for (std::size_t i = 0; i < SEGMENT_COUNT; ++i) {
+            segments_[i].reset();
+        }
+    }
+
+private:
+    using Segment = std::unique_ptr<std::uint8_t[]>;
+
+    static constexpr std::size_t logical_segment_size(std::size_t segment_index) noexcept {
+        return segment_index + 1 < SEGMENT_COUNT ? SEGMENT_SIZE : Size - (segment_index << SegmentShift);
+    }
+
+    // Shared all-zero segment backing const reads of unallocated segments
+    static const std::uint8_t* zero_segment() noexcept {
+        static const std::array<std::uint8_t, SEGMENT_SIZE> zeros{};
+        return zeros.data();
+    }
+
+    std::uint8_t* writable_segment(std::size_t segment_index) {
+        Segment& segment = segments_[segment_index];
+        if constexpr (LazyAllocation) {
+            if (!segment) {
+                segment.reset(smart_buffer_detail::allocate_zeroed(SEGMENT_SIZE));
+            }
+        }
+        return segment.get();
+    }
+
+    const std::uint8_t* readable_segment(std::size_t segment_index) const noexcept {
+        const std::uint8_t* segment = segments_[segment_index].get();
+        if constexpr (LazyAllocation) {
+            if (!segment) {
+                return zero_segment();
+            }
+        }
+        return segment;
+    }
+
+    // Indirection table: one owning pointer per segment
+    std::unique_ptr<Segment[]> segments_;
+};
+
+/**
+ * @brief Segmented buffer whose segments are allocated on first write
+ */
+template<std::size_t Size, unsigned SegmentShift = 16>
+using SmartBufferSegmentedLazy = SmartBufferSegmented<Size, SegmentShift, true>;
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief A small SmartBuffer published by one writer and read lock-free by any number
+ *        of readers (sequence lock).
+ *
+ * @tparam Size Buffer size in bytes; the snapshot type is a static SmartBuffer<Size>
+ *
+ * The payload is held as an array of std::atomic<uint64_t> words that are copied with
+ * relaxed loads and stores, so concurrent reads and writes are free of data races. A
+ * sequence counter is odd while a write is in progress; readers retry when they see an
+ * odd value or the counter changed during their copy. Readers never write shared
+ * memory, so they do not contend with each other.
+ *
+ * Writers must be serialized by the caller (typically there is one writer thread).
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t Size>
+class SmartBufferSeqlock {
+public:
+    using Buffer = SmartBufferAlwaysStatic<Size>;
+
+    static constexpr std::size_t WORD_COUNT = (Size + 7) / 8;
+
+    /**
+     * @brief Construct with an all-zero snapshot
+     */
+    SmartBufferSeqlock() noexcept = default;
+
+    /**
+     * @brief Construct with an initial snapshot
+     */
+    explicit SmartBufferSeqlock(const Buffer& initial) noexcept : shadow_(initial) {
+        publish();
+    }
+
+    SmartBufferSeqlock(const SmartBufferSeqlock&) = delete;
+    SmartBufferSeqlock& operator=(const SmartBufferSeqlock&) = delete;
+
+    /**
+     * @brief Modify the snapshot in place and publish it (writer only)
+     * @param fn Called as fn(Buffer&) on the writer's private copy of the snapshot
+     */
+    template<typename Fn>
+    void write(Fn&& fn) {
+        fn(shadow_);
+        publish();
+    }
+
+    /**
+     * @brief Replace the snapshot (writer only)
+     */
+    void store(const Buffer& buffer) noexcept {
+        shadow_ = buffer;
+        publish();
+    }
+
+    /**
+     * @brief Copy a consistent snapshot into out, retrying while a write is in progress
+     */
+    void read(Buffer& out) const noexcept {
+        while (!try_read(out)) {
+            cpu_relax();
+        }
+    }
+
+    /**
+     * @brief Get a consistent snapshot
+     */
+    Buffer load() const noexcept {
+        Buffer out;
+        read(out);
+        return out;
+    }
+
+    /**
+     * @brief Make one attempt to copy a consistent snapshot into out
+     * @return false if a write overlapped the copy (out is then unspecified)
+     */
+    bool try_read(Buffer& out) const noexcept {
+        std::uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        std::uint8_t* dest = out.data();
+        for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+            std::uint64_t word = words_[i].load(std::memory_order_relaxed);
+            std::memcpy(dest + i * 8, &word, copy_size(i));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) == before;
+    }
+
+    /**
+     * @brief Get the number of snapshots published so far
+     */
+    std::uint64_t version() const noexcept {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+
+    constexpr std::size_t size() const noexcept { return Size; }
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    // The last word may be partial when Size is not a multiple of 8
+    static constexpr std::size_t copy_size(std::size_t word) noexcept {
+        return word + 1 < WORD_COUNT || Size % 8 == 0 ? 8 : Size % 8;
+    }
+
+    static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+
+    void publish() noexcept {
+        std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);   // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        const std::uint8_t* source = shadow_.data();
+        for (std::size_t i = 0; i < WORD_COUNT; ++i) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, source + i * 8, copy_size(i));
+            words_[i].store(word, std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    alignas(CACHE_LINE) std::atomic<std::uint64_t> sequence_{0};
+    std::array<std::atomic<std::uint64_t>, WORD_COUNT> words_{};
+    alignas(CACHE_LINE) Buffer shadow_;   // Writer's private copy, kept off the readers' lines
+};
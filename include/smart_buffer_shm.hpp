@@ -0,0 +1,458 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#if !defined(__linux__)
+#error "smart_buffer_shm.hpp requires Linux (memfd_create + futex)"
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief One block handed between processes: which block, and how many bytes are used
+ *
+ * Handles are block indices, not pointers, so they mean the same thing in every
+ * process that maps the segment, whatever address it is mapped at.
+ */
+struct SmartBufferShmHandle {
+    std::uint32_t block = 0;
+    std::uint32_t size = 0;
+};
+
+namespace smart_buffer_detail {
+
+inline long futex(std::atomic<std::uint32_t>* word, int op, std::uint32_t value,
+                  const struct timespec* timeout = nullptr) noexcept {
+    // Shared (non-private) futex ops: waiters and wakers live in different processes
+    return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), op, value, timeout, nullptr, 0);
+}
+
+// A cross-process event: a sequence word to futex-wait on and a waiter count so that
+// notify() only enters the kernel when someone sleeps
+struct ShmEvent {
+    std::atomic<std::uint32_t> sequence{0};
+    std::atomic<std::uint32_t> waiters{0};
+
+    void notify() noexcept {
+        sequence.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) != 0) {
+            futex(&sequence, FUTEX_WAKE, INT_MAX);
+        }
+    }
+
+    // Wait until try_op() succeeds or the deadline passes; returns false on timeout
+    template<typename TryOp>
+    bool wait(TryOp&& try_op, const std::chrono::steady_clock::time_point* deadline) {
+        while (true) {
+            std::uint32_t seen = sequence.load(std::memory_order_seq_cst);
+            if (try_op()) {
+                return true;
+            }
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (try_op()) {
+                waiters.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            struct timespec relative {};
+            const struct timespec* timeout = nullptr;
+            if (deadline != nullptr) {
+                auto remaining = *deadline - std::chrono::steady_clock::now();
+                if (remaining <= std::chrono::steady_clock::duration::zero()) {
+                    waiters.fetch_sub(1, std::memory_order_relaxed);
+                    return false;
+                }
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+                relative.tv_sec = static_cast<time_t>(ns / 1000000000);
+                relative.tv_nsec = static_cast<long>(ns % 1000000000);
+                timeout = &relative;
+            }
+            futex(&sequence, FUTEX_WAIT, seen, timeout);  // Returns at once if sequence moved
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief A pool of fixed-size blocks in a shared memory segment, plus a lock-free
+ *        descriptor ring in the same segment for passing blocks between processes.
+ *
+ * @tparam BlockSize Size of each block in bytes (default: 4096, one SmartBuffer4K payload)
+ *
+ * The producer allocates a block, writes its payload in place and sends the handle; the
+ * consumer receives the handle, reads the payload in place and frees the block. The
+ * payload is never copied. The ring is a bounded multi-producer/multi-consumer queue
+ * (so SPSC and MPSC both work); blocking calls sleep on shared futexes, and the wake-up
+ * syscall is skipped when nobody sleeps.
+ *
+ * The segment is a memfd created by create(). Another process maps it with attach(fd),
+ * receiving the descriptor by fork() inheritance or over a Unix socket (SCM_RIGHTS).
+ * Blocks held by a process that dies are not reclaimed.
+ *
+ * @requires C++17 or later, Linux
+ */
+template<std::size_t BlockSize = 4096>
+class SmartBufferShmPool {
+    static_assert(BlockSize > 0 && BlockSize <= UINT32_MAX, "Invalid shared-memory block size");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared-memory pool needs lock-free 64-bit atomics");
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Shared-memory pool needs lock-free 32-bit atomics");
+
+public:
+    using Handle = SmartBufferShmHandle;
+
+    /**
+     * @brief Create a new segment
+     * @param block_count Number of blocks in the pool
+     * @param ring_capacity Number of descriptors the ring holds (rounded up to a power of two)
+     * @throws std::invalid_argument on zero sizes, std::system_error if the segment cannot be created
+     */
+    static SmartBufferShmPool create(std::uint32_t block_count, std::uint32_t ring_capacity = 1024) {
+        if (block_count == 0 || ring_capacity == 0) {
+            throw std::invalid_argument("SmartBufferShmPool: block count and ring capacity must be non-zero");
+        }
+        std::uint32_t capacity = 1;
+        while (capacity < ring_capacity) {
+            capacity <<= 1;
+        }
+        Layout layout = Layout::compute(block_count, capacity);
+
+        int fd = ::memfd_create("smart_buffer_shm", MFD_CLOEXEC);
+        if (fd < 0) {
+            throw_errno("memfd_create");
+        }
+        if (::ftruncate(fd, static_cast<off_t>(layout.total)) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw_errno("ftruncate", error);
+        }
+        SmartBufferShmPool pool(fd, layout.total);
+
+        // The file starts zeroed; construct the shared state in place
+        Header* header = new (pool.base_) Header();
+        header->block_size = static_cast<std::uint32_t>(BlockSize);
+        header->block_count = block_count;
+        header->ring_capacity = capacity;
+        pool.bind(layout);
+        for (std::uint32_t i = 0; i < block_count; ++i) {
+            new (&pool.next_[i]) std::atomic<std::uint32_t>(i + 2 <= block_count ? i + 2 : 0);
+        }
+        header->free_head.store(1, std::memory_order_relaxed);  // Block 0 heads the list
+        header->free_count.store(block_count, std::memory_order_relaxed);
+        for (std::uint32_t i = 0; i < capacity; ++i) {
+            new (&pool.ring_[i]) Cell();
+            pool.ring_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        header->magic.store(MAGIC, std::memory_order_release);  // Published last
+        return pool;
+    }
+
+    /**
+     * @brief Map a segment created by another process
+     * @param fd Descriptor of the segment; the pool keeps its own duplicate
+     * @throws std::invalid_argument if fd is not a segment for this BlockSize
+     */
+    static SmartBufferShmPool attach(int fd) {
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            throw_errno("fstat");
+        }
+        if (static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+            throw std::invalid_argument("SmartBufferShmPool: descriptor is not a shared-memory pool");
+        }
+        int own = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+        if (own < 0) {
+            throw_errno("fcntl");
+        }
+        SmartBufferShmPool pool(own, static_cast<std::size_t>(info.st_size));
+        auto* header = static_cast<Header*>(pool.base_);
+        if (header->magic.load(std::memory_order_acquire) != MAGIC || header->block_size != BlockSize) {
+            throw std::invalid_argument("SmartBufferShmPool: segment magic or block size mismatch");
+        }
+        Layout layout = Layout::compute(header->block_count, header->ring_capacity);
+        if (layout.total > pool.mapped_size_) {
+            throw std::invalid_argument("SmartBufferShmPool: segment is truncated");
+        }
+        pool.bind(layout);
+        return pool;
+    }
+
+    SmartBufferShmPool(SmartBufferShmPool&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)), mapped_size_(std::exchange(other.mapped_size_, 0)),
+          base_(std::exchange(other.base_, nullptr)), header_(other.header_), next_(other.next_),
+          ring_(other.ring_), blocks_(other.blocks_) {}
+
+    SmartBufferShmPool(const SmartBufferShmPool&) = delete;
+    SmartBufferShmPool& operator=(const SmartBufferShmPool&) = delete;
+    SmartBufferShmPool& operator=(SmartBufferShmPool&&) = delete;
+
+    ~SmartBufferShmPool() {
+        if (base_ != nullptr) {
+            ::munmap(base_, mapped_size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    /**
+     * @brief Get the segment descriptor (to inherit or pass with SCM_RIGHTS)
+     */
+    int fd() const noexcept { return fd_; }
+
+    constexpr std::size_t block_size() const noexcept { return BlockSize; }
+    std::uint32_t block_count() const noexcept { return header_->block_count; }
+    std::uint32_t ring_capacity() const noexcept { return header_->ring_capacity; }
+
+    /**
+     * @brief Get the number of blocks on the free list
+     */
+    std::uint32_t free_blocks() const noexcept {
+        return header_->free_count.load(std::memory_order_relaxed);
+    }
+
+    // ---- Blocks --------------------------------------------------------------
+
+    /**
+     * @brief Take a free block without blocking
+     */
+    std::optional<Handle> try_allocate() noexcept {
+        std::uint64_t head = header_->free_head.load(std::memory_order_acquire);
+        while (true) {
+            auto index = static_cast<std::uint32_t>(head);
+            if (index == 0) {
+                return std::nullopt;
+            }
+            std::uint32_t next = next_[index - 1].load(std::memory_order_relaxed);
+            std::uint64_t tag = (head >> 32) + 1;  // Defeats ABA
+            if (header_->free_head.compare_exchange_weak(head, (tag << 32) | next,
+                                                         std::memory_order_acquire, std::memory_order_acquire)) {
+                header_->free_count.fetch_sub(1, std::memory_order_relaxed);
+                return Handle{index - 1, 0};
+            }
+        }
+    }
+
+    /**
+     * @brief Take a free block, sleeping until one is freed
+     */
+    Handle allocate() {
+        std::optional<Handle> handle;
+        header_->freed.wait([&] { return (handle = try_allocate()).has_value(); }, nullptr);
+        return *handle;
+    }
+
+    /**
+     * @brief Return a block to the free list (any process may free any block)
+     */
+    void free(Handle handle) noexcept {
+        std::uint32_t index = handle.block + 1;
+        std::uint64_t head = header_->free_head.load(std::memory_order_relaxed);
+        do {
+            next_[handle.block].store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        } while (!header_->free_head.compare_exchange_weak(head, (((head >> 32) + 1) << 32) | index,
+                                                           std::memory_order_release, std::memory_order_relaxed));
+        header_->free_count.fetch_add(1, std::memory_order_relaxed);
+        header_->freed.notify();
+    }
+
+    /**
+     * @brief Get the block's memory in this process's mapping
+     */
+    std::uint8_t* data(Handle handle) noexcept {
+        return blocks_ + static_cast<std::size_t>(handle.block) * BlockSize;
+    }
+
+    const std::uint8_t* data(Handle handle) const noexcept {
+        return blocks_ + static_cast<std::size_t>(handle.block) * BlockSize;
+    }
+
+    /**
+     * @brief Get the block's offset from the start of the segment
+     */
+    std::size_t offset(Handle handle) const noexcept {
+        return static_cast<std::size_t>(blocks_ - static_cast<std::uint8_t*>(base_)) +
+               static_cast<std::size_t>(handle.block) * BlockSize;
+    }
+
+    // ---- Descriptor ring -----------------------------------------------------
+
+    /**
+     * @brief Pass a block to the receiving side without blocking
+     * @param handle Block to send; handle.size tells the receiver how many bytes are used
+     * @return false if the ring is full
+     */
+    bool try_send(Handle handle) noexcept {
+        std::uint64_t mask = header_->ring_capacity - 1;
+        std::uint64_t position = header_->enqueue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = ring_[position & mask];
+            std::uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::int64_t>(sequence - position);
+            if (difference == 0) {
+                if (header_->enqueue_position.compare_exchange_weak(position, position + 1,
+                                                                    std::memory_order_relaxed)) {
+                    cell.descriptor = (static_cast<std::uint64_t>(handle.size) << 32) | handle.block;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    header_->posted.notify();
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = header_->enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pass a block, sleeping while the ring is full
+     */
+    void send(Handle handle) {
+        header_->consumed.wait([&] { return try_send(handle); }, nullptr);
+    }
+
+    /**
+     * @brief Take the next block without blocking
+     */
+    std::optional<Handle> try_receive() noexcept {
+        std::uint64_t mask = header_->ring_capacity - 1;
+        std::uint64_t position = header_->dequeue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = ring_[position & mask];
+            std::uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::int64_t>(sequence - (position + 1));
+            if (difference == 0) {
+                if (header_->dequeue_position.compare_exchange_weak(position, position + 1,
+                                                                    std::memory_order_relaxed)) {
+                    std::uint64_t descriptor = cell.descriptor;
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    header_->consumed.notify();
+                    return Handle{static_cast<std::uint32_t>(descriptor), static_cast<std::uint32_t>(descriptor >> 32)};
+                }
+            } else if (difference < 0) {
+                return std::nullopt;
+            } else {
+                position = header_->dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Take the next block, sleeping while the ring is empty
+     */
+    Handle receive() {
+        std::optional<Handle> handle;
+        header_->posted.wait([&] { return (handle = try_receive()).has_value(); }, nullptr);
+        return *handle;
+    }
+
+    /**
+     * @brief Take the next block, sleeping at most timeout
+     */
+    template<typename Rep, typename Period>
+    std::optional<Handle> receive_for(std::chrono::duration<Rep, Period> timeout) {
+        std::optional<Handle> handle;
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        header_->posted.wait([&] { return (handle = try_receive()).has_value(); }, &deadline);
+        return handle;
+    }
+
+private:
+    static constexpr std::uint64_t MAGIC = 0x534D415254534D31ull;  // "SMARTSM1"
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::size_t PAGE = 4096;
+
+    struct Header {
+        std::atomic<std::uint64_t> magic{0};
+        std::uint32_t block_size = 0;
+        std::uint32_t block_count = 0;
+        std::uint32_t ring_capacity = 0;
+
+        // Free list: Treiber stack of block index + 1 (0 = empty), ABA tag in the high half
+        alignas(CACHE_LINE) std::atomic<std::uint64_t> free_head{0};
+        std::atomic<std::uint32_t> free_count{0};
+        alignas(CACHE_LINE) smart_buffer_detail::ShmEvent freed;
+
+        alignas(CACHE_LINE) std::atomic<std::uint64_t> enqueue_position{0};
+        alignas(CACHE_LINE) std::atomic<std::uint64_t> dequeue_position{0};
+        alignas(CACHE_LINE) smart_buffer_detail::ShmEvent posted;     // Descriptor sent
+        alignas(CACHE_LINE) smart_buffer_detail::ShmEvent consumed;   // Ring slot freed
+    };
+
+    struct Cell {
+        std::atomic<std::uint64_t> sequence{0};
+        std::uint64_t descriptor = 0;   // size << 32 | block
+    };
+
+    struct Layout {
+        std::size_t next_offset;
+        std::size_t ring_offset;
+        std::size_t blocks_offset;
+        std::size_t total;
+
+        static std::size_t align(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        static Layout compute(std::uint32_t block_count, std::uint32_t ring_capacity) {
+            Layout layout{};
+            layout.next_offset = align(sizeof(Header), CACHE_LINE);
+            layout.ring_offset = align(layout.next_offset + block_count * sizeof(std::atomic<std::uint32_t>), CACHE_LINE);
+            layout.blocks_offset = align(layout.ring_offset + ring_capacity * sizeof(Cell), PAGE);
+            layout.total = layout.blocks_offset + static_cast<std::size_t>(block_count) * BlockSize;
+            return layout;
+        }
+    };
+
+    SmartBufferShmPool(int fd, std::size_t size) : fd_(fd), mapped_size_(size) {
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            fd_ = -1;
+            throw_errno("mmap", error);
+        }
+        base_ = base;
+    }
+
+    void bind(const Layout& layout) noexcept {
+        auto* bytes = static_cast<std::uint8_t*>(base_);
+        header_ = static_cast<Header*>(base_);
+        next_ = reinterpret_cast<std::atomic<std::uint32_t>*>(bytes + layout.next_offset);
+        ring_ = reinterpret_cast<Cell*>(bytes + layout.ring_offset);
+        blocks_ = bytes + layout.blocks_offset;
+    }
+
+    [[noreturn]] static void throw_errno(const char* what, int error = errno) {
+        throw std::system_error(error, std::generic_category(), std::string("SmartBufferShmPool: ") + what);
+    }
+
+    int fd_ = -1;
+    std::size_t mapped_size_ = 0;
+    void* base_ = nullptr;
+    Header* header_ = nullptr;
+    std::atomic<std::uint32_t>* next_ = nullptr;
+    Cell* ring_ = nullptr;
+    std::uint8_t* blocks_ = nullptr;
+};
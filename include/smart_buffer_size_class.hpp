@@ -0,0 +1,335 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief A buffer whose length is a runtime value, stored in the smallest of a fixed
+ *        set of compile-time size classes.
+ *
+ * @tparam Classes Strictly increasing SmartBuffer sizes (e.g. 16, 32, 64 ... 65536)
+ *
+ * The matching SmartBuffer lives in a compact tagged union. fill, copy,
+ * compare and hash dispatch through a per-class jump table to kernels that see the
+ * class size as a compile-time constant, so they compile to fixed-length word loops
+ * instead of generic runtime-length loops.
+ *
+ * Bytes between size() and capacity() are kept zero, which lets compare and hash
+ * work on the whole class.
+ *
+ * Classes up to INLINE_LIMIT (256) bytes are stored inline in the object, so small
+ * payloads never allocate; the object is therefore as large as the largest inline
+ * class. Larger classes keep their bytes on the heap (or the scoped resource), which
+ * costs one allocation per construction; benchmark_size_class measures it.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t... Classes>
+class SmartBufferSizeClass {
+    static_assert(sizeof...(Classes) > 0, "At least one size class is required");
+    static_assert(sizeof...(Classes) < 255, "Too many size classes");
+
+    static constexpr std::array<std::size_t, sizeof...(Classes)> CLASS_SIZES = {Classes...};
+
+    static constexpr bool strictly_increasing() noexcept {
+        for (std::size_t i = 1; i < CLASS_SIZES.size(); ++i) {
+            if (CLASS_SIZES[i] <= CLASS_SIZES[i - 1]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    static_assert(strictly_increasing(), "Size classes must be strictly increasing");
+
+public:
+    /**
+     * @brief Classes up to this many bytes are stored inline, larger ones on the heap
+     */
+    static constexpr std::size_t INLINE_LIMIT = 256;
+
+private:
+    template<std::size_t Class>
+    using ClassBuffer = SmartBuffer<Class, INLINE_LIMIT>;
+
+    static_assert((smart_buffer_trivially_relocatable_v<ClassBuffer<Classes>> && ...),
+                  "Size class buffers are relocated with memcpy");
+
+    static constexpr std::size_t STORAGE_SIZE = std::max({sizeof(ClassBuffer<Classes>)...});
+    static constexpr std::size_t STORAGE_ALIGN = std::max({alignof(ClassBuffer<Classes>)...});
+    static constexpr std::uint8_t EMPTY = 0xFF;
+
+    // Per-class kernels; the class size is a compile-time constant in each
+    template<std::size_t Class>
+    struct Kernels {
+        using Buffer = ClassBuffer<Class>;
+
+        static Buffer& get(void* storage) noexcept { return *std::launder(static_cast<Buffer*>(storage)); }
+        static const Buffer& get(const void* storage) noexcept {
+            return *std::launder(static_cast<const Buffer*>(storage));
+        }
+
+        static std::uint8_t* construct(void* storage) {
+            return (::new (storage) Buffer())->data();
+        }
+        static std::uint8_t* copy_construct(void* storage, const void* other) {
+            return (::new (storage) Buffer(get(other)))->data();
+        }
+        static void copy_assign(void* storage, const void* other) {
+            std::memcpy(get(storage).data(), get(other).data(), Class);
+        }
+        static void destroy(void* storage) noexcept {
+            get(storage).~Buffer();
+        }
+        static void fill(void* storage, std::uint8_t value, std::size_t length) noexcept {
+            std::uint8_t* bytes = get(storage).data();
+            std::memset(bytes, value, Class);
+            std::memset(bytes + length, 0, Class - length);
+        }
+        static bool equal(const void* a, const void* b) noexcept {
+            if constexpr (Class <= 256) {
+                return smart_buffer_detail::equal_fixed<Class>(get(a).data(), get(b).data());
+            } else {
+                // Large classes: libc memcmp with a constant length exits early on mismatch
+                return std::memcmp(get(a).data(), get(b).data(), Class) == 0;
+            }
+        }
+        static std::uint64_t hash(const void* storage, std::uint64_t seed) noexcept {
+            return smart_buffer_detail::xxh64(get(storage).data(), Class, seed);
+        }
+    };
+
+    struct Ops {
+        std::uint8_t* (*construct)(void*);
+        std::uint8_t* (*copy_construct)(void*, const void*);
+        void (*copy_assign)(void*, const void*);
+        void (*destroy)(void*) noexcept;
+        void (*fill)(void*, std::uint8_t, std::size_t) noexcept;
+        bool (*equal)(const void*, const void*) noexcept;
+        std::uint64_t (*hash)(const void*, std::uint64_t) noexcept;
+    };
+
+    // Jump table indexed by size class
+    static constexpr Ops OPS[] = {
+        {&Kernels<Classes>::construct, &Kernels<Classes>::copy_construct, &Kernels<Classes>::copy_assign,
+         &Kernels<Classes>::destroy, &Kernels<Classes>::fill, &Kernels<Classes>::equal,
+         &Kernels<Classes>::hash}...};
+
+public:
+    /**
+     * @brief Number of configured size classes
+     */
+    static constexpr std::size_t class_count() noexcept { return sizeof...(Classes); }
+
+    /**
+     * @brief Largest length this buffer type can hold
+     */
+    static constexpr std::size_t max_size() noexcept { return CLASS_SIZES.back(); }
+
+    /**
+     * @brief Index of the smallest class that can hold length bytes
+     * @throws std::length_error if length exceeds max_size()
+     */
+    static std::size_t class_index_for(std::size_t length) {
+        auto it = std::lower_bound(CLASS_SIZES.begin(), CLASS_SIZES.end(), length);
+        if (it == CLASS_SIZES.end()) {
+            throw std::length_error("SmartBufferSizeClass: length exceeds largest size class");
+        }
+        return static_cast<std::size_t>(it - CLASS_SIZES.begin());
+    }
+
+    /**
+     * @brief Default constructor (zero-length buffer in the smallest class)
+     */
+    SmartBufferSizeClass() : SmartBufferSizeClass(std::size_t{0}) {}
+
+    /**
+     * @brief Construct a zero-initialized buffer of length bytes
+     */
+    explicit SmartBufferSizeClass(std::size_t length) {
+        index_ = static_cast<std::uint8_t>(class_index_for(length));
+        data_ = OPS[index_].construct(&storage_);
+        length_ = length;
+    }
+
+    /**
+     * @brief Construct a buffer holding a copy of length bytes from source
+     */
+    SmartBufferSizeClass(const void* source, std::size_t length) : SmartBufferSizeClass(length) {
+        std::memcpy(data_, source, length);
+    }
+
+    /**
+     * @brief Copy constructor
+     */
+    SmartBufferSizeClass(const SmartBufferSizeClass& other) {
+        if (other.index_ != EMPTY) {
+            data_ = OPS[other.index_].copy_construct(&storage_, &other.storage_);
+        }
+        index_ = other.index_;
+        length_ = other.length_;
+    }
+
+    /**
+     * @brief Move constructor (relocates the held SmartBuffer, leaves other empty)
+     */
+    SmartBufferSizeClass(SmartBufferSizeClass&& other) noexcept {
+        take(other);
+    }
+
+    /**
+     * @brief Copy assignment operator (reuses storage when the class matches)
+     */
+    SmartBufferSizeClass& operator=(const SmartBufferSizeClass& other) {
+        if (this != &other) {
+            if (index_ == other.index_ && index_ != EMPTY) {
+                OPS[index_].copy_assign(&storage_, &other.storage_);
+                length_ = other.length_;
+            } else {
+                SmartBufferSizeClass copy(other);
+                reset();
+                take(copy);
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator
+     */
+    SmartBufferSizeClass& operator=(SmartBufferSizeClass&& other) noexcept {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~SmartBufferSizeClass() {
+        reset();
+    }
+
+    /**
+     * @brief Replace the contents with length bytes from source, reusing the
+     *        current storage when the size class does not change
+     */
+    void assign(const void* source, std::size_t length) {
+        std::size_t index = class_index_for(length);
+        if (index != index_) {
+            // Copied before reset(): source may point into the storage being replaced
+            SmartBufferSizeClass replacement(source, length);
+            reset();
+            take(replacement);
+            return;
+        }
+        std::memmove(data_, source, length);   // source may overlap our own bytes
+        std::memset(data_ + length, 0, capacity() - length);
+        length_ = length;
+    }
+
+    std::uint8_t* data() noexcept { return data_; }
+    const std::uint8_t* data() const noexcept { return data_; }
+
+    /**
+     * @brief Logical length in bytes
+     */
+    std::size_t size() const noexcept { return length_; }
+
+    /**
+     * @brief Size of the selected class in bytes
+     */
+    std::size_t capacity() const noexcept { return index_ == EMPTY ? 0 : CLASS_SIZES[index_]; }
+
+    /**
+     * @brief Index of the selected size class
+     */
+    std::size_t class_index() const noexcept { return index_; }
+
+    /**
+     * @brief Check if the bytes are stored inside this object rather than on the heap
+     */
+    bool is_inline() const noexcept {
+        auto* begin = reinterpret_cast<const std::uint8_t*>(&storage_);
+        return data_ >= begin && data_ < begin + STORAGE_SIZE;
+    }
+
+    std::uint8_t& operator[](std::size_t index) { return data_[index]; }
+    const std::uint8_t& operator[](std::size_t index) const { return data_[index]; }
+
+    /**
+     * @brief Fill the logical length with value (the class tail stays zero)
+     */
+    void fill(std::uint8_t value) noexcept {
+        if (index_ != EMPTY) {
+            OPS[index_].fill(&storage_, value, length_);
+        }
+    }
+
+    void clear() noexcept { fill(0); }
+
+    /**
+     * @brief Hash of the contents, dispatched to the class-specialized XXH64 kernel
+     */
+    std::uint64_t hash(std::uint64_t seed = 0) const noexcept {
+        if (index_ == EMPTY) {
+            return smart_buffer_hash_bytes(nullptr, 0, seed);
+        }
+        return OPS[index_].hash(&storage_, seed ^ length_);
+    }
+
+    friend bool operator==(const SmartBufferSizeClass& a, const SmartBufferSizeClass& b) noexcept {
+        if (a.length_ != b.length_ || a.index_ != b.index_) {
+            return false;
+        }
+        return a.index_ == EMPTY || OPS[a.index_].equal(&a.storage_, &b.storage_);
+    }
+
+    friend bool operator!=(const SmartBufferSizeClass& a, const SmartBufferSizeClass& b) noexcept {
+        return !(a == b);
+    }
+
+private:
+    void reset() noexcept {
+        if (index_ != EMPTY) {
+            OPS[index_].destroy(&storage_);
+            index_ = EMPTY;
+            data_ = nullptr;
+            length_ = 0;
+        }
+    }
+
+    // Relocate other's SmartBuffer into our (empty) storage with memcpy
+    void take(SmartBufferSizeClass& other) noexcept {
+        std::memcpy(&storage_, &other.storage_, STORAGE_SIZE);
+        index_ = other.index_;
+        length_ = other.length_;
+        data_ = other.data_;
+        auto* other_begin = reinterpret_cast<std::uint8_t*>(&other.storage_);
+        if (data_ >= other_begin && data_ < other_begin + STORAGE_SIZE) {
+            // Static classes keep their bytes inline, so the data pointer moves with them
+            data_ = reinterpret_cast<std::uint8_t*>(&storage_) + (data_ - other_begin);
+        }
+        other.index_ = EMPTY;
+        other.data_ = nullptr;
+        other.length_ = 0;
+    }
+
+    alignas(STORAGE_ALIGN) unsigned char storage_[STORAGE_SIZE];
+    std::uint8_t* data_ = nullptr;
+    std::size_t length_ = 0;
+    std::uint8_t index_ = EMPTY;
+};
+
+/**
+ * @brief Power-of-two size classes from 16 bytes to 64 KiB
+ */
+using SmartBufferSizeClassPow2 = SmartBufferSizeClass<16, 32, 64, 128, 256, 512, 1024, 2048, 4096,
+                                                      8192, 16384, 32768, 65536>;
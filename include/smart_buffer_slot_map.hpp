@@ -0,0 +1,216 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A container of SmartBuffers addressed by generational handles, stored densely.
+ *
+ * @tparam Size Buffer size in bytes
+ * @tparam Key Handle type, std::uint32_t (20-bit index, 12-bit generation) or
+ *             std::uint64_t (32-bit index, 32-bit generation)
+ *
+ * Buffers live in one contiguous array with no holes, so scanning them is a linear
+ * walk. Handles go through a slot table: the slot holds the buffer's position in the
+ * dense array and a generation that is bumped when the buffer is erased, so a handle to
+ * an erased buffer is detected instead of dangling. Insertion reuses slots from a free
+ * list; erasure moves the last buffer into the hole. Both are O(1).
+ *
+ * A slot's generation is odd while it holds a buffer and even while it is free, and
+ * only odd generations are looked up, so no handle ever reaches a free slot. Live
+ * generations start at 1, so the handle 0 is never issued and can be used as a null
+ * handle. With 32-bit handles a slot's generation wraps after 2048 reuses, after which
+ * a very old handle could match the slot's new buffer again. Erasing moves the last
+ * buffer, which invalidates references to it but never its handle.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t Size, typename Key = std::uint64_t>
+class SmartBufferSlotMap {
+    static_assert(std::is_same<Key, std::uint32_t>::value || std::is_same<Key, std::uint64_t>::value,
+                  "SmartBufferSlotMap: Key must be std::uint32_t or std::uint64_t");
+
+public:
+    using Buffer = SmartBuffer<Size>;
+    using key_type = Key;
+    using iterator = typename std::vector<Buffer>::iterator;
+    using const_iterator = typename std::vector<Buffer>::const_iterator;
+
+    static constexpr unsigned INDEX_BITS = sizeof(Key) == 4 ? 20 : 32;
+    static constexpr Key INDEX_MASK = (Key(1) << INDEX_BITS) - 1;
+    static constexpr Key GENERATION_MASK = std::numeric_limits<Key>::max() >> INDEX_BITS;
+    static constexpr std::size_t MAX_SIZE = INDEX_MASK;   // Index INDEX_MASK ends the free list
+
+    SmartBufferSlotMap() = default;
+
+    /**
+     * @brief Insert a buffer
+     * @return Its handle
+     * @throws std::length_error if MAX_SIZE slots are already in use
+     */
+    Key insert(Buffer buffer) {
+        Key slot_index = acquire_slot();
+        Slot& slot = slots_[slot_index];
+        slot.position = static_cast<Key>(values_.size());
+        values_.push_back(std::move(buffer));
+        slot_of_.push_back(slot_index);
+        return make_key(slot_index, slot.generation);
+    }
+
+    /**
+     * @brief Insert a default-constructed buffer
+     * @return Its handle
+     */
+    Key emplace() {
+        return insert(Buffer());
+    }
+
+    /**
+     * @brief Erase the buffer of a handle
+     * @return false if the handle is stale or null
+     */
+    bool erase(Key key) {
+        Slot* slot = lookup(key);
+        if (slot == nullptr) {
+            return false;
+        }
+        Key position = slot->position;
+        Key last = static_cast<Key>(values_.size() - 1);
+        if (position != last) {
+            values_[position] = std::move(values_[last]);
+            slot_of_[position] = slot_of_[last];
+            slots_[slot_of_[position]].position = position;
+        }
+        values_.pop_back();
+        slot_of_.pop_back();
+
+        // Retire the generation: even marks the slot free
+        slot->generation = (slot->generation + 1) & GENERATION_MASK;
+        slot->position = free_head_;
+        free_head_ = key & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Get the buffer of a handle
+     * @return nullptr if the handle is stale or null
+     */
+    Buffer* find(Key key) noexcept {
+        const Slot* slot = lookup(key);
+        return slot != nullptr ? &values_[slot->position] : nullptr;
+    }
+
+    const Buffer* find(Key key) const noexcept {
+        const Slot* slot = lookup(key);
+        return slot != nullptr ? &values_[slot->position] : nullptr;
+    }
+
+    bool contains(Key key) const noexcept {
+        return lookup(key) != nullptr;
+    }
+
+    /**
+     * @brief Get the buffer of a handle
+     * @throws std::out_of_range if the handle is stale or null
+     */
+    Buffer& at(Key key) {
+        Buffer* buffer = find(key);
+        if (buffer == nullptr) {
+            throw std::out_of_range("SmartBufferSlotMap: stale or null handle");
+        }
+        return *buffer;
+    }
+
+    /**
+     * @brief Get the handle of the buffer at a position of the dense array
+     */
+    Key key_at(std::size_t position) const noexcept {
+        Key slot_index = slot_of_[position];
+        return make_key(slot_index, slots_[slot_index].generation);
+    }
+
+    /**
+     * @brief Reserve room for count buffers without reallocating
+     */
+    void reserve(std::size_t count) {
+        values_.reserve(count);
+        slot_of_.reserve(count);
+        slots_.reserve(count);
+    }
+
+    /**
+     * @brief Erase every buffer; every handle issued so far becomes stale
+     */
+    void clear() {
+        while (!values_.empty()) {
+            erase(key_at(values_.size() - 1));
+        }
+    }
+
+    std::size_t size() const noexcept { return values_.size(); }
+    bool empty() const noexcept { return values_.empty(); }
+
+    // Dense iteration, in no particular order
+    iterator begin() noexcept { return values_.begin(); }
+    iterator end() noexcept { return values_.end(); }
+    const_iterator begin() const noexcept { return values_.begin(); }
+    const_iterator end() const noexcept { return values_.end(); }
+
+    Buffer* data() noexcept { return values_.data(); }
+    const Buffer* data() const noexcept { return values_.data(); }
+
+private:
+    struct Slot {
+        Key position;     // Dense index when live, next free slot when free
+        Key generation;
+    };
+
+    static Key make_key(Key slot_index, Key generation) noexcept {
+        return static_cast<Key>((generation << INDEX_BITS) | slot_index);
+    }
+
+    Slot* lookup(Key key) noexcept {
+        return const_cast<Slot*>(static_cast<const SmartBufferSlotMap*>(this)->lookup(key));
+    }
+
+    const Slot* lookup(Key key) const noexcept {
+        Key slot_index = key & INDEX_MASK;
+        if (slot_index >= slots_.size()) {
+            return nullptr;
+        }
+        // Free slots have even generations, and their position links the free list
+        Key generation = key >> INDEX_BITS;
+        if ((generation & 1) == 0) {
+            return nullptr;
+        }
+        const Slot& slot = slots_[slot_index];
+        return slot.generation == generation ? &slot : nullptr;
+    }
+
+    Key acquire_slot() {
+        if (free_head_ != INDEX_MASK) {
+            Key slot_index = free_head_;
+            Slot& slot = slots_[slot_index];
+            free_head_ = slot.position;
+            slot.generation = (slot.generation + 1) & GENERATION_MASK;   // Odd again: live
+            return slot_index;
+        }
+        if (slots_.size() >= MAX_SIZE) {
+            throw std::length_error("SmartBufferSlotMap: too many slots");
+        }
+        slots_.push_back(Slot{0, 1});
+        return static_cast<Key>(slots_.size() - 1);
+    }
+
+    std::vector<Buffer> values_;   // Dense
+    std::vector<Key> slot_of_;     // Dense index -> slot index
+    std::vector<Slot> slots_;
+    Key free_head_ = INDEX_MASK;
+};
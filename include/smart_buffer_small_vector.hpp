@@ -0,0 +1,527 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace smart_buffer_detail {
+
+/**
+ * @brief Move count elements from src to uninitialized dst and end their lifetime in src
+ *
+ * One memcpy when T is trivially relocatable, move-construct + destroy otherwise.
+ */
+template<typename T>
+void relocate_elements(T* dst, T* src, std::size_t count) noexcept {
+    if constexpr (smart_buffer_trivially_relocatable_v<T>) {
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+        }
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            ::new (static_cast<void*>(dst + i)) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief A vector with inline capacity that relocates elements with memcpy.
+ *
+ * @tparam T Element type
+ * @tparam InlineCapacity Number of elements stored inside the object before spilling to the heap
+ *
+ * When smart_buffer_trivially_relocatable_v<T> holds (all SmartBuffer instantiations),
+ * growth, moves and erasure shift elements with a single bulk memcpy/memmove instead of
+ * calling the move constructor and destructor per element. Other types fall back to
+ * move-construct + destroy.
+ *
+ * @requires C++17 or later
+ */
+template<typename T, std::size_t InlineCapacity = 8>
+class SmartBufferSmallVector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief Whether elements are relocated with memcpy
+     */
+    static constexpr bool relocates_bitwise = smart_buffer_trivially_relocatable_v<T>;
+
+    SmartBufferSmallVector() noexcept = default;
+
+    /**
+     * @brief Construct with count default-initialized elements
+     */
+    explicit SmartBufferSmallVector(size_type count) {
+        resize(count);
+    }
+
+    SmartBufferSmallVector(std::initializer_list<T> init) {
+        reserve(init.size());
+        for (const T& value : init) {
+            push_back(value);
+        }
+    }
+
+    /**
+     * @brief Copy constructor
+     */
+    SmartBufferSmallVector(const SmartBufferSmallVector& other) {
+        reserve(other.size_);
+        for (const T& value : other) {
+            push_back(value);
+        }
+    }
+
+    /**
+     * @brief Move constructor (steals heap storage or relocates inline elements)
+     */
+    SmartBufferSmallVector(SmartBufferSmallVector&& other) noexcept {
+        take(other);
+    }
+
+    /**
+     * @brief Copy assignment operator
+     */
+    SmartBufferSmallVector& operator=(const SmartBufferSmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (const T& value : other) {
+                push_back(value);
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator
+     */
+    SmartBufferSmallVector& operator=(SmartBufferSmallVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release_heap();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~SmartBufferSmallVector() {
+        clear();
+        release_heap();
+    }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Check if the elements currently live in the inline storage
+     */
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    T& operator[](size_type index) { return data_[index]; }
+    const T& operator[](size_type index) const { return data_[index]; }
+
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    /**
+     * @brief Ensure capacity for at least new_capacity elements
+     */
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity_) {
+            reallocate(new_capacity);
+        }
+    }
+
+    /**
+     * @brief Construct an element in place at the end
+     */
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            return grow_and_emplace_back(std::forward<Args>(args)...);
+        }
+        T* slot = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        --size_;
+        data_[size_].~T();
+    }
+
+    /**
+     * @brief Remove the element at pos, shifting the tail down
+     * @return Iterator to the element following the erased one
+     */
+    iterator erase(const_iterator pos) {
+        T* target = data_ + (pos - data_);
+        target->~T();
+        size_type tail = static_cast<size_type>(end() - target) - 1;
+        if constexpr (relocates_bitwise) {
+            std::memmove(static_cast<void*>(target), static_cast<const void*>(target + 1), tail * sizeof(T));
+        } else {
+            for (size_type i = 0; i < tail; ++i) {
+                ::new (static_cast<void*>(target + i)) T(std::move(target[i + 1]));
+                target[i + 1].~T();
+            }
+        }
+        --size_;
+        return target;
+    }
+
+    /**
+     * @brief Resize to count elements, default-constructing new ones
+     */
+    void resize(size_type count) {
+        reserve(count);
+        while (size_ > count) {
+            pop_back();
+        }
+        while (size_ < count) {
+            emplace_back();
+        }
+    }
+
+    /**
+     * @brief Destroy all elements (capacity is retained)
+     */
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < size_; ++i) {
+                data_[i].~T();
+            }
+        }
+        size_ = 0;
+    }
+
+private:
+    T* inline_data() noexcept { return reinterpret_cast<T*>(inline_storage_); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_storage_); }
+
+    /**
+     * @brief Move count elements from src to uninitialized dst and end their lifetime in src
+     */
+    static void relocate(T* dst, T* src, size_type count) noexcept {
+        static_assert(relocates_bitwise || std::is_nothrow_move_constructible_v<T>,
+                      "SmartBufferSmallVector requires nothrow-movable elements");
+        smart_buffer_detail::relocate_elements(dst, src, count);
+    }
+
+    void reallocate(size_type new_capacity) {
+        adopt(std::allocator<T>().allocate(new_capacity), new_capacity);
+    }
+
+    /**
+     * @brief Append into a larger allocation
+     *
+     * The new element is constructed before the old ones move, so arguments that refer
+     * to elements of this vector are still valid when they are read.
+     */
+    template<typename... Args>
+    T& grow_and_emplace_back(Args&&... args) {
+        size_type new_capacity = std::max<size_type>(capacity_ * 2, 4);
+        T* new_data = std::allocator<T>().allocate(new_capacity);
+        T* slot;
+        try {
+            slot = ::new (static_cast<void*>(new_data + size_)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator<T>().deallocate(new_data, new_capacity);
+            throw;
+        }
+        adopt(new_data, new_capacity);
+        ++size_;
+        return *slot;
+    }
+
+    /**
+     * @brief Relocate the elements into new_data and free the old heap block
+     */
+    void adopt(T* new_data, size_type new_capacity) noexcept {
+        relocate(new_data, data_, size_);
+        release_heap();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    void release_heap() noexcept {
+        if (!is_inline()) {
+            std::allocator<T>().deallocate(data_, capacity_);
+            data_ = inline_data();
+            capacity_ = InlineCapacity;
+        }
+    }
+
+    void take(SmartBufferSmallVector& other) noexcept {
+        if (other.is_inline()) {
+            relocate(data_, other.data_, other.size_);
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.capacity_ = InlineCapacity;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    alignas(T) unsigned char inline_storage_[InlineCapacity == 0 ? 1 : InlineCapacity * sizeof(T)];
+    T* data_ = inline_data();
+    size_type size_ = 0;
+    size_type capacity_ = InlineCapacity;
+};
+
+/**
+ * @brief A double-ended queue on a growable ring that relocates elements with memcpy.
+ *
+ * @tparam T Element type
+ *
+ * Elements live in one power-of-two ring, so push and pop at either end are O(1) and
+ * indexing is a mask. When the ring is full it doubles: the two halves of the wrapped
+ * contents are relocated into the new ring, which is two bulk memcpy calls when
+ * smart_buffer_trivially_relocatable_v<T> holds (all SmartBuffer instantiations).
+ * Other types fall back to move-construct + destroy per element.
+ *
+ * @requires C++17 or later
+ */
+template<typename T>
+class SmartBufferDeque {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    /**
+     * @brief Whether elements are relocated with memcpy
+     */
+    static constexpr bool relocates_bitwise = smart_buffer_trivially_relocatable_v<T>;
+
+    SmartBufferDeque() noexcept = default;
+
+    /**
+     * @brief Copy constructor
+     */
+    SmartBufferDeque(const SmartBufferDeque& other) {
+        reserve(other.size_);
+        for (size_type i = 0; i < other.size_; ++i) {
+            push_back(other[i]);
+        }
+    }
+
+    /**
+     * @brief Move constructor (steals the ring)
+     */
+    SmartBufferDeque(SmartBufferDeque&& other) noexcept {
+        take(other);
+    }
+
+    /**
+     * @brief Copy assignment operator
+     */
+    SmartBufferDeque& operator=(const SmartBufferDeque& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (size_type i = 0; i < other.size_; ++i) {
+                push_back(other[i]);
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator
+     */
+    SmartBufferDeque& operator=(SmartBufferDeque&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~SmartBufferDeque() {
+        clear();
+        release();
+    }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    T& operator[](size_type index) { return data_[(head_ + index) & (capacity_ - 1)]; }
+    const T& operator[](size_type index) const { return data_[(head_ + index) & (capacity_ - 1)]; }
+
+    T& front() { return data_[head_]; }
+    const T& front() const { return data_[head_]; }
+    T& back() { return (*this)[size_ - 1]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    /**
+     * @brief Ensure capacity for at least new_capacity elements (rounded up to a power of two)
+     */
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity_) {
+            size_type rounded = MIN_CAPACITY;
+            while (rounded < new_capacity) {
+                rounded *= 2;
+            }
+            T* new_data = std::allocator<T>().allocate(rounded);
+            adopt(new_data, rounded, 0);
+        }
+    }
+
+    /**
+     * @brief Construct an element in place at the back
+     */
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            return grow_and_emplace(false, std::forward<Args>(args)...);
+        }
+        T* slot = ::new (static_cast<void*>(&(*this)[size_])) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    /**
+     * @brief Construct an element in place at the front
+     */
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+        if (size_ == capacity_) {
+            return grow_and_emplace(true, std::forward<Args>(args)...);
+        }
+        size_type head = (head_ + capacity_ - 1) & (capacity_ - 1);
+        T* slot = ::new (static_cast<void*>(data_ + head)) T(std::forward<Args>(args)...);
+        head_ = head;
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    void pop_back() {
+        back().~T();
+        --size_;
+    }
+
+    void pop_front() {
+        data_[head_].~T();
+        head_ = (head_ + 1) & (capacity_ - 1);
+        --size_;
+    }
+
+    /**
+     * @brief Destroy all elements (capacity is retained)
+     */
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < size_; ++i) {
+                (*this)[i].~T();
+            }
+        }
+        head_ = 0;
+        size_ = 0;
+    }
+
+private:
+    static constexpr size_type MIN_CAPACITY = 8;
+
+    /**
+     * @brief Insert into a ring of twice the capacity
+     *
+     * The new element is constructed before the old ones move, so arguments that refer
+     * to elements of this deque are still valid when they are read.
+     */
+    template<typename... Args>
+    T& grow_and_emplace(bool at_front, Args&&... args) {
+        size_type new_capacity = std::max(capacity_ * 2, MIN_CAPACITY);
+        T* new_data = std::allocator<T>().allocate(new_capacity);
+        T* slot = new_data + (at_front ? 0 : size_);
+        try {
+            ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator<T>().deallocate(new_data, new_capacity);
+            throw;
+        }
+        adopt(new_data, new_capacity, at_front ? 1 : 0);
+        ++size_;
+        return *slot;
+    }
+
+    /**
+     * @brief Unwrap the ring into new_data starting at offset and free the old ring
+     */
+    void adopt(T* new_data, size_type new_capacity, size_type offset) noexcept {
+        static_assert(relocates_bitwise || std::is_nothrow_move_constructible_v<T>,
+                      "SmartBufferDeque requires nothrow-movable elements");
+        size_type first = std::min(size_, capacity_ - head_);
+        smart_buffer_detail::relocate_elements(new_data + offset, data_ + head_, first);
+        smart_buffer_detail::relocate_elements(new_data + offset + first, data_, size_ - first);
+        release();
+        data_ = new_data;
+        capacity_ = new_capacity;
+        head_ = 0;
+    }
+
+    void release() noexcept {
+        if (data_ != nullptr) {
+            std::allocator<T>().deallocate(data_, capacity_);
+            data_ = nullptr;
+            capacity_ = 0;
+        }
+    }
+
+    void take(SmartBufferDeque& other) noexcept {
+        data_ = other.data_;
+        capacity_ = other.capacity_;
+        head_ = other.head_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.capacity_ = 0;
+        other.head_ = 0;
+        other.size_ = 0;
+    }
+
+    T* data_ = nullptr;
+    size_type capacity_ = 0;
+    size_type head_ = 0;
+    size_type size_ = 0;
+};
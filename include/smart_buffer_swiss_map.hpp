@@ -0,0 +1,406 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_hash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SMART_BUFFER_SWISS_SSE2 1
+#else
+#define SMART_BUFFER_SWISS_SSE2 0
+#endif
+
+namespace smart_buffer_detail {
+
+// Control bytes: 0..127 mark a full slot and hold 7 bits of its hash
+inline constexpr std::int8_t SWISS_EMPTY = -128;    // 0x80
+inline constexpr std::int8_t SWISS_DELETED = -2;    // 0xFE
+inline constexpr std::size_t SWISS_GROUP = 16;
+
+/**
+ * @brief Sixteen control bytes probed at once
+ */
+struct SwissGroup {
+#if SMART_BUFFER_SWISS_SSE2
+    explicit SwissGroup(const std::int8_t* ctrl) noexcept
+        : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    // Bit i is set if control byte i equals h2
+    std::uint32_t match(std::int8_t h2) const noexcept {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h2))));
+    }
+
+    std::uint32_t match_empty() const noexcept {
+        return match(SWISS_EMPTY);
+    }
+
+    // Empty and deleted are the only control bytes with the high bit set
+    std::uint32_t match_empty_or_deleted() const noexcept {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+    }
+
+    __m128i bytes;
+#else
+    explicit SwissGroup(const std::int8_t* ctrl) noexcept {
+        std::memcpy(bytes, ctrl, SWISS_GROUP);
+    }
+
+    std::uint32_t match(std::int8_t h2) const noexcept {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < SWISS_GROUP; ++i) {
+            mask |= static_cast<std::uint32_t>(bytes[i] == h2) << i;
+        }
+        return mask;
+    }
+
+    std::uint32_t match_empty() const noexcept {
+        return match(SWISS_EMPTY);
+    }
+
+    std::uint32_t match_empty_or_deleted() const noexcept {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < SWISS_GROUP; ++i) {
+            mask |= static_cast<std::uint32_t>(bytes[i] < 0) << i;
+        }
+        return mask;
+    }
+
+    std::int8_t bytes[SWISS_GROUP];
+#endif
+};
+
+inline unsigned lowest_bit(std::uint32_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned bit = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief Open-addressing hash map keyed by fixed-size SmartBuffers (Swiss table layout).
+ *
+ * @tparam KeySize Key size in bytes
+ * @tparam Value Mapped type (must be move constructible)
+ * @tparam Hash Called as Hash{}(key) on any SmartBuffer<KeySize, T>; must depend only on
+ *              the first KeySize bytes (SmartBufferHash does)
+ *
+ * Keys are stored inline in the slot array as SmartBufferAlwaysStatic<KeySize>, so an
+ * entry costs no allocation and a lookup touches one control group and usually one
+ * slot. Each slot has a control byte holding 7 bits of the key's hash; a probe compares
+ * a group of 16 control bytes against them with one SSE2 compare (a scalar loop on other
+ * targets) and only compares keys, word by word with a size-specialized loop, on a
+ * match. The table grows at 7/8 load.
+ *
+ * Lookups accept any SmartBuffer<KeySize, T>, whatever its static threshold.
+ * Inserting or erasing invalidates pointers returned by find().
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t KeySize, typename Value, typename Hash = SmartBufferHash>
+class SmartBufferSwissMap {
+public:
+    using Key = SmartBufferAlwaysStatic<KeySize>;
+    using mapped_type = Value;
+
+    SmartBufferSwissMap() = default;
+
+    explicit SmartBufferSwissMap(std::size_t capacity) {
+        reserve(capacity);
+    }
+
+    SmartBufferSwissMap(const SmartBufferSwissMap&) = delete;
+    SmartBufferSwissMap& operator=(const SmartBufferSwissMap&) = delete;
+
+    SmartBufferSwissMap(SmartBufferSwissMap&& other) noexcept
+        : ctrl_(std::move(other.ctrl_)), slots_(std::exchange(other.slots_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)), size_(std::exchange(other.size_, 0)),
+          growth_left_(std::exchange(other.growth_left_, 0)) {}
+
+    ~SmartBufferSwissMap() {
+        destroy_slots();
+    }
+
+    /**
+     * @brief Find the value of a key
+     * @return nullptr if the key is absent
+     */
+    template<std::size_t Size, std::size_t Threshold>
+    Value* find(const SmartBuffer<Size, Threshold>& key) noexcept {
+        static_assert(Size == KeySize, "SmartBufferSwissMap: key size mismatch");
+        std::size_t index = find_index(key.data(), hash(key));
+        return index != NOT_FOUND ? &slots_[index].value : nullptr;
+    }
+
+    template<std::size_t Size, std::size_t Threshold>
+    const Value* find(const SmartBuffer<Size, Threshold>& key) const noexcept {
+        return const_cast<SmartBufferSwissMap*>(this)->find(key);
+    }
+
+    template<std::size_t Size, std::size_t Threshold>
+    bool contains(const SmartBuffer<Size, Threshold>& key) const noexcept {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Insert a key with a value constructed from args, unless the key is present
+     * @return The value for the key, and whether it was inserted
+     */
+    template<std::size_t Size, std::size_t Threshold, typename... Args>
+    std::pair<Value*, bool> try_emplace(const SmartBuffer<Size, Threshold>& key, Args&&... args) {
+        static_assert(Size == KeySize, "SmartBufferSwissMap: key size mismatch");
+        std::size_t h = hash(key);
+        std::size_t index = find_index(key.data(), h);
+        if (index != NOT_FOUND) {
+            return {&slots_[index].value, false};
+        }
+        if (growth_left_ == 0) {
+            grow();
+        }
+        index = find_insert_index(h);
+        Slot* slot = &slots_[index];
+        ::new (static_cast<void*>(&slot->key)) Key();
+        std::memcpy(slot->key.data(), key.data(), KeySize);
+        ::new (static_cast<void*>(&slot->value)) Value(std::forward<Args>(args)...);
+        if (ctrl_[index] == smart_buffer_detail::SWISS_EMPTY) {
+            --growth_left_;
+        }
+        ctrl_[index] = h2(h);
+        ++size_;
+        return {&slot->value, true};
+    }
+
+    /**
+     * @brief Insert a key and value unless the key is present
+     */
+    template<std::size_t Size, std::size_t Threshold>
+    std::pair<Value*, bool> insert(const SmartBuffer<Size, Threshold>& key, Value value) {
+        return try_emplace(key, std::move(value));
+    }
+
+    /**
+     * @brief Insert a key and value, replacing the value if the key is present
+     */
+    template<std::size_t Size, std::size_t Threshold>
+    Value& insert_or_assign(const SmartBuffer<Size, Threshold>& key, Value value) {
+        auto [slot, inserted] = try_emplace(key, std::move(value));
+        if (!inserted) {
+            *slot = std::move(value);
+        }
+        return *slot;
+    }
+
+    /**
+     * @brief Get the value of a key, default-constructing it if absent
+     */
+    template<std::size_t Size, std::size_t Threshold>
+    Value& operator[](const SmartBuffer<Size, Threshold>& key) {
+        return *try_emplace(key).first;
+    }
+
+    /**
+     * @brief Erase a key
+     * @return false if the key was absent
+     */
+    template<std::size_t Size, std::size_t Threshold>
+    bool erase(const SmartBuffer<Size, Threshold>& key) {
+        static_assert(Size == KeySize, "SmartBufferSwissMap: key size mismatch");
+        std::size_t index = find_index(key.data(), hash(key));
+        if (index == NOT_FOUND) {
+            return false;
+        }
+        slots_[index].value.~Value();
+        // A probe stops at a group with an empty byte, so if this slot's group has one no
+        // probe ever went past it and the slot can become empty instead of a tombstone
+        std::size_t group = index & ~(smart_buffer_detail::SWISS_GROUP - 1);
+        if (smart_buffer_detail::SwissGroup(&ctrl_[group]).match_empty() != 0) {
+            ctrl_[index] = smart_buffer_detail::SWISS_EMPTY;
+            ++growth_left_;
+        } else {
+            ctrl_[index] = smart_buffer_detail::SWISS_DELETED;
+        }
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Call fn(const Key&, Value&) for every entry, in table order
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                fn(static_cast<const Key&>(slots_[i].key), slots_[i].value);
+            }
+        }
+    }
+
+    /**
+     * @brief Make room for count entries without rehashing
+     */
+    void reserve(std::size_t count) {
+        std::size_t capacity = smart_buffer_detail::SWISS_GROUP;
+        while (max_load(capacity) < count) {
+            capacity *= 2;
+        }
+        if (capacity > capacity_) {
+            rehash(capacity);
+        }
+    }
+
+    /**
+     * @brief Erase every entry, keeping the capacity
+     */
+    void clear() {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].value.~Value();
+            }
+            ctrl_[i] = smart_buffer_detail::SWISS_EMPTY;
+        }
+        size_ = 0;
+        growth_left_ = max_load(capacity_);
+    }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    static constexpr std::size_t NOT_FOUND = SIZE_MAX;
+
+    struct Slot {
+        Key key;
+        union {
+            Value value;   // Constructed only while the slot is full
+        };
+        Slot() noexcept {}
+        ~Slot() {}
+    };
+
+    static std::size_t max_load(std::size_t capacity) noexcept {
+        return capacity - capacity / 8;
+    }
+
+    template<typename K>
+    static std::size_t hash(const K& key) noexcept {
+        return static_cast<std::size_t>(Hash{}(key));
+    }
+
+    static std::int8_t h2(std::size_t hash) noexcept {
+        return static_cast<std::int8_t>(hash & 0x7F);
+    }
+
+    // Groups are visited in triangular order, which covers every group of a
+    // power-of-two table
+    std::size_t first_group(std::size_t hash) const noexcept {
+        return (hash >> 7) & (capacity_ / smart_buffer_detail::SWISS_GROUP - 1);
+    }
+
+    std::size_t find_index(const std::uint8_t* key, std::size_t hash) const noexcept {
+        if (capacity_ == 0) {
+            return NOT_FOUND;
+        }
+        std::size_t group_mask = capacity_ / smart_buffer_detail::SWISS_GROUP - 1;
+        std::size_t group = first_group(hash);
+        for (std::size_t step = 1;; ++step) {
+            std::size_t base = group * smart_buffer_detail::SWISS_GROUP;
+            smart_buffer_detail::SwissGroup control(&ctrl_[base]);
+            for (std::uint32_t mask = control.match(h2(hash)); mask != 0; mask &= mask - 1) {
+                std::size_t index = base + smart_buffer_detail::lowest_bit(mask);
+                if (smart_buffer_detail::equal_fixed<KeySize>(slots_[index].key.data(), key)) {
+                    return index;
+                }
+            }
+            if (control.match_empty() != 0 || step > group_mask) {
+                return NOT_FOUND;
+            }
+            group = (group + step) & group_mask;
+        }
+    }
+
+    std::size_t find_insert_index(std::size_t hash) const noexcept {
+        std::size_t group_mask = capacity_ / smart_buffer_detail::SWISS_GROUP - 1;
+        std::size_t group = first_group(hash);
+        for (std::size_t step = 1;; ++step) {
+            std::size_t base = group * smart_buffer_detail::SWISS_GROUP;
+            std::uint32_t mask = smart_buffer_detail::SwissGroup(&ctrl_[base]).match_empty_or_deleted();
+            if (mask != 0) {
+                return base + smart_buffer_detail::lowest_bit(mask);
+            }
+            group = (group + step) & group_mask;
+        }
+    }
+
+    void grow() {
+        // Mostly tombstones: rehash in place size; otherwise double
+        if (capacity_ != 0 && size_ <= max_load(capacity_) / 2) {
+            rehash(capacity_);
+        } else {
+            rehash(capacity_ == 0 ? smart_buffer_detail::SWISS_GROUP : capacity_ * 2);
+        }
+    }
+
+    void rehash(std::size_t capacity) {
+        // Allocate both arrays before touching the members, so a throwing allocation
+        // leaves the map as it was
+        std::unique_ptr<std::int8_t[]> new_ctrl(new std::int8_t[capacity]);
+        Slot* new_slots = std::allocator<Slot>().allocate(capacity);
+        std::memset(new_ctrl.get(), smart_buffer_detail::SWISS_EMPTY, capacity);
+
+        std::unique_ptr<std::int8_t[]> old_ctrl = std::exchange(ctrl_, std::move(new_ctrl));
+        Slot* old_slots = std::exchange(slots_, new_slots);
+        std::size_t old_capacity = std::exchange(capacity_, capacity);
+        growth_left_ = max_load(capacity) - size_;
+
+        for (std::size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] < 0) {
+                continue;
+            }
+            Slot& from = old_slots[i];
+            std::size_t h = hash(from.key);
+            std::size_t index = find_insert_index(h);
+            ::new (static_cast<void*>(&slots_[index].key)) Key(from.key);
+            ::new (static_cast<void*>(&slots_[index].value)) Value(std::move(from.value));
+            from.value.~Value();
+            ctrl_[index] = h2(h);
+        }
+        if (old_slots != nullptr) {
+            std::allocator<Slot>().deallocate(old_slots, old_capacity);
+        }
+    }
+
+    void destroy_slots() noexcept {
+        if (slots_ == nullptr) {
+            return;
+        }
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].value.~Value();
+            }
+        }
+        std::allocator<Slot>().deallocate(slots_, capacity_);
+        slots_ = nullptr;
+    }
+
+    std::unique_ptr<std::int8_t[]> ctrl_;
+    Slot* slots_ = nullptr;   // Raw storage; keys and values are constructed when a slot fills
+    std::size_t capacity_ = 0;
+    std::size_t size_ = 0;
+    std::size_t growth_left_ = 0;
+};
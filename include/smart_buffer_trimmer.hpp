@@ -0,0 +1,329 @@
+#pragma once
+
+#include "smart_buffer_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/**
+ * @brief Settings for SmartBufferPoolTrimmer
+ *
+ * Watermarks are in idle bytes summed over every registered pool. A trim fires when
+ * the idle bytes exceed high_watermark or a memory-pressure signal is seen, and frees
+ * idle buffers down to low_watermark. The gap between the two watermarks plus the
+ * cooldown provide the hysteresis that keeps a pool from being trimmed and regrown on
+ * every small burst.
+ */
+struct SmartBufferTrimConfig {
+    std::size_t high_watermark = SIZE_MAX;        // Idle bytes that trigger a trim
+    std::size_t low_watermark = 0;                // Idle bytes kept after a trim
+    std::chrono::milliseconds cooldown{1000};     // Minimum time between two trims
+
+    double psi_threshold = 10.0;                  // PSI "some avg10" percent; <= 0 disables
+    std::string psi_path = "/proc/pressure/memory";
+
+    bool use_cgroup_events = true;                // Trim when memory.events high/max grows
+    std::string cgroup_events_path;               // Empty: this process's cgroup v2 file
+
+    bool advise_kept = true;                      // Under pressure, MADV_FREE the kept idle buffers
+    bool return_to_os = true;                     // Call malloc_trim() after freeing (glibc)
+};
+
+/**
+ * @brief Counters describing a SmartBufferPoolTrimmer
+ */
+struct SmartBufferTrimStats {
+    std::size_t polls = 0;
+    std::size_t watermark_trims = 0;   // Trims caused by the high watermark
+    std::size_t pressure_trims = 0;    // Trims caused by PSI or cgroup events
+    std::size_t buffers_freed = 0;
+    std::size_t bytes_freed = 0;
+    std::size_t bytes_advised = 0;     // Bytes of kept idle buffers handed to MADV_FREE
+};
+
+/**
+ * @brief Trims idle buffers from a set of pools when they hold too much memory or the
+ *        host is under memory pressure.
+ *
+ * Pools are registered with add() and must outlive the trimmer. Call poll() from an
+ * existing housekeeping loop, or start() a background thread that polls at an interval.
+ *
+ * Pressure signals (Linux):
+ * - PSI: "some avg10" from /proc/pressure/memory at or above psi_threshold
+ * - cgroup v2: the "high" or "max" counter of memory.events grew since the last poll
+ *
+ * A pressure trim also advises the kernel that the pages of the idle buffers that are
+ * kept may be reclaimed (MADV_FREE), so they cost nothing until they are reused.
+ *
+ * @requires C++17 or later
+ */
+class SmartBufferPoolTrimmer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SmartBufferPoolTrimmer(SmartBufferTrimConfig config = {}) : config_(std::move(config)) {
+        if (config_.use_cgroup_events && config_.cgroup_events_path.empty()) {
+            config_.cgroup_events_path = detect_cgroup_events_path();
+        }
+        read_cgroup_events(config_.cgroup_events_path, last_high_, last_max_);
+    }
+
+    SmartBufferPoolTrimmer(const SmartBufferPoolTrimmer&) = delete;
+    SmartBufferPoolTrimmer& operator=(const SmartBufferPoolTrimmer&) = delete;
+
+    ~SmartBufferPoolTrimmer() {
+        stop();
+    }
+
+    /**
+     * @brief Register a pool (SmartBufferPool or SmartBufferZeroingPool)
+     */
+    template<typename Pool>
+    void add(Pool& pool) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pools_.push_back(Entry{
+            pool.buffer_size(),
+            [&pool] { return pool.idle(); },
+            [&pool](std::size_t keep) { return pool.trim(keep); },
+            [&pool] { return pool.advise_idle(); }});
+    }
+
+    /**
+     * @brief Check the watermarks and pressure signals and trim if needed
+     * @return true if a trim was performed
+     */
+    bool poll() {
+        return poll(Clock::now());
+    }
+
+    /**
+     * @brief poll() with an explicit time, for callers that already have one
+     */
+    bool poll(Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.polls;
+
+        // Checked first: under_pressure() consumes cgroup events, and one that arrives
+        // during the cooldown must still be seen by the first poll after it
+        if (trimmed_once_ && now - last_trim_ < config_.cooldown) {
+            return false;
+        }
+        bool pressure = under_pressure();
+        std::size_t idle = idle_bytes_locked();
+        bool over_watermark = idle > config_.high_watermark;
+        if (!pressure && !over_watermark) {
+            return false;
+        }
+
+        trim_to(config_.low_watermark, idle);
+        if (pressure) {
+            ++stats_.pressure_trims;
+            if (config_.advise_kept) {
+                for (Entry& entry : pools_) {
+                    stats_.bytes_advised += entry.advise();
+                }
+            }
+        } else {
+            ++stats_.watermark_trims;
+        }
+#if defined(__GLIBC__)
+        if (config_.return_to_os) {
+            ::malloc_trim(0);
+        }
+#endif
+        last_trim_ = now;
+        trimmed_once_ = true;
+        return true;
+    }
+
+    /**
+     * @brief Poll from a background thread every interval until stop()
+     */
+    void start(std::chrono::milliseconds interval) {
+        stop();
+        {
+            std::lock_guard<std::mutex> lock(thread_mutex_);
+            stopping_ = false;
+        }
+        worker_ = std::thread([this, interval] {
+            std::unique_lock<std::mutex> lock(thread_mutex_);
+            while (!wake_.wait_for(lock, interval, [this] { return stopping_; })) {
+                lock.unlock();
+                poll();
+                lock.lock();
+            }
+        });
+    }
+
+    /**
+     * @brief Stop the background thread, if any
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(thread_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    /**
+     * @brief Get the idle bytes held by every registered pool
+     */
+    std::size_t idle_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_bytes_locked();
+    }
+
+    SmartBufferTrimStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    const SmartBufferTrimConfig& config() const noexcept { return config_; }
+
+    /**
+     * @brief Read "some avg10" from a PSI file
+     * @return The percentage, or a negative value if the file is missing or malformed
+     */
+    static double read_psi_some_avg10(const std::string& path) {
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.compare(0, 5, "some ") != 0) {
+                continue;
+            }
+            std::size_t field = line.find("avg10=");
+            if (field == std::string::npos) {
+                return -1.0;
+            }
+            std::istringstream value(line.substr(field + 6));
+            double avg10 = -1.0;
+            value >> avg10;
+            return value ? avg10 : -1.0;
+        }
+        return -1.0;
+    }
+
+    /**
+     * @brief Read the "high" and "max" counters of a cgroup v2 memory.events file
+     * @return false if the file is missing
+     */
+    static bool read_cgroup_events(const std::string& path, std::uint64_t& high, std::uint64_t& max) {
+        if (path.empty()) {
+            return false;
+        }
+        std::ifstream in(path);
+        if (!in) {
+            return false;
+        }
+        std::string key;
+        std::uint64_t value = 0;
+        while (in >> key >> value) {
+            if (key == "high") {
+                high = value;
+            } else if (key == "max") {
+                max = value;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Find memory.events for this process's cgroup v2 (empty if there is none)
+     */
+    static std::string detect_cgroup_events_path() {
+        std::ifstream in("/proc/self/cgroup");
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.compare(0, 3, "0::") != 0) {
+                continue;
+            }
+            std::string group = line.substr(3);
+            for (const char* root : {"/sys/fs/cgroup", "/sys/fs/cgroup/unified"}) {
+                std::string path = std::string(root) + group + (group == "/" ? "" : "/") + "memory.events";
+                if (std::ifstream(path)) {
+                    return path;
+                }
+            }
+        }
+        return {};
+    }
+
+private:
+    struct Entry {
+        std::size_t buffer_size;
+        std::function<std::size_t()> idle;
+        std::function<std::size_t(std::size_t)> trim;
+        std::function<std::size_t()> advise;
+    };
+
+    std::size_t idle_bytes_locked() const {
+        std::size_t total = 0;
+        for (const Entry& entry : pools_) {
+            total += entry.idle() * entry.buffer_size;
+        }
+        return total;
+    }
+
+    bool under_pressure() {
+        bool pressure = false;
+        if (config_.psi_threshold > 0) {
+            pressure = read_psi_some_avg10(config_.psi_path) >= config_.psi_threshold;
+        }
+        if (config_.use_cgroup_events) {
+            std::uint64_t high = last_high_;
+            std::uint64_t max = last_max_;
+            if (read_cgroup_events(config_.cgroup_events_path, high, max)) {
+                pressure = pressure || high > last_high_ || max > last_max_;
+                last_high_ = high;
+                last_max_ = max;
+            }
+        }
+        return pressure;
+    }
+
+    // Free idle buffers so the pools keep about target bytes, each in proportion to
+    // its share of the idle total
+    void trim_to(std::size_t target, std::size_t idle) {
+        for (Entry& entry : pools_) {
+            std::size_t pool_idle = entry.idle() * entry.buffer_size;
+            std::size_t keep_bytes = idle == 0 ? 0
+                : static_cast<std::size_t>(static_cast<double>(pool_idle) * static_cast<double>(target) / static_cast<double>(idle));
+            std::size_t freed = entry.trim(std::min(keep_bytes, pool_idle) / entry.buffer_size);
+            stats_.buffers_freed += freed;
+            stats_.bytes_freed += freed * entry.buffer_size;
+        }
+    }
+
+    SmartBufferTrimConfig config_;
+    mutable std::mutex mutex_;
+    std::vector<Entry> pools_;
+    SmartBufferTrimStats stats_;
+    Clock::time_point last_trim_{};
+    bool trimmed_once_ = false;
+    std::uint64_t last_high_ = 0;
+    std::uint64_t last_max_ = 0;
+
+    std::mutex thread_mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::thread worker_;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Wait-free latest-value handoff of a buffer from one producer thread to one
+ *        consumer thread (triple buffering).
+ *
+ * @tparam Buffer The frame type, e.g. SmartBuffer<2048>
+ *
+ * Three buffers rotate between three roles: the producer's back buffer, the consumer's
+ * front buffer, and a middle buffer holding the latest published frame. The roles
+ * change by swapping indices in one atomic byte that also carries a dirty flag, so
+ * neither side ever copies a frame, waits for the other, or sees a frame that is being
+ * written. Frames published faster than the consumer reads them are dropped; only the
+ * latest one is delivered.
+ *
+ * @requires C++17 or later
+ */
+template<typename Buffer>
+class SmartBufferTripleBuffer {
+public:
+    SmartBufferTripleBuffer() = default;
+
+    /**
+     * @brief Construct with every buffer initialized to initial
+     */
+    explicit SmartBufferTripleBuffer(const Buffer& initial) {
+        for (Slot& slot : slots_) {
+            slot.buffer = initial;
+        }
+    }
+
+    SmartBufferTripleBuffer(const SmartBufferTripleBuffer&) = delete;
+    SmartBufferTripleBuffer& operator=(const SmartBufferTripleBuffer&) = delete;
+
+    /**
+     * @brief Get the buffer the producer fills next (producer only)
+     * Its content is a frame published earlier, not necessarily the last one.
+     */
+    Buffer& write_buffer() noexcept {
+        return slots_[back_].buffer;
+    }
+
+    /**
+     * @brief Publish the write buffer as the latest frame (producer only)
+     */
+    void publish() noexcept {
+        std::uint8_t previous = middle_.exchange(static_cast<std::uint8_t>(back_ | DIRTY), std::memory_order_acq_rel);
+        back_ = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Switch to the latest published frame, if any, and return it (consumer only)
+     * The reference stays valid and unchanged until the next acquire_latest().
+     */
+    const Buffer& acquire_latest() noexcept {
+        if (middle_.load(std::memory_order_relaxed) & DIRTY) {
+            std::uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = previous & INDEX_MASK;
+        }
+        return slots_[front_].buffer;
+    }
+
+    /**
+     * @brief Get the frame returned by the last acquire_latest() (consumer only)
+     */
+    const Buffer& read_buffer() const noexcept {
+        return slots_[front_].buffer;
+    }
+
+    /**
+     * @brief Check whether a frame was published since the last acquire_latest()
+     */
+    bool dirty() const noexcept {
+        return (middle_.load(std::memory_order_relaxed) & DIRTY) != 0;
+    }
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t DIRTY = 0x4;
+
+    struct alignas(CACHE_LINE) Slot {
+        Buffer buffer;
+    };
+
+    Slot slots_[3];
+    alignas(CACHE_LINE) std::uint8_t back_ = 0;                 // Producer-owned
+    alignas(CACHE_LINE) std::atomic<std::uint8_t> middle_{1};   // Shared: index | DIRTY
+    alignas(CACHE_LINE) std::uint8_t front_ = 2;                // Consumer-owned
+};
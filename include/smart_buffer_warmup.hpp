@@ -0,0 +1,192 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Number of buffers to preallocate per buffer size, recorded from a previous
+ *        run's peak live counts or written by hand as a config.
+ *
+ * The text format is one "<buffer size> <count>" pair per line; blank lines and lines
+ * starting with '#' are ignored.
+ */
+class SmartBufferWarmupProfile {
+public:
+    /**
+     * @brief Set the number of buffers wanted for one buffer size
+     */
+    void set(std::size_t buffer_size, std::size_t count) {
+        counts_[buffer_size] = count;
+    }
+
+    /**
+     * @brief Get the number of buffers wanted for one buffer size (0 if unknown)
+     */
+    std::size_t count(std::size_t buffer_size) const {
+        auto it = counts_.find(buffer_size);
+        return it == counts_.end() ? 0 : it->second;
+    }
+
+    /**
+     * @brief Record each pool's peak live count, keeping the larger value on repeats
+     * Works with any pool exposing buffer_size() and stats().peak_live.
+     */
+    template<typename... Pools>
+    void record(const Pools&... pools) {
+        (record_one(pools.buffer_size(), pools.stats().peak_live), ...);
+    }
+
+    /**
+     * @brief Multiply every count by factor (e.g. 1.25 for headroom), rounding up
+     */
+    void scale(double factor) {
+        for (auto& entry : counts_) {
+            double scaled = static_cast<double>(entry.second) * factor;
+            auto rounded = static_cast<std::size_t>(scaled);
+            entry.second = rounded + (static_cast<double>(rounded) < scaled);
+        }
+    }
+
+    const std::map<std::size_t, std::size_t>& counts() const noexcept { return counts_; }
+
+    bool empty() const noexcept { return counts_.empty(); }
+
+    /**
+     * @brief Write the profile in text form
+     */
+    void save(std::ostream& out) const {
+        out << "# SmartBuffer warmup profile: <buffer size> <count>\n";
+        for (const auto& entry : counts_) {
+            out << entry.first << ' ' << entry.second << '\n';
+        }
+    }
+
+    /**
+     * @brief Read a profile in text form, merging it into this one
+     * @throws std::invalid_argument on a malformed line
+     */
+    void load(std::istream& in) {
+        std::string line;
+        while (std::getline(in, line)) {
+            std::size_t start = line.find_first_not_of(" \t\r");
+            if (start == std::string::npos || line[start] == '#') {
+                continue;
+            }
+            std::istringstream fields(line);
+            unsigned long long buffer_size = 0;
+            unsigned long long count = 0;
+            std::string rest;
+            if (!(fields >> buffer_size >> count) || (fields >> rest)) {
+                throw std::invalid_argument("SmartBufferWarmupProfile: malformed line '" + line + "'");
+            }
+            set(static_cast<std::size_t>(buffer_size), static_cast<std::size_t>(count));
+        }
+    }
+
+    /**
+     * @brief Write the profile to a file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save_file(const std::string& path) const {
+        std::ofstream out(path);
+        save(out);
+        if (!out) {
+            throw std::runtime_error("SmartBufferWarmupProfile: cannot write " + path);
+        }
+    }
+
+    /**
+     * @brief Read a profile file; a missing file leaves the profile unchanged
+     * @return false if the file could not be opened
+     */
+    bool load_file(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) {
+            return false;
+        }
+        load(in);
+        return true;
+    }
+
+private:
+    void record_one(std::size_t buffer_size, std::size_t peak) {
+        std::size_t& count = counts_[buffer_size];
+        count = std::max(count, peak);
+    }
+
+    std::map<std::size_t, std::size_t> counts_;
+};
+
+/**
+ * @brief Preallocate and prefault buffers so a pool holds at least count idle ones
+ *
+ * Every buffer is zero-filled by its constructor, which touches each page and takes the
+ * page faults now rather than under the first traffic. With threads > 1 the buffers are
+ * built in parallel and handed to the pool with adopt(); with glibc each warmup thread
+ * may use its own malloc arena, which is harmless for pooled buffers.
+ *
+ * Works with SmartBufferPool and SmartBufferZeroingPool.
+ *
+ * @return Number of buffers added; fewer than built when the pool's max_idle freed some
+ */
+template<typename Pool>
+std::size_t smart_buffer_warmup(Pool& pool, std::size_t count, unsigned threads = 1) {
+    using Buffer = typename Pool::Buffer;
+    std::size_t idle = pool.idle();
+    if (idle >= count) {
+        return 0;
+    }
+    std::size_t missing = count - idle;
+    threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, missing)));
+
+    std::vector<std::vector<Buffer>> batches(threads);
+    // Built from the pool's resource: a scope installed by the caller must not leak in
+    std::pmr::memory_resource* resource = pool.resource();
+    auto build = [&batches, missing, threads, resource](unsigned index) {
+        std::size_t share = missing / threads + (index < missing % threads);
+        batches[index].reserve(share);
+        for (std::size_t i = 0; i < share; ++i) {
+            batches[index].emplace_back(resource);
+        }
+    };
+
+    if (threads == 1) {
+        build(0);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned index = 1; index < threads; ++index) {
+            workers.emplace_back(build, index);
+        }
+        build(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t added = 0;
+    for (auto& batch : batches) {
+        added += pool.adopt(std::move(batch));
+    }
+    return added;
+}
+
+/**
+ * @brief Warm several pools from a profile, each to the count recorded for its buffer size
+ * @return Total number of buffers added
+ */
+template<typename... Pools>
+std::size_t smart_buffer_warmup(const SmartBufferWarmupProfile& profile, unsigned threads, Pools&... pools) {
+    return (std::size_t{0} + ... + smart_buffer_warmup(pools, profile.count(pools.buffer_size()), threads));
+}
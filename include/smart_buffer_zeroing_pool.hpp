@@ -0,0 +1,411 @@
+#pragma once
+
+#include "smart_buffer.hpp"
+#include "smart_buffer_pool.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @brief Counters describing a SmartBufferZeroingPool
+ */
+struct SmartBufferZeroingPoolStats {
+    std::size_t clean = 0;             // Idle buffers already zeroed
+    std::size_t dirty = 0;             // Idle buffers waiting to be zeroed
+    std::size_t live = 0;              // Buffers handed out and not yet released
+    std::size_t peak_live = 0;         // Highest live count observed
+    std::size_t allocations = 0;       // Buffers constructed because the pool was empty
+    std::size_t clean_hits = 0;        // acquire_zeroed() served from the clean list
+    std::size_t inline_zeroes = 0;     // acquire_zeroed() that had to zero on the caller's thread
+    std::size_t background_zeroes = 0; // Buffers zeroed by the background thread or zero_idle()
+};
+
+namespace smart_buffer_detail {
+
+// Buffers at least this large are zeroed with streaming stores. Smaller ones are
+// zeroed through the cache: they are reused soon and the caller writes them anyway,
+// so evicting them costs more than the pollution it avoids.
+inline constexpr std::size_t NONTEMPORAL_ZERO_THRESHOLD = 256 * 1024;
+
+// Zero a block with streaming stores so it does not evict the caller's working set;
+// falls back to memset without SSE2
+inline void zero_nontemporal(std::uint8_t* data, std::size_t size) noexcept {
+#if defined(__SSE2__)
+    std::size_t head = (16 - (reinterpret_cast<std::uintptr_t>(data) & 15)) & 15;
+    if (head > size) {
+        head = size;
+    }
+    std::memset(data, 0, head);
+    std::size_t offset = head;
+    const __m128i zero = _mm_setzero_si128();
+    for (; offset + 64 <= size; offset += 64) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(data + offset), zero);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(data + offset + 16), zero);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(data + offset + 32), zero);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(data + offset + 48), zero);
+    }
+    for (; offset + 16 <= size; offset += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(data + offset), zero);
+    }
+    std::memset(data + offset, 0, size - offset);
+    _mm_sfence();  // Order the streaming stores before the buffer is published
+#else
+    std::memset(data, 0, size);
+#endif
+}
+
+} // namespace smart_buffer_detail
+
+/**
+ * @brief A SmartBuffer pool that zeroes released buffers off the critical path.
+ *
+ * @tparam Size Buffer size in bytes
+ * @tparam StaticThreshold Threshold forwarded to SmartBuffer
+ *
+ * Released buffers go to a dirty list. A low-priority background thread (or the owner,
+ * through the zero_idle() idle-time hook) zeroes them and moves them to a clean list, so
+ * acquire_zeroed() is a pop whenever the cleaner keeps up. Buffers of 256 KiB or more
+ * are zeroed with non-temporal stores.
+ * If the clean list is empty, acquire_zeroed() zeroes a dirty buffer on the caller's
+ * thread, and only constructs a new buffer when both lists are empty.
+ *
+ * acquire() prefers dirty buffers, leaving clean ones for callers that need zeros.
+ *
+ * Like SmartBufferPool, new buffers come from the pool's own resource rather than any
+ * SmartBufferResourceScope of the caller, and released buffers from another resource
+ * are freed, not pooled.
+ *
+ * @requires C++17 or later
+ */
+template<std::size_t Size, std::size_t StaticThreshold = 32>
+class SmartBufferZeroingPool {
+public:
+    using Buffer = SmartBuffer<Size, StaticThreshold>;
+
+    /**
+     * @brief Construct an empty pool
+     * @param background Start a background zeroing thread; otherwise call zero_idle()
+     * @param max_idle Buffers released beyond this many idle (clean + dirty) ones are freed
+     * @param resource Resource for new buffers (null = global heap); must outlive the pool
+     */
+    explicit SmartBufferZeroingPool(bool background = true, std::size_t max_idle = SIZE_MAX,
+                                    std::pmr::memory_resource* resource = nullptr)
+        : max_idle_(max_idle), resource_(resource) {
+        if (background) {
+            worker_ = std::thread([this] { run(); });
+        }
+    }
+
+    SmartBufferZeroingPool(const SmartBufferZeroingPool&) = delete;
+    SmartBufferZeroingPool& operator=(const SmartBufferZeroingPool&) = delete;
+
+    ~SmartBufferZeroingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    /**
+     * @brief Get a buffer (contents unspecified if recycled)
+     */
+    Buffer acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            note_acquire();
+            if (!dirty_.empty()) {
+                return pop(dirty_);
+            }
+            if (!clean_.empty()) {
+                return pop(clean_);
+            }
+            ++stats_.allocations;
+        }
+        return Buffer(resource_);
+    }
+
+    /**
+     * @brief Get a buffer whose contents are all zero (O(1) when the clean list is not empty)
+     */
+    Buffer acquire_zeroed() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            note_acquire();
+            if (!clean_.empty()) {
+                ++stats_.clean_hits;
+                return pop(clean_);
+            }
+            if (!dirty_.empty()) {
+                ++stats_.inline_zeroes;
+                Buffer buffer = pop(dirty_);
+                lock.unlock();
+                buffer.clear_all();
+                return buffer;
+            }
+            ++stats_.allocations;
+        }
+        return Buffer(resource_);  // Fresh buffers are already zeroed by the constructor
+    }
+
+    /**
+     * @brief Return a buffer to the dirty list
+     */
+    void release(Buffer&& buffer) {
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stats_.live != 0) {
+                --stats_.live;
+            }
+            if (buffer.data() == nullptr || !owns(buffer) || clean_.size() + dirty_.size() + in_flight_ >= max_idle_) {
+                return;
+            }
+            dirty_.push_back(std::move(buffer));
+            wake = worker_sleeping_;
+            worker_sleeping_ = false;  // One wake-up per batch of releases
+        }
+        if (wake) {
+            wake_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Make sure at least count buffers are idle and clean
+     */
+    void reserve(std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clean_.reserve(count);
+        while (clean_.size() < count) {
+            clean_.emplace_back(resource_);
+            ++stats_.allocations;
+        }
+    }
+
+    /**
+     * @brief Add zeroed buffers built elsewhere (e.g. by warmup threads) to the clean list
+     * Buffers beyond max_idle, or from another resource, are freed.
+     * @return Number of buffers kept
+     */
+    std::size_t adopt(std::vector<Buffer>&& buffers) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.allocations += buffers.size();
+        std::size_t kept = 0;
+        for (Buffer& buffer : buffers) {
+            if (clean_.size() + dirty_.size() + in_flight_ >= max_idle_) {
+                break;
+            }
+            if (!owns(buffer)) {
+                continue;
+            }
+            clean_.push_back(std::move(buffer));
+            ++kept;
+        }
+        buffers.clear();
+        return kept;
+    }
+
+    /**
+     * @brief Idle-time hook: zero up to max_buffers dirty buffers on the calling thread
+     * @return Number of buffers zeroed
+     */
+    std::size_t zero_idle(std::size_t max_buffers = SIZE_MAX) {
+        std::size_t zeroed = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (zeroed < max_buffers && zero_one(lock)) {
+            ++zeroed;
+        }
+        return zeroed;
+    }
+
+    /**
+     * @brief Free idle buffers beyond keep, dirty ones first
+     * @return Number of buffers freed
+     */
+    std::size_t trim(std::size_t keep) {
+        std::vector<Buffer> released;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::size_t idle = clean_.size() + dirty_.size() + in_flight_;
+            std::size_t excess = idle > keep ? idle - keep : 0;
+            for (std::vector<Buffer>* list : {&dirty_, &clean_}) {
+                std::size_t count = std::min(excess, list->size());
+                auto first = list->end() - static_cast<std::ptrdiff_t>(count);
+                released.insert(released.end(), std::make_move_iterator(first), std::make_move_iterator(list->end()));
+                list->erase(first, list->end());
+                excess -= count;
+            }
+        }
+        return released.size();  // Freed outside the lock
+    }
+
+    /**
+     * @brief Let the kernel reclaim the pages of idle buffers that stay pooled
+     * Reclaimed pages read back as zeros, so clean buffers stay clean.
+     * @return Number of bytes advised
+     */
+    std::size_t advise_idle() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t advised = 0;
+        for (std::vector<Buffer>* list : {&clean_, &dirty_}) {
+            for (Buffer& buffer : *list) {
+                advised += smart_buffer_detail::advise_free(buffer.data(), buffer.actual_size());
+            }
+        }
+        return advised;
+    }
+
+    /**
+     * @brief Free every idle buffer
+     */
+    void shrink() {
+        std::vector<Buffer> released_clean;
+        std::vector<Buffer> released_dirty;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            released_clean.swap(clean_);
+            released_dirty.swap(dirty_);
+        }
+    }
+
+    /**
+     * @brief Block until the dirty list has been drained (background mode only)
+     */
+    void wait_clean() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        drained_.wait(lock, [this] { return (dirty_.empty() && in_flight_ == 0) || !worker_.joinable(); });
+    }
+
+    /**
+     * @brief Get the number of idle buffers (clean and dirty)
+     */
+    std::size_t idle() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return clean_.size() + dirty_.size() + in_flight_;
+    }
+
+    /**
+     * @brief Get a snapshot of the pool counters
+     */
+    SmartBufferZeroingPoolStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SmartBufferZeroingPoolStats snapshot = stats_;
+        snapshot.clean = clean_.size();
+        snapshot.dirty = dirty_.size() + in_flight_;
+        return snapshot;
+    }
+
+    /**
+     * @brief Check if a background zeroing thread is running
+     */
+    bool has_background_thread() const noexcept { return worker_.joinable(); }
+
+    /**
+     * @brief Get the resource new buffers are allocated from (null = global heap)
+     */
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+    /**
+     * @brief Get the buffer size served by this pool
+     */
+    constexpr std::size_t buffer_size() const noexcept { return Size; }
+
+private:
+    static Buffer pop(std::vector<Buffer>& list) {
+        Buffer buffer = std::move(list.back());
+        list.pop_back();
+        return buffer;
+    }
+
+    bool owns(const Buffer& buffer) const noexcept {
+        return buffer.is_static() || buffer.resource() == resource_;
+    }
+
+    void note_acquire() {
+        ++stats_.live;
+        if (stats_.live > stats_.peak_live) {
+            stats_.peak_live = stats_.live;
+        }
+    }
+
+    // Zero one dirty buffer outside the lock; returns false if there was none
+    bool zero_one(std::unique_lock<std::mutex>& lock) {
+        if (dirty_.empty()) {
+            return false;
+        }
+        Buffer buffer = pop(dirty_);
+        ++in_flight_;
+        lock.unlock();
+        if constexpr (Size >= smart_buffer_detail::NONTEMPORAL_ZERO_THRESHOLD) {
+            smart_buffer_detail::zero_nontemporal(buffer.data(), buffer.actual_size());
+        } else {
+            smart_buffer_detail::fill_bytes(buffer.data(), buffer.actual_size(), 0);
+        }
+        lock.lock();
+        --in_flight_;
+        ++stats_.background_zeroes;
+        clean_.push_back(std::move(buffer));
+        if (dirty_.empty() && in_flight_ == 0) {
+            // Whichever thread, worker or idle hook, finishes the last buffer wakes wait_clean()
+            drained_.notify_all();
+        }
+        return true;
+    }
+
+    static void lower_priority() noexcept {
+#if defined(__linux__) && defined(SCHED_IDLE)
+        // Best effort: the zeroing thread only runs when a CPU would otherwise idle
+        sched_param param{};
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+    }
+
+    void run() {
+        lower_priority();
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            worker_sleeping_ = true;
+            wake_.wait(lock, [this] { return stopping_ || !dirty_.empty(); });
+            worker_sleeping_ = false;
+            if (stopping_) {
+                break;
+            }
+            while (!stopping_ && zero_one(lock)) {
+            }
+        }
+        drained_.notify_all();
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+    std::vector<Buffer> clean_;
+    std::vector<Buffer> dirty_;
+    std::size_t in_flight_ = 0;   // Buffers being zeroed outside the lock
+    std::size_t max_idle_;
+    std::pmr::memory_resource* resource_;
+    bool stopping_ = false;
+    bool worker_sleeping_ = false;
+    SmartBufferZeroingPoolStats stats_;
+    std::thread worker_;
+};
@@ -1,6 +1,8 @@
 #include <smart_buffer.hpp>
 #include <gtest/gtest.h>
 #include <cstring>
+#include <type_traits>
+#include <vector>
 
 TEST(SmartBufferTest, StaticAllocationThreshold) {
     // Test the 32-byte boundary
@@ -267,6 +269,55 @@ TEST(SmartBufferTest, TypeAliases) {
     EXPECT_FALSE(buf4k.is_static());
 }
 
+// Static buffers must be trivially copyable so containers and serializers can memcpy them
+static_assert(std::is_trivially_copyable_v<SmartBuffer<16>>);
+static_assert(std::is_trivially_copyable_v<SmartBuffer<32>>);
+static_assert(std::is_trivially_copy_constructible_v<SmartBuffer<16>>);
+static_assert(std::is_trivially_move_constructible_v<SmartBuffer<16>>);
+static_assert(std::is_trivially_copy_assignable_v<SmartBuffer<16>>);
+static_assert(std::is_trivially_move_assignable_v<SmartBuffer<16>>);
+static_assert(std::is_trivially_destructible_v<SmartBuffer<16>>);
+static_assert(std::is_trivially_copyable_v<SmartBufferAlwaysStatic<1024>>);
+static_assert(sizeof(SmartBuffer<16>) == 16);
+static_assert(sizeof(SmartBuffer<5>) == 8);
+
+// Dynamic buffers keep deep-copy semantics
+static_assert(!std::is_trivially_copyable_v<SmartBuffer<64>>);
+static_assert(std::is_nothrow_move_constructible_v<SmartBuffer<64>>);
+static_assert(std::is_nothrow_move_assignable_v<SmartBuffer<64>>);
+
+TEST(SmartBufferTest, StaticBufferMemcpyRoundTrip) {
+    SmartBuffer<16> original;
+    for (size_t i = 0; i < original.size(); ++i) {
+        original[i] = static_cast<uint8_t>(i + 1);
+    }
+    
+    SmartBuffer<16> copy;
+    std::memcpy(static_cast<void*>(&copy), &original, sizeof(original));
+    
+    for (size_t i = 0; i < original.size(); ++i) {
+        EXPECT_EQ(copy[i], original[i]);
+    }
+    EXPECT_NE(copy.data(), original.data());
+}
+
+TEST(SmartBufferTest, VectorGrowthPreservesContents) {
+    std::vector<SmartBuffer<16>> static_buffers;
+    std::vector<SmartBuffer<64>> dynamic_buffers;
+    
+    for (size_t i = 0; i < 1000; ++i) {
+        static_buffers.emplace_back();
+        static_buffers.back()[0] = static_cast<uint8_t>(i);
+        dynamic_buffers.emplace_back();
+        dynamic_buffers.back()[0] = static_cast<uint8_t>(i);
+    }
+    
+    for (size_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(static_buffers[i][0], static_cast<uint8_t>(i));
+        EXPECT_EQ(dynamic_buffers[i][0], static_cast<uint8_t>(i));
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,138 @@
+#include <smart_buffer_arena.hpp>
+#include <smart_buffer_warmup.hpp>
+#include <smart_buffer_pool.hpp>
+#include <smart_buffer_zeroing_pool.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(SmartBufferArenaTest, ScopeRoutesDynamicBuffersToArena) {
+    SmartBufferArena<8192> arena;
+    {
+        SmartBufferResourceScope scope(&arena);
+        EXPECT_EQ(SmartBufferResourceScope::current(), &arena);
+        
+        SmartBuffer1K buffer;
+        EXPECT_EQ(buffer.resource(), &arena);
+        EXPECT_TRUE(arena.is_inline(buffer.data()));
+        EXPECT_EQ(buffer[100], 0);
+        buffer.fill(0x5A);
+        EXPECT_EQ(buffer[1023], 0x5A);
+        
+        // Static buffers never touch the resource
+        SmartBuffer16 small;
+        EXPECT_EQ(small.resource(), nullptr);
+    }
+    EXPECT_EQ(SmartBufferResourceScope::current(), nullptr);
+    EXPECT_EQ(arena.bytes_allocated(), 1024u);
+    
+    SmartBuffer1K heap_buffer;
+    EXPECT_EQ(heap_buffer.resource(), nullptr);
+}
+
+TEST(SmartBufferArenaTest, NestedScopesRestorePreviousResource) {
+    SmartBufferArena<> outer;
+    SmartBufferArena<> inner;
+    SmartBufferResourceScope outer_scope(&outer);
+    {
+        SmartBufferResourceScope inner_scope(&inner);
+        SmartBuffer<256> buffer;
+        EXPECT_EQ(buffer.resource(), &inner);
+    }
+    SmartBuffer<256> buffer;
+    EXPECT_EQ(buffer.resource(), &outer);
+}
+
+TEST(SmartBufferArenaTest, ExplicitResourceAndCopies) {
+    SmartBufferArena<> arena;
+    SmartBuffer<512> buffer(&arena);
+    EXPECT_EQ(buffer.resource(), &arena);
+    buffer[7] = 42;
+    
+    // Copies follow the resource in scope (here the heap), so they may outlive the arena
+    SmartBuffer<512> copy = buffer;
+    EXPECT_EQ(copy.resource(), nullptr);
+    EXPECT_EQ(copy[7], 42);
+    
+    // Moves keep the original allocation and resource
+    const uint8_t* storage = buffer.data();
+    SmartBuffer<512> moved = std::move(buffer);
+    EXPECT_EQ(moved.data(), storage);
+    EXPECT_EQ(moved.resource(), &arena);
+}
+
+TEST(SmartBufferArenaTest, GrowsIntoHeapChunksAndReleases) {
+    SmartBufferArena<1024> arena(4096);
+    {
+        SmartBufferResourceScope scope(&arena);
+        std::vector<SmartBuffer<2048>> buffers(6);
+        for (auto& buffer : buffers) {
+            EXPECT_EQ(buffer.resource(), &arena);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % alignof(std::max_align_t), 0u);
+            buffer.fill(0xEE);
+        }
+        EXPECT_FALSE(arena.is_inline(buffers[0].data()));
+        EXPECT_GE(arena.chunk_count(), 2u);
+        EXPECT_EQ(buffers[5][2047], 0xEE);
+    }
+    EXPECT_EQ(arena.bytes_allocated(), 6u * 2048u);
+    
+    arena.release();
+    EXPECT_EQ(arena.chunk_count(), 0u);
+    EXPECT_EQ(arena.bytes_allocated(), 0u);
+    
+    SmartBuffer<512> reused(&arena);
+    EXPECT_TRUE(arena.is_inline(reused.data()));
+}
+
+TEST(SmartBufferArenaTest, OversizedRequestGetsDedicatedChunk) {
+    SmartBufferArena<256> arena(1024);
+    SmartBuffer<65536> big(&arena);
+    EXPECT_EQ(arena.chunk_count(), 1u);
+    big[65535] = 1;
+    EXPECT_EQ(big[65535], 1);
+}
+
+TEST(SmartBufferArenaTest, PoolsIgnoreTheCallersScope) {
+    SmartBufferPool<4096> pool;
+    SmartBufferZeroingPool<4096> zeroing(false);
+    {
+        SmartBufferArena<> arena;
+        SmartBufferResourceScope scope(&arena);
+        
+        // Fresh and warmed buffers come from the pool's resource, not the request's arena
+        auto buffer = pool.acquire();
+        auto zeroed = zeroing.acquire_zeroed();
+        EXPECT_EQ(buffer.resource(), nullptr);
+        EXPECT_EQ(zeroed.resource(), nullptr);
+        pool.release(std::move(buffer));
+        zeroing.release(std::move(zeroed));
+        EXPECT_EQ(smart_buffer_warmup(pool, 3), 2u);
+        EXPECT_EQ(smart_buffer_warmup(zeroing, 3), 2u);
+        EXPECT_EQ(arena.bytes_allocated(), 0u);
+        
+        // A buffer carved from the arena is freed on release instead of pooled
+        SmartBuffer4K scoped;
+        EXPECT_EQ(scoped.resource(), &arena);
+        pool.release(std::move(scoped));
+        SmartBuffer4K scoped_dirty;
+        zeroing.release(std::move(scoped_dirty));
+        std::vector<SmartBuffer4K> adopted(2);
+        EXPECT_EQ(pool.adopt(std::move(adopted)), 0u);
+        EXPECT_EQ(pool.idle(), 3u);
+        EXPECT_EQ(zeroing.idle(), 3u);
+        arena.release();
+    }
+    
+    // Every pooled buffer is still valid once the arena is gone (ASan checks the writes)
+    for (int i = 0; i < 3; ++i) {
+        auto buffer = pool.acquire();
+        buffer.fill(0xAB);
+        auto zeroed = zeroing.acquire_zeroed();
+        EXPECT_EQ(zeroed[4095], 0);
+        zeroed.fill(0xCD);
+    }
+    
+    SmartBufferArena<> owned;
+    SmartBufferPool<4096> arena_pool(SIZE_MAX, &owned);
+    EXPECT_EQ(arena_pool.acquire().resource(), &owned);
+}
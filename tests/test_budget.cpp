@@ -0,0 +1,142 @@
+#include <smart_buffer_budget.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(SmartBufferBudgetTest, ChargesAndRefundsDynamicBuffers) {
+    SmartBufferBudget budget(64 * 1024);
+    {
+        SmartBuffer4K first(&budget);
+        EXPECT_EQ(first.resource(), &budget);
+        EXPECT_EQ(budget.used(), 4096u);
+        {
+            SmartBufferResourceScope scope(&budget);
+            SmartBuffer4K second;
+            SmartBuffer4K copy = first;   // Copies are charged too
+            EXPECT_EQ(budget.used(), 3u * 4096u);
+        }
+        EXPECT_EQ(budget.used(), 4096u);
+    }
+    EXPECT_EQ(budget.used(), 0u);
+    
+    // Static buffers are never charged
+    SmartBuffer16 small(&budget);
+    EXPECT_EQ(budget.used(), 0u);
+}
+
+TEST(SmartBufferBudgetTest, TryMakeRefusesOverBudget) {
+    SmartBufferBudget budget(3 * 4096);
+    std::vector<SmartBuffer4K> held;
+    for (int i = 0; i < 3; ++i) {
+        auto buffer = budget.try_make<SmartBuffer4K>();
+        ASSERT_TRUE(buffer.has_value());
+        held.push_back(std::move(*buffer));
+    }
+    EXPECT_FALSE(budget.try_make<SmartBuffer4K>().has_value());
+    EXPECT_EQ(budget.stats().rejected, 1u);
+    EXPECT_EQ(budget.used(), 3u * 4096u);
+    
+    held.pop_back();
+    EXPECT_TRUE(budget.try_make<SmartBuffer4K>().has_value());
+}
+
+TEST(SmartBufferBudgetTest, FailModeThrowsBadAlloc) {
+    SmartBufferBudget budget(4096, std::pmr::new_delete_resource(), SmartBufferBudgetMode::Fail);
+    SmartBuffer4K held(&budget);
+    EXPECT_THROW(SmartBuffer4K extra(&budget), std::bad_alloc);
+    EXPECT_EQ(budget.used(), 4096u);
+}
+
+TEST(SmartBufferBudgetTest, BlockingAllocationWaitsForRefund) {
+    SmartBufferBudget budget(2 * 4096);
+    auto first = std::make_unique<SmartBuffer4K>(&budget);
+    SmartBuffer4K second(&budget);
+    
+    std::atomic<bool> allocated{false};
+    std::thread producer([&] {
+        SmartBuffer4K third(&budget);   // Blocks until first is freed
+        allocated = true;
+    });
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(allocated.load());
+    first.reset();
+    producer.join();
+    EXPECT_TRUE(allocated.load());
+    EXPECT_EQ(budget.stats().blocked, 1u);
+    EXPECT_EQ(budget.used(), 4096u);
+}
+
+TEST(SmartBufferBudgetTest, ReserveForTimesOut) {
+    SmartBufferBudget budget(1000);
+    EXPECT_TRUE(budget.try_reserve(600));
+    EXPECT_FALSE(budget.reserve_for(600, 10ms));
+    budget.unreserve(600);
+    EXPECT_TRUE(budget.reserve_for(600, 10ms));
+    EXPECT_EQ(budget.used(), 600u);
+}
+
+TEST(SmartBufferBudgetTest, WaitAsyncBecomesReadyWhenBytesFit) {
+    SmartBufferBudget budget(8192);
+    budget.reserve(8192);
+    std::future<void> ready = budget.wait_async(4096);
+    EXPECT_EQ(ready.wait_for(0ms), std::future_status::timeout);
+    
+    budget.unreserve(4096);
+    EXPECT_EQ(ready.wait_for(1s), std::future_status::ready);
+    EXPECT_EQ(budget.wait_async(4096).wait_for(0ms), std::future_status::ready);
+    
+    std::future<void> raised = budget.wait_async(16384);
+    budget.set_limit(32768);
+    EXPECT_EQ(raised.wait_for(1s), std::future_status::ready);
+}
+
+TEST(SmartBufferBudgetTest, ShardCreditNeverExceedsLimit) {
+    const std::size_t limit = 64 * 4096;
+    SmartBufferBudget budget(limit, std::pmr::new_delete_resource(), SmartBufferBudgetMode::Fail);
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> live_bytes{0};
+    std::atomic<std::size_t> max_live{0};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            std::vector<SmartBuffer4K> held;
+            for (int i = 0; i < 2000; ++i) {
+                if (auto buffer = budget.try_make<SmartBuffer4K>()) {
+                    held.push_back(std::move(*buffer));
+                    std::size_t now = live_bytes += 4096;
+                    std::size_t seen = max_live.load();
+                    while (now > seen && !max_live.compare_exchange_weak(seen, now)) {
+                    }
+                }
+                if (held.size() > 20 || (!held.empty() && i % 3 == 0)) {
+                    live_bytes -= 4096;
+                    held.pop_back();
+                }
+            }
+            live_bytes -= held.size() * 4096;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(max_live.load(), limit);
+    EXPECT_EQ(budget.used(), 0u);
+}
+
+TEST(SmartBufferBudgetTest, TenantBudgetChainsToProcessBudget) {
+    SmartBufferBudget process(16 * 4096);
+    SmartBufferBudget tenant(4 * 4096, &process, SmartBufferBudgetMode::Fail);
+    std::vector<SmartBuffer4K> held;
+    for (int i = 0; i < 4; ++i) {
+        held.emplace_back(&tenant);
+    }
+    EXPECT_FALSE(tenant.try_make<SmartBuffer4K>().has_value());
+    EXPECT_EQ(tenant.used(), 4u * 4096u);
+    EXPECT_EQ(process.used(), 4u * 4096u);
+    held.clear();
+    EXPECT_EQ(process.used(), 0u);
+}
@@ -0,0 +1,150 @@
+#include <smart_buffer_byte_queue.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string contents(const SmartBufferByteQueue<64>& queue) {
+    std::string out(queue.size(), '\0');
+    queue.copy_out(&out[0], out.size());
+    return out;
+}
+
+std::string pattern(size_t size) {
+    std::string out(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = static_cast<char>('a' + i % 26);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(SmartBufferPoolTest, RecyclesBuffers) {
+    SmartBufferPool<256> pool;
+    auto buffer = pool.acquire();
+    const uint8_t* storage = buffer.data();
+    buffer.fill(0xAB);
+    pool.release(std::move(buffer));
+    
+    auto recycled = pool.acquire_zeroed();
+    EXPECT_EQ(recycled.data(), storage);
+    EXPECT_EQ(recycled[10], 0);
+    
+    SmartBufferPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_EQ(stats.reuses, 1u);
+    EXPECT_EQ(stats.live, 1u);
+    EXPECT_EQ(stats.idle, 0u);
+}
+
+TEST(SmartBufferPoolTest, MaxIdleAndReserve) {
+    SmartBufferPool<128> pool(2);
+    pool.reserve(2);
+    EXPECT_EQ(pool.idle(), 2u);
+    
+    auto a = pool.acquire();
+    auto b = pool.acquire();
+    auto c = pool.acquire();
+    EXPECT_EQ(pool.stats().peak_live, 3u);
+    pool.release(std::move(a));
+    pool.release(std::move(b));
+    pool.release(std::move(c));
+    EXPECT_EQ(pool.idle(), 2u);
+    
+    pool.shrink();
+    EXPECT_EQ(pool.idle(), 0u);
+}
+
+TEST(SmartBufferByteQueueTest, AppendAcrossChunks) {
+    SmartBufferPool<64> pool;
+    SmartBufferByteQueue<64> queue(pool);
+    std::string data = pattern(200);
+    queue.append(data.data(), data.size());
+    
+    EXPECT_EQ(queue.size(), 200u);
+    EXPECT_EQ(queue.chunk_count(), 4u);
+    EXPECT_EQ(contents(queue), data);
+}
+
+TEST(SmartBufferByteQueueTest, PrependUsesHeadroom) {
+    SmartBufferPool<64> pool;
+    SmartBufferByteQueue<64> queue(pool, 16);
+    queue.append("body", 4);
+    EXPECT_EQ(queue.headroom(), 16u);
+    
+    queue.prepend("HDR:", 4);
+    EXPECT_EQ(queue.chunk_count(), 1u);
+    EXPECT_EQ(queue.headroom(), 12u);
+    EXPECT_EQ(contents(queue), "HDR:body");
+    
+    // Larger than the headroom: a new chunk is linked in front
+    std::string big = pattern(40);
+    queue.prepend(big.data(), big.size());
+    EXPECT_EQ(contents(queue), big + "HDR:body");
+}
+
+TEST(SmartBufferByteQueueTest, TrimFrontReturnsChunks) {
+    SmartBufferPool<64> pool;
+    SmartBufferByteQueue<64> queue(pool);
+    std::string data = pattern(300);
+    queue.append(data.data(), data.size());
+    
+    queue.trim_front(130);
+    EXPECT_EQ(queue.size(), 170u);
+    EXPECT_EQ(contents(queue), data.substr(130));
+    EXPECT_EQ(pool.idle(), 2u);
+    
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(pool.idle(), 5u);
+}
+
+TEST(SmartBufferByteQueueTest, GatherToIovec) {
+    SmartBufferPool<64> pool;
+    SmartBufferByteQueue<64> queue(pool, 8);
+    std::string data = pattern(150);
+    queue.append(data.data(), data.size());
+    
+    struct iovec iov[8];
+    size_t count = queue.gather(iov, 8);
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(iov[0].iov_len, 56u);
+    
+    std::string joined;
+    for (size_t i = 0; i < count; ++i) {
+        joined.append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+    }
+    EXPECT_EQ(joined, data);
+    EXPECT_EQ(queue.gather(iov, 1), 1u);
+}
+
+TEST(SmartBufferByteQueueTest, CoalesceOnlyWhenNeeded) {
+    SmartBufferPool<64> pool;
+    SmartBufferByteQueue<64> queue(pool);
+    std::string data = pattern(100);
+    queue.append(data.data(), data.size());
+    
+    // Already contiguous: no copy, no new chunk
+    const uint8_t* front = queue.coalesce(10);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(front), 10), data.substr(0, 10));
+    EXPECT_EQ(queue.chunk_count(), 2u);
+    
+    queue.trim_front(50);
+    const uint8_t* merged = queue.coalesce(30);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(merged), 30), data.substr(50, 30));
+    EXPECT_EQ(contents(queue), data.substr(50));
+    
+    EXPECT_THROW(queue.coalesce(65), std::length_error);
+}
+
+TEST(SmartBufferByteQueueTest, AppendRegion) {
+    SmartBufferPool<64> pool;
+    SmartBufferByteQueue<64> queue(pool);
+    SmartBufferSegment region = queue.append_region();
+    ASSERT_EQ(region.size, 64u);
+    std::memcpy(region.data, "xyz", 3);
+    queue.commit_append(3);
+    EXPECT_EQ(contents(queue), "xyz");
+}
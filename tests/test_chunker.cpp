@@ -0,0 +1,180 @@
+#include <smart_buffer_chunker.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint8_t> random_bytes(std::size_t size, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::uint8_t> data(size);
+    for (auto& byte : data) {
+        byte = static_cast<std::uint8_t>(rng());
+    }
+    return data;
+}
+
+// Textbook FastCDC with normalized chunking, one byte at a time
+std::size_t reference_cut(const std::uint8_t* data, std::size_t size, const SmartBufferChunkerParams& params) {
+    if (size <= params.min_size) {
+        return size;
+    }
+    std::size_t end = std::min(size, params.max_size);
+    unsigned bits = 63 - static_cast<unsigned>(__builtin_clzll(params.avg_size));
+    std::size_t normal = std::max<std::size_t>(std::size_t(1) << bits, params.min_size);
+    std::uint64_t mask_small = ~std::uint64_t(0) << (64 - (bits + 2));
+    std::uint64_t mask_large = ~std::uint64_t(0) << (64 - (bits - 2));
+    std::uint64_t fp = 0;
+    for (std::size_t i = params.min_size; i < end; ++i) {
+        fp = (fp << 1) + smart_buffer_detail::GEAR_TABLE.entries[data[i]];
+        if ((fp & (i < normal ? mask_small : mask_large)) == 0) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+struct Collected {
+    std::vector<std::size_t> sizes;
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::string> fingerprints;
+    std::vector<std::uint8_t> bytes;
+};
+
+template<std::size_t MaxSize>
+struct Collector {
+    SmartBufferChunker<MaxSize>* chunker;
+    Collected* out;
+
+    void operator()(typename SmartBufferChunker<MaxSize>::Chunk&& chunk) const {
+        out->sizes.push_back(chunk.size);
+        out->offsets.push_back(chunk.offset);
+        out->fingerprints.emplace_back(reinterpret_cast<const char*>(chunk.fingerprint.data()), 32);
+        out->bytes.insert(out->bytes.end(), chunk.buffer.data(), chunk.buffer.data() + chunk.size);
+        chunker->pool().release(std::move(chunk.buffer));
+    }
+};
+
+Collected chunk_in_pieces(const std::vector<std::uint8_t>& data, std::size_t piece) {
+    SmartBufferPool<64 * 1024> pool;
+    SmartBufferChunker<64 * 1024> chunker(pool);
+    Collected out;
+    Collector<64 * 1024> emit{&chunker, &out};
+    for (std::size_t offset = 0; offset < data.size(); offset += piece) {
+        chunker.update(data.data() + offset, std::min(piece, data.size() - offset), emit);
+    }
+    chunker.finish(emit);
+    return out;
+}
+
+} // namespace
+
+TEST(SmartBufferChunkerTest, CutPointsMatchReference) {
+    auto data = random_bytes(4 << 20, 1);
+    for (SmartBufferChunkerParams params : {SmartBufferChunkerParams{},
+                                            SmartBufferChunkerParams{2048, 8192, 32768},
+                                            SmartBufferChunkerParams{64, 256, 1024},
+                                            SmartBufferChunkerParams{8192, 16384, 65536}}) {
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            std::size_t remaining = data.size() - offset;
+            std::size_t expected = reference_cut(data.data() + offset, remaining, params);
+            ASSERT_EQ(smart_buffer_cdc_cut(data.data() + offset, remaining, params), expected)
+                << "offset " << offset << " avg " << params.avg_size;
+            offset += expected;
+        }
+    }
+}
+
+TEST(SmartBufferChunkerTest, EveryKernelMatchesScalar) {
+    using namespace smart_buffer_detail;
+    auto data = random_bytes(1 << 20, 2);
+    std::uint64_t mask = ~std::uint64_t(0) << 50;   // Sparse hits: whole windows are scanned
+    for (std::size_t from : {64u, 100u, 5000u}) {
+        std::size_t expected = gear_scan_scalar(data.data(), from, data.size(), 64, mask);
+#if SMART_BUFFER_X86_DISPATCH
+        if (__builtin_cpu_supports("avx2")) {
+            EXPECT_EQ(gear_scan_avx2(data.data(), from, data.size(), 64, mask), expected);
+        }
+        if (__builtin_cpu_supports("avx512f")) {
+            EXPECT_EQ(gear_scan_avx512(data.data(), from, data.size(), 64, mask), expected);
+        }
+#endif
+    }
+}
+
+TEST(SmartBufferChunkerTest, ChunksRespectBoundsAndReassemble) {
+    auto data = random_bytes(3 << 20, 3);
+    Collected out = chunk_in_pieces(data, data.size());
+    ASSERT_FALSE(out.sizes.empty());
+    EXPECT_EQ(out.bytes, data);
+    std::uint64_t offset = 0;
+    for (std::size_t i = 0; i < out.sizes.size(); ++i) {
+        EXPECT_EQ(out.offsets[i], offset);
+        EXPECT_LE(out.sizes[i], 64u * 1024);
+        if (i + 1 < out.sizes.size()) {
+            EXPECT_GT(out.sizes[i], 4u * 1024);
+        }
+        auto digest = smart_buffer_blake3(data.data() + offset, out.sizes[i]);
+        EXPECT_EQ(out.fingerprints[i], std::string(reinterpret_cast<const char*>(digest.data()), 32));
+        offset += out.sizes[i];
+    }
+    // Random data averages somewhat above avg_size with normalized chunking
+    double average = static_cast<double>(data.size()) / static_cast<double>(out.sizes.size());
+    EXPECT_GT(average, 12.0 * 1024);
+    EXPECT_LT(average, 28.0 * 1024);
+}
+
+TEST(SmartBufferChunkerTest, PieceSizeDoesNotChangeTheChunks) {
+    auto data = random_bytes(1 << 20, 4);
+    Collected whole = chunk_in_pieces(data, data.size());
+    for (std::size_t piece : {1000u, 4096u, 65536u, 100000u}) {
+        Collected pieces = chunk_in_pieces(data, piece);
+        EXPECT_EQ(pieces.sizes, whole.sizes) << "piece " << piece;
+        EXPECT_EQ(pieces.fingerprints, whole.fingerprints) << "piece " << piece;
+    }
+}
+
+TEST(SmartBufferChunkerTest, InsertionOnlyChangesNearbyChunks) {
+    auto data = random_bytes(2 << 20, 5);
+    Collected before = chunk_in_pieces(data, data.size());
+    data.insert(data.begin() + 1000000, {1, 2, 3, 4, 5, 6, 7});
+    Collected after = chunk_in_pieces(data, data.size());
+
+    std::set<std::string> known(before.fingerprints.begin(), before.fingerprints.end());
+    std::size_t changed = 0;
+    for (const auto& fingerprint : after.fingerprints) {
+        changed += known.count(fingerprint) == 0 ? 1 : 0;
+    }
+    EXPECT_LE(changed, 2u);
+}
+
+TEST(SmartBufferChunkerTest, ReadsFromFileDescriptor) {
+    auto data = random_bytes(500000, 6);
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fwrite(data.data(), 1, data.size(), file), data.size());
+    std::fflush(file);
+    std::rewind(file);
+
+    SmartBufferPool<64 * 1024> pool;
+    SmartBufferChunker<64 * 1024> chunker(pool);
+    Collected out;
+    EXPECT_EQ(chunker.read_fd(fileno(file), Collector<64 * 1024>{&chunker, &out}, 10000), data.size());
+    std::fclose(file);
+
+    EXPECT_EQ(out.bytes, data);
+    EXPECT_EQ(out.sizes, chunk_in_pieces(data, data.size()).sizes);
+    EXPECT_EQ(pool.stats().live, 0u);
+}
+
+TEST(SmartBufferChunkerTest, RejectsInconsistentBounds) {
+    SmartBufferPool<4096> pool;
+    EXPECT_THROW(SmartBufferChunker<4096>(pool, SmartBufferChunkerParams{1024, 512, 4096}), std::invalid_argument);
+    EXPECT_THROW(SmartBufferChunker<4096>(pool, SmartBufferChunkerParams{16, 512, 4096}), std::invalid_argument);
+    EXPECT_THROW(SmartBufferChunker<4096>(pool, SmartBufferChunkerParams{256, 1024, 8192}), std::invalid_argument);
+    EXPECT_NO_THROW(SmartBufferChunker<4096>(pool, SmartBufferChunkerParams{256, 1024, 4096}));
+}
@@ -0,0 +1,173 @@
+#include <smart_buffer_digest.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string hex(const SmartBuffer<32>& digest) {
+    static const char digits[] = "0123456789abcdef";
+    std::string text;
+    for (std::size_t i = 0; i < 32; ++i) {
+        text += digits[digest[i] >> 4];
+        text += digits[digest[i] & 15];
+    }
+    return text;
+}
+
+std::string sha256(const std::string& text) {
+    return hex(smart_buffer_sha256(text.data(), text.size()));
+}
+
+// The input pattern of the official BLAKE3 test vectors
+std::vector<std::uint8_t> pattern(std::size_t size) {
+    std::vector<std::uint8_t> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<std::uint8_t>(i % 251);
+    }
+    return data;
+}
+
+struct KnownAnswer {
+    std::size_t size;
+    const char* digest;
+};
+
+const KnownAnswer BLAKE3_VECTORS[] = {
+    {0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+    {1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213"},
+    {1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11"},
+    {1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"},
+    {1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+    {2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a"},
+    {2049, "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030"},
+    {3072, "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2"},
+    {3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3"},
+    {4096, "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969"},
+    {4097, "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995"},
+    {5120, "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833"},
+    {5121, "628bd2cb2004694adaab7bbd778a25df25c47b9d4155a55f8fbd79f2fe154cff"},
+    {8192, "aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63"},
+    {8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"},
+    {16384, "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4"},
+    {31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47"},
+    {102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085"},
+    {1048576, "74cb441fd087764ca9c3694da742ebe30cbeb3060a17009ca81825c7a8d10343"},
+    {1049576, "ad6644fef4a9c205339552c5b223063192e390ec085ca87b409efc35d7f6fea1"},
+};
+
+} // namespace
+
+TEST(SmartBufferDigestTest, Sha256NistVectors) {
+    EXPECT_EQ(sha256(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(sha256("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    EXPECT_EQ(sha256(std::string(1000000, 'a')), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(SmartBufferDigestTest, Sha256PaddingBoundaries) {
+    // 55 bytes is the longest message padded within one block, 56 needs a second
+    auto data = pattern(1000);
+    EXPECT_EQ(hex(smart_buffer_sha256(data.data(), 55)), "463eb28e72f82e0a96c0a4cc53690c571281131f672aa229e0d45ae59b598b59");
+    EXPECT_EQ(hex(smart_buffer_sha256(data.data(), 56)), "da2ae4d6b36748f2a318f23e7ab1dfdf45acdc9d049bd80e59de82a60895f562");
+    EXPECT_EQ(hex(smart_buffer_sha256(data.data(), 64)), "fdeab9acf3710362bd2658cdc9a29e8f9c757fcf9811603a8c447cd1d9151108");
+    EXPECT_EQ(hex(smart_buffer_sha256(data.data(), 1000)), "4e4c294b331f7a2099a379bec34b9f9fc03dc46ab465d998f4d683da53487e6d");
+}
+
+TEST(SmartBufferDigestTest, Sha256IncrementalMatchesOneShot) {
+    auto data = pattern(1000);
+    auto expected = hex(smart_buffer_sha256(data.data(), data.size()));
+    for (std::size_t step : {1u, 7u, 63u, 64u, 65u, 333u}) {
+        SmartBufferSha256 hasher;
+        for (std::size_t offset = 0; offset < data.size(); offset += step) {
+            hasher.update(data.data() + offset, std::min(step, data.size() - offset));
+        }
+        EXPECT_EQ(hex(hasher.finalize()), expected) << "step " << step;
+    }
+
+    // finalize() does not disturb the running state
+    SmartBufferSha256 hasher;
+    hasher.update(data.data(), 500);
+    EXPECT_EQ(hex(hasher.finalize()), hex(smart_buffer_sha256(data.data(), 500)));
+    hasher.update(data.data() + 500, 500);
+    EXPECT_EQ(hex(hasher.finalize()), expected);
+    hasher.reset();
+    EXPECT_EQ(hex(hasher.finalize()), sha256(""));
+}
+
+#if SMART_BUFFER_X86_DISPATCH
+TEST(SmartBufferDigestTest, Sha256KernelsAgree) {
+    if (!smart_buffer_sha256_accelerated()) {
+        GTEST_SKIP() << "no SHA extensions";
+    }
+    auto data = pattern(64 * 37);
+    std::uint32_t portable[8];
+    std::uint32_t accelerated[8];
+    std::memcpy(portable, smart_buffer_detail::SHA256_IV, sizeof(portable));
+    std::memcpy(accelerated, smart_buffer_detail::SHA256_IV, sizeof(accelerated));
+    smart_buffer_detail::sha256_compress_portable(portable, data.data(), 37);
+    smart_buffer_detail::sha256_compress_shani(accelerated, data.data(), 37);
+    EXPECT_EQ(0, std::memcmp(portable, accelerated, sizeof(portable)));
+}
+#endif
+
+TEST(SmartBufferDigestTest, Blake3OfficialVectors) {
+    EXPECT_EQ(hex(smart_buffer_blake3("abc", 3)), "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+    auto data = pattern(1049576);
+    for (const auto& vector : BLAKE3_VECTORS) {
+        EXPECT_EQ(hex(smart_buffer_blake3(data.data(), vector.size)), vector.digest) << "size " << vector.size;
+    }
+}
+
+TEST(SmartBufferDigestTest, Blake3ThreadsDoNotChangeTheDigest) {
+    auto data = pattern(1049576);
+    for (unsigned threads : {2u, 3u, 8u}) {
+        EXPECT_EQ(hex(smart_buffer_blake3(data.data(), 1048576, threads)),
+                  "74cb441fd087764ca9c3694da742ebe30cbeb3060a17009ca81825c7a8d10343");
+        EXPECT_EQ(hex(smart_buffer_blake3(data.data(), data.size(), threads)),
+                  "ad6644fef4a9c205339552c5b223063192e390ec085ca87b409efc35d7f6fea1");
+    }
+}
+
+TEST(SmartBufferDigestTest, Blake3IncrementalMatchesOneShot) {
+    auto data = pattern(102400);
+    const char* expected = "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085";
+    for (std::size_t step : {1u, 64u, 1000u, 1024u, 1025u, 4096u, 50000u}) {
+        SmartBufferBlake3 hasher;
+        for (std::size_t offset = 0; offset < data.size(); offset += step) {
+            hasher.update(data.data() + offset, std::min(step, data.size() - offset));
+        }
+        EXPECT_EQ(hex(hasher.finalize()), expected) << "step " << step;
+    }
+}
+
+TEST(SmartBufferDigestTest, SmartBufferAndSegmentOverloads) {
+    SmartBuffer<4096> buffer;
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<std::uint8_t>(i % 251);
+    }
+    EXPECT_EQ(hex(smart_buffer_blake3(buffer)), "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969");
+    EXPECT_EQ(hex(smart_buffer_sha256(buffer)), hex(smart_buffer_sha256(buffer.data(), buffer.size())));
+
+    SmartBufferConstSegment segments[] = {{buffer.data(), 1000}, {buffer.data() + 1000, 3096}};
+    EXPECT_EQ(hex(smart_buffer_blake3(segments, 2)), hex(smart_buffer_blake3(buffer)));
+    EXPECT_EQ(hex(smart_buffer_sha256(segments, 2)), hex(smart_buffer_sha256(buffer)));
+}
+
+TEST(SmartBufferDigestTest, Blake3SimdBatchMatchesPortable) {
+    // 40 chunks leaves a partial SIMD group for the portable tail
+    auto data = pattern(40 * 1024);
+    const std::uint8_t* inputs[40];
+    for (std::size_t i = 0; i < 40; ++i) {
+        inputs[i] = data.data() + i * 1024;
+    }
+    std::uint8_t batched[40 * 32];
+    std::uint8_t portable[40 * 32];
+    using namespace smart_buffer_detail;
+    blake3_hash_many(inputs, 40, 16, SHA256_IV, 5, true, 0, BLAKE3_CHUNK_START, BLAKE3_CHUNK_END, batched);
+    blake3_hash_many_portable(inputs, 40, 16, SHA256_IV, 5, true, 0, BLAKE3_CHUNK_START, BLAKE3_CHUNK_END, portable);
+    EXPECT_EQ(0, std::memcmp(batched, portable, sizeof(batched)));
+}
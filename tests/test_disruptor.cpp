@@ -0,0 +1,159 @@
+#include <smart_buffer_disruptor.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void put_u64(SmartBuffer<64>& event, std::size_t offset, std::uint64_t value) {
+    std::memcpy(event.data() + offset, &value, sizeof(value));
+}
+
+std::uint64_t get_u64(const SmartBuffer<64>& event, std::size_t offset) {
+    std::uint64_t value = 0;
+    std::memcpy(&value, event.data() + offset, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+TEST(SmartBufferDisruptorTest, RejectsNonPowerOfTwoCapacity) {
+    EXPECT_THROW(SmartBufferDisruptor<64> ring(12), std::invalid_argument);
+    SmartBufferDisruptor<64> ring(16);
+    EXPECT_EQ(ring.capacity(), 16u);
+}
+
+TEST(SmartBufferDisruptorTest, BatchClaimAndConsume) {
+    SmartBufferDisruptor<64> ring(8);
+    auto& stage = ring.add_stage();
+    
+    auto first = ring.claim(3);
+    EXPECT_EQ(first, 0);
+    for (auto seq = first; seq < first + 3; ++seq) {
+        put_u64(ring[seq], 0, static_cast<std::uint64_t>(seq) * 10);
+    }
+    ring.publish(first, 3);
+    
+    std::vector<std::uint64_t> seen;
+    int batch_ends = 0;
+    std::size_t count = ring.consume(stage, [&](SmartBuffer<64>& event, std::int64_t, bool end_of_batch) {
+        seen.push_back(get_u64(event, 0));
+        batch_ends += end_of_batch;
+    });
+    EXPECT_EQ(count, 3u);
+    EXPECT_EQ(seen, (std::vector<std::uint64_t>{0, 10, 20}));
+    EXPECT_EQ(batch_ends, 1);
+    EXPECT_EQ(stage.sequence(), 2);
+}
+
+TEST(SmartBufferDisruptorTest, RejectsClaimsThatCannotFit) {
+    SmartBufferDisruptor<64> ring(8);
+    ring.add_stage();
+    EXPECT_THROW(ring.claim(0), std::invalid_argument);
+    EXPECT_THROW(ring.claim(9), std::invalid_argument);
+    
+    // Rejected claims reserve nothing
+    EXPECT_EQ(ring.claim(8), 0);
+    ring.publish(0, 8);
+}
+
+TEST(SmartBufferDisruptorTest, PipelineStagesSeeEventsInOrderAfterUpstream) {
+    constexpr std::uint64_t kEvents = 20000;
+    SmartBufferDisruptor<64, SmartBufferFutexWait> ring(16);
+    auto& parse = ring.add_stage();
+    auto& enrich = ring.add_stage({&parse});
+    auto& journal = ring.add_stage();          // Runs in parallel with parse
+    auto& commit = ring.add_stage({&enrich, &journal});
+    
+    std::thread parse_thread([&] {
+        for (std::uint64_t done = 0; done < kEvents;) {
+            done += ring.consume(parse, [](SmartBuffer<64>& event, std::int64_t, bool) {
+                put_u64(event, 8, get_u64(event, 0) + 1);
+            });
+        }
+    });
+    std::thread enrich_thread([&] {
+        for (std::uint64_t done = 0; done < kEvents;) {
+            done += ring.consume(enrich, [](SmartBuffer<64>& event, std::int64_t, bool) {
+                put_u64(event, 16, get_u64(event, 8) * 2);
+            });
+        }
+    });
+    std::thread journal_thread([&] {
+        for (std::uint64_t done = 0; done < kEvents;) {
+            done += ring.consume(journal, [](SmartBuffer<64>& event, std::int64_t, bool) {
+                put_u64(event, 24, get_u64(event, 0));
+            });
+        }
+    });
+    
+    std::uint64_t errors = 0;
+    std::uint64_t expected = 0;
+    std::thread commit_thread([&] {
+        while (expected < kEvents) {
+            ring.consume(commit, [&](SmartBuffer<64>& event, std::int64_t, bool) {
+                errors += get_u64(event, 0) != expected;
+                errors += get_u64(event, 16) != (expected + 1) * 2;
+                errors += get_u64(event, 24) != expected;
+                ++expected;
+            });
+        }
+    });
+    
+    for (std::uint64_t i = 0; i < kEvents;) {
+        std::size_t batch = 1 + i % 4;
+        batch = static_cast<std::size_t>(std::min<std::uint64_t>(batch, kEvents - i));
+        auto first = ring.claim(batch);
+        for (std::size_t k = 0; k < batch; ++k) {
+            put_u64(ring[first + static_cast<std::int64_t>(k)], 0, i + k);
+        }
+        ring.publish(first, batch);
+        i += batch;
+    }
+    
+    parse_thread.join();
+    enrich_thread.join();
+    journal_thread.join();
+    commit_thread.join();
+    EXPECT_EQ(errors, 0u);
+    EXPECT_EQ(expected, kEvents);
+}
+
+TEST(SmartBufferDisruptorTest, MultipleProducersDeliverEveryEventOnce) {
+    constexpr int kProducers = 3;
+    constexpr std::uint64_t kPerProducer = 5000;
+    SmartBufferDisruptor<64> ring(32);
+    auto& stage = ring.add_stage();
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (std::uint64_t i = 0; i < kPerProducer; ++i) {
+                auto seq = ring.claim();
+                put_u64(ring[seq], 0, static_cast<std::uint64_t>(p));
+                put_u64(ring[seq], 8, i);
+                ring.publish(seq);
+            }
+        });
+    }
+    
+    std::vector<std::uint64_t> next(kProducers, 0);
+    std::uint64_t errors = 0;
+    std::uint64_t total = 0;
+    while (total < kProducers * kPerProducer) {
+        total += ring.consume(stage, [&](SmartBuffer<64>& event, std::int64_t, bool) {
+            std::uint64_t producer = get_u64(event, 0);
+            errors += get_u64(event, 8) != next[producer]++;   // Per-producer order is kept
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(errors, 0u);
+    for (std::uint64_t count : next) {
+        EXPECT_EQ(count, kPerProducer);
+    }
+}
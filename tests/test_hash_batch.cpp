@@ -0,0 +1,90 @@
+#include <smart_buffer_hash_batch.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+template<std::size_t Size>
+std::vector<SmartBuffer<Size>> random_buffers(std::size_t count) {
+    std::mt19937_64 rng(Size);
+    std::vector<SmartBuffer<Size>> buffers(count);
+    for (auto& buffer : buffers) {
+        for (std::size_t i = 0; i < Size; ++i) {
+            buffer[i] = static_cast<std::uint8_t>(rng());
+        }
+    }
+    return buffers;
+}
+
+template<std::size_t Size>
+void expect_batch_matches_single(std::size_t count) {
+    auto buffers = random_buffers<Size>(count);
+    std::vector<std::uint64_t> hashes(count);
+    std::vector<std::uint32_t> crcs(count);
+    smart_buffer_hash_batch(buffers.data(), count, hashes.data(), 7);
+    smart_buffer_crc32c_batch(buffers.data(), count, crcs.data());
+    for (std::size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(hashes[i], smart_buffer_hash(buffers[i], 7)) << "size " << Size << " buffer " << i;
+        ASSERT_EQ(crcs[i], smart_buffer_crc32c(buffers[i].data(), Size)) << "size " << Size << " buffer " << i;
+    }
+}
+
+} // namespace
+
+TEST(SmartBufferHashBatchTest, Crc32cKnownAnswers) {
+    EXPECT_EQ(smart_buffer_crc32c("", 0), 0u);
+    EXPECT_EQ(smart_buffer_crc32c("123456789", 9), 0xE3069283u);
+    // Continuing from a previous result gives the CRC of the concatenation
+    std::uint32_t partial = smart_buffer_crc32c("1234", 4);
+    EXPECT_EQ(smart_buffer_crc32c("56789", 5, partial), 0xE3069283u);
+    
+    std::vector<std::uint8_t> zeros(32, 0);
+    EXPECT_EQ(smart_buffer_crc32c(zeros.data(), zeros.size()), 0x8A9136AAu);
+}
+
+TEST(SmartBufferHashBatchTest, BatchMatchesOneAtATime) {
+    // Counts that leave partial SIMD groups and partial blocks
+    for (std::size_t count : {0u, 1u, 5u, 16u, 17u, 63u, 64u, 100u}) {
+        expect_batch_matches_single<32>(count);
+        expect_batch_matches_single<13>(count);
+        expect_batch_matches_single<64>(count);
+        expect_batch_matches_single<100>(count);
+    }
+}
+
+TEST(SmartBufferHashBatchTest, PointerOverloadHashesScatteredBuffers) {
+    auto buffers = random_buffers<32>(40);
+    std::vector<const SmartBuffer<32>*> pointers;
+    for (std::size_t i = buffers.size(); i-- > 0;) {
+        pointers.push_back(&buffers[i]);
+    }
+    std::vector<std::uint64_t> hashes(pointers.size());
+    smart_buffer_hash_batch(pointers.data(), pointers.size(), hashes.data());
+    for (std::size_t i = 0; i < pointers.size(); ++i) {
+        EXPECT_EQ(hashes[i], smart_buffer_hash(*pointers[i]));
+    }
+}
+
+#if SMART_BUFFER_X86_DISPATCH
+TEST(SmartBufferHashBatchTest, EveryKernelMatchesScalar) {
+    auto buffers = random_buffers<40>(32);
+    const std::uint8_t* data[32];
+    for (std::size_t i = 0; i < 32; ++i) {
+        data[i] = buffers[i].data();
+    }
+    std::uint64_t out[32] = {};
+    if (__builtin_cpu_supports("avx2")) {
+        smart_buffer_detail::xxh64_batch_avx2<40>(data, 32, out, 3);
+        for (std::size_t i = 0; i < 32; ++i) {
+            EXPECT_EQ(out[i], smart_buffer_hash(buffers[i], 3));
+        }
+    }
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        smart_buffer_detail::xxh64_batch_avx512<40>(data, 32, out, 3);
+        for (std::size_t i = 0; i < 32; ++i) {
+            EXPECT_EQ(out[i], smart_buffer_hash(buffers[i], 3));
+        }
+    }
+}
+#endif
@@ -0,0 +1,143 @@
+#include <smart_buffer_hash_stream.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint8_t> random_bytes(std::size_t size) {
+    std::mt19937_64 rng(size);
+    std::vector<std::uint8_t> data(size);
+    for (auto& byte : data) {
+        byte = static_cast<std::uint8_t>(rng());
+    }
+    return data;
+}
+
+std::vector<SmartBuffer4K> random_chunks(std::size_t count) {
+    std::mt19937_64 rng(count);
+    std::vector<SmartBuffer4K> chunks(count);
+    for (auto& chunk : chunks) {
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            chunk[i] = static_cast<std::uint8_t>(rng());
+        }
+    }
+    return chunks;
+}
+
+std::vector<std::uint8_t> concatenate(const std::vector<SmartBuffer4K>& chunks) {
+    std::vector<std::uint8_t> payload;
+    for (const auto& chunk : chunks) {
+        payload.insert(payload.end(), chunk.data(), chunk.data() + chunk.size());
+    }
+    return payload;
+}
+
+} // namespace
+
+TEST(SmartBufferHashStreamTest, CombineMatchesOneShot) {
+    auto data = random_bytes(10000);
+    std::uint32_t whole = smart_buffer_crc32c(data.data(), data.size());
+    for (std::size_t split : {0u, 1u, 7u, 8u, 4096u, 9999u, 10000u}) {
+        std::uint32_t a = smart_buffer_crc32c(data.data(), split);
+        std::uint32_t b = smart_buffer_crc32c(data.data() + split, data.size() - split);
+        EXPECT_EQ(smart_buffer_crc32c_combine(a, b, data.size() - split), whole) << "split " << split;
+    }
+    EXPECT_EQ(smart_buffer_crc32c_combine(smart_buffer_crc32c("1234", 4), smart_buffer_crc32c("56789", 5), 5),
+              0xE3069283u);
+}
+
+TEST(SmartBufferHashStreamTest, CombineEqualChunks) {
+    auto chunks = random_chunks(37);
+    std::vector<std::uint32_t> crcs;
+    for (const auto& chunk : chunks) {
+        crcs.push_back(smart_buffer_crc32c(chunk.data(), chunk.size()));
+    }
+    auto payload = concatenate(chunks);
+    std::uint32_t expected = smart_buffer_crc32c(payload.data(), payload.size());
+    EXPECT_EQ(smart_buffer_crc32c_combine(crcs.data(), crcs.size(), 4096), expected);
+    EXPECT_EQ(smart_buffer_crc32c_combine(crcs.data(), 0, 4096), 0u);
+}
+
+TEST(SmartBufferHashStreamTest, ParallelChunkCrcsMergeToOneShot) {
+    auto chunks = random_chunks(64);
+    auto payload = concatenate(chunks);
+
+    // Four threads each checksum a quarter of the chunks with a streaming hasher
+    SmartBufferCrc32c parts[4];
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = t * 16; i < (t + 1) * 16; ++i) {
+                parts[t].update(chunks[i]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    SmartBufferCrc32c merged;
+    for (const auto& part : parts) {
+        merged.append(part);
+    }
+    EXPECT_EQ(merged.length(), payload.size());
+    EXPECT_EQ(merged.finalize(), smart_buffer_crc32c(payload.data(), payload.size()));
+}
+
+TEST(SmartBufferHashStreamTest, StreamingCrcMatchesOneShot) {
+    auto data = random_bytes(5000);
+    SmartBufferCrc32c crc;
+    for (std::size_t offset = 0; offset < data.size(); offset += 333) {
+        crc.update(data.data() + offset, std::min<std::size_t>(333, data.size() - offset));
+    }
+    EXPECT_EQ(crc.finalize(), smart_buffer_crc32c(data.data(), data.size()));
+    crc.reset();
+    EXPECT_EQ(crc.finalize(), 0u);
+    EXPECT_EQ(crc.length(), 0u);
+}
+
+TEST(SmartBufferHashStreamTest, StreamingXxh64MatchesOneShot) {
+    auto data = random_bytes(1000);
+    for (std::size_t size : {0u, 5u, 31u, 32u, 33u, 100u, 1000u}) {
+        std::uint64_t expected = smart_buffer_detail::xxh64(data.data(), size, 9);
+        for (std::size_t step : {1u, 3u, 31u, 32u, 64u, 1000u}) {
+            SmartBufferXxh64 hasher(9);
+            for (std::size_t offset = 0; offset < size; offset += step) {
+                hasher.update(data.data() + offset, std::min(step, size - offset));
+            }
+            EXPECT_EQ(hasher.finalize(), expected) << "size " << size << " step " << step;
+        }
+    }
+}
+
+TEST(SmartBufferHashStreamTest, StreamingOverChunksMatchesCopy) {
+    auto chunks = random_chunks(10);
+    auto payload = concatenate(chunks);
+    SmartBufferXxh64 hasher;
+    SmartBufferCrc32c crc;
+    for (const auto& chunk : chunks) {
+        hasher.update(chunk);
+        crc.update(SmartBufferConstSegment{chunk.data(), chunk.size()});
+    }
+    EXPECT_EQ(hasher.finalize(), smart_buffer_detail::xxh64(payload.data(), payload.size(), 0));
+    EXPECT_EQ(crc.finalize(), smart_buffer_crc32c(payload.data(), payload.size()));
+
+    // A single SmartBuffer streams to smart_buffer_hash()
+    EXPECT_EQ(SmartBufferXxh64(4).update(chunks[0]).finalize(), smart_buffer_hash(chunks[0], 4));
+}
+
+#if SMART_BUFFER_X86_DISPATCH
+TEST(SmartBufferHashStreamTest, CarrylessMultiplyMatchesPortable) {
+    if (!smart_buffer_detail::has_clmul_instruction()) {
+        GTEST_SKIP() << "no pclmulqdq";
+    }
+    std::mt19937 rng(5);
+    for (int i = 0; i < 1000; ++i) {
+        std::uint32_t a = rng();
+        std::uint32_t b = rng();
+        ASSERT_EQ(smart_buffer_detail::crc32c_multiply_hw(a, b), smart_buffer_detail::crc32c_multiply_sw(a, b));
+    }
+}
+#endif
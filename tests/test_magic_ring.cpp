@@ -0,0 +1,78 @@
+#include <smart_buffer_magic_ring.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(SmartBufferMagicRingTest, DoubleMappingAliases) {
+    SmartBufferMagicRing<4096> ring;
+    SmartBufferSegment region = ring.write_region();
+    ASSERT_EQ(region.size, 4096u);
+    
+    region.data[0] = 0x5A;
+    // The byte one capacity past the start aliases the same page
+    EXPECT_EQ(region.data[4096], 0x5A);
+}
+
+TEST(SmartBufferMagicRingTest, WrappedRegionsAreContiguous) {
+    SmartBufferMagicRing<4096> ring;
+    std::vector<uint8_t> filler(3000, 1);
+    ASSERT_TRUE(ring.try_write(filler.data(), filler.size()));
+    std::vector<uint8_t> sink(3000);
+    ASSERT_TRUE(ring.try_read(sink.data(), sink.size()));
+    
+    // This record starts at offset 3000 and wraps past the end of the ring
+    std::vector<uint8_t> record(2000);
+    for (size_t i = 0; i < record.size(); ++i) {
+        record[i] = static_cast<uint8_t>(i * 13);
+    }
+    ASSERT_TRUE(ring.try_write(record.data(), record.size()));
+    
+    SmartBufferConstSegment readable = ring.read_region();
+    ASSERT_EQ(readable.size, record.size());
+    for (size_t i = 0; i < record.size(); ++i) {
+        EXPECT_EQ(readable.data[i], record[i]);
+    }
+    ring.commit_read(readable.size);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SmartBufferMagicRingTest, FullAndEmpty) {
+    SmartBufferMagicRing<4096> ring;
+    std::vector<uint8_t> block(4096, 7);
+    uint8_t byte = 0;
+    
+    EXPECT_FALSE(ring.try_read(&byte, 1));
+    EXPECT_TRUE(ring.try_write(block.data(), block.size()));
+    EXPECT_FALSE(ring.try_write(&byte, 1));
+    EXPECT_EQ(ring.write_region().size, 0u);
+    EXPECT_EQ(ring.size(), 4096u);
+}
+
+TEST(SmartBufferMagicRingTest, ProducerConsumerThreads) {
+    SmartBufferMagicRing<8192> ring;
+    const uint32_t records = 20000;
+    
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < records; ++i) {
+            while (!ring.try_write(&i, sizeof(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    uint32_t expected = 0;
+    while (expected < records) {
+        SmartBufferConstSegment region = ring.read_region();
+        size_t whole = region.size / sizeof(uint32_t) * sizeof(uint32_t);
+        for (size_t offset = 0; offset < whole; offset += sizeof(uint32_t)) {
+            uint32_t value;
+            std::memcpy(&value, region.data + offset, sizeof(value));
+            ASSERT_EQ(value, expected++);
+        }
+        ring.commit_read(whole);
+        if (whole == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
@@ -0,0 +1,162 @@
+#include <smart_buffer_merkle.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Tree = SmartBufferMerkleTree<64>;
+
+std::vector<Tree::Block> random_blocks(std::size_t count, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<Tree::Block> blocks(count);
+    for (auto& block : blocks) {
+        for (std::size_t i = 0; i < block.size(); ++i) {
+            block[i] = static_cast<std::uint8_t>(rng());
+        }
+    }
+    return blocks;
+}
+
+std::string hex(const Tree::Digest& digest) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (std::size_t i = 0; i < digest.size(); ++i) {
+        out += digits[digest[i] >> 4];
+        out += digits[digest[i] & 15];
+    }
+    return out;
+}
+
+// RFC 6962 section 2.1: split at the largest power of two below n
+Tree::Digest reference_root(const Tree::Block* blocks, std::size_t count) {
+    if (count == 1) {
+        return Tree::hash_leaf(blocks[0]);
+    }
+    std::size_t split = 1;
+    while (split * 2 < count) {
+        split *= 2;
+    }
+    auto left = reference_root(blocks, split);
+    auto right = reference_root(blocks + split, count - split);
+    return Tree::hash_node(left.data(), right.data());
+}
+
+} // namespace
+
+TEST(SmartBufferMerkleTest, RootMatchesRfc6962) {
+    auto blocks = random_blocks(100, 1);
+    for (std::size_t count : {1u, 2u, 3u, 4u, 5u, 7u, 8u, 13u, 64u, 100u}) {
+        Tree tree(blocks.data(), count);
+        EXPECT_EQ(hex(tree.root()), hex(reference_root(blocks.data(), count))) << "count " << count;
+    }
+
+    auto left = Tree::hash_leaf(blocks[0]);
+    auto right = Tree::hash_leaf(blocks[1]);
+    EXPECT_EQ(hex(Tree(blocks.data(), 2).root()), hex(Tree::hash_node(left.data(), right.data())));
+}
+
+TEST(SmartBufferMerkleTest, EmptyTree) {
+    Tree tree;
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_EQ(tree.level_count(), 0u);
+    EXPECT_EQ(hex(tree.root()), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_THROW(tree.prove(0), std::out_of_range);
+}
+
+TEST(SmartBufferMerkleTest, ThreadCountDoesNotChangeRoot) {
+    auto blocks = random_blocks(10007, 2);
+    std::string expected = hex(Tree(blocks.data(), blocks.size(), 1).root());
+    for (unsigned threads : {0u, 2u, 4u, 7u}) {
+        EXPECT_EQ(hex(Tree(blocks.data(), blocks.size(), threads).root()), expected) << "threads " << threads;
+    }
+    EXPECT_EQ(Tree(blocks.data(), blocks.size()).level_count(), 15u);
+}
+
+TEST(SmartBufferMerkleTest, UpdateMatchesRebuild) {
+    auto blocks = random_blocks(37, 3);
+    Tree tree(blocks.data(), blocks.size());
+    std::mt19937_64 rng(3);
+    for (int round = 0; round < 50; ++round) {
+        std::size_t index = rng() % blocks.size();
+        blocks[index][rng() % 64] ^= 0x5a;
+        tree.update(index, blocks[index]);
+        ASSERT_EQ(hex(tree.root()), hex(Tree(blocks.data(), blocks.size()).root())) << "round " << round;
+        ASSERT_EQ(hex(tree.leaf(index)), hex(Tree::hash_leaf(blocks[index])));
+    }
+    EXPECT_THROW(tree.update(blocks.size(), blocks[0]), std::out_of_range);
+}
+
+TEST(SmartBufferMerkleTest, ProofsVerifyForEveryBlock) {
+    auto blocks = random_blocks(100, 4);
+    for (std::size_t count : {1u, 2u, 3u, 5u, 8u, 13u, 100u}) {
+        Tree tree(blocks.data(), count);
+        auto root = tree.root();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto proof = tree.prove(i);
+            EXPECT_LE(proof.siblings.size(), tree.level_count() - 1);
+            EXPECT_TRUE(Tree::verify(root, count, blocks[i], proof)) << "count " << count << " index " << i;
+        }
+        EXPECT_THROW(tree.prove(count), std::out_of_range);
+    }
+}
+
+TEST(SmartBufferMerkleTest, ProofsRejectTampering) {
+    auto blocks = random_blocks(13, 5);
+    Tree tree(blocks.data(), blocks.size());
+    auto root = tree.root();
+    auto proof = tree.prove(6);
+    ASSERT_TRUE(Tree::verify(root, 13, blocks[6], proof));
+
+    EXPECT_FALSE(Tree::verify(root, 13, blocks[7], proof));
+
+    auto modified = blocks[6];
+    modified[0] ^= 1;
+    EXPECT_FALSE(Tree::verify(root, 13, modified, proof));
+
+    auto moved = proof;
+    moved.index = 7;
+    EXPECT_FALSE(Tree::verify(root, 13, blocks[6], moved));
+    moved.index = 13;
+    EXPECT_FALSE(Tree::verify(root, 13, blocks[6], moved));
+
+    auto tampered = proof;
+    tampered.siblings[1][0] ^= 1;
+    EXPECT_FALSE(Tree::verify(root, 13, blocks[6], tampered));
+
+    auto truncated = proof;
+    truncated.siblings.pop_back();
+    EXPECT_FALSE(Tree::verify(root, 13, blocks[6], truncated));
+
+    auto extended = proof;
+    extended.siblings.push_back(root);
+    EXPECT_FALSE(Tree::verify(root, 13, blocks[6], extended));
+
+    // A stale proof fails once the tree moves on
+    blocks[0][0] ^= 1;
+    tree.update(0, blocks[0]);
+    EXPECT_FALSE(Tree::verify(tree.root(), 13, blocks[6], proof));
+    EXPECT_TRUE(Tree::verify(tree.root(), 13, blocks[6], tree.prove(6)));
+
+    // Block 1's proof in a 2-block tree, replayed as index 2 of a 3-block tree, would
+    // recompute the same root; the verifier's own tree size rejects it
+    Tree pair(blocks.data(), 2);
+    auto forged = pair.prove(1);
+    ASSERT_TRUE(Tree::verify(pair.root(), 2, blocks[1], forged));
+    forged.index = 2;
+    EXPECT_FALSE(Tree::verify(pair.root(), pair.size(), blocks[1], forged));
+}
+
+TEST(SmartBufferMerkleTest, FourKilobyteBlocks) {
+    std::vector<SmartBuffer4K> blocks(9);
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i][i] = static_cast<std::uint8_t>(i + 1);
+    }
+    SmartBufferMerkleTree<> tree(blocks.data(), blocks.size(), 3);
+    EXPECT_EQ(tree.size(), 9u);
+    EXPECT_EQ(tree.level_count(), 5u);
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        EXPECT_TRUE(SmartBufferMerkleTree<>::verify(tree.root(), tree.size(), blocks[i], tree.prove(i)));
+    }
+}
@@ -0,0 +1,65 @@
+#include <smart_buffer_percpu.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(SmartBufferPerCpuScratchTest, CurrentCpuIsInRange) {
+    unsigned cpu = smart_buffer_detail::current_cpu();
+    EXPECT_LT(cpu, smart_buffer_detail::possible_cpus());
+    
+    SmartBufferPerCpuScratch<1024> scratch;
+    EXPECT_EQ(scratch.slot_count(), smart_buffer_detail::possible_cpus());
+}
+
+TEST(SmartBufferPerCpuScratchTest, LeaseReusesTheCpuBuffer) {
+    SmartBufferPerCpuScratch<1024> scratch(1);   // One slot: every CPU maps to it
+    std::uint8_t* first = nullptr;
+    {
+        auto lease = scratch.lease();
+        EXPECT_FALSE(lease.is_fallback());
+        lease->data()[0] = 42;
+        first = lease->data();
+    }
+    int value = scratch.with([&](SmartBuffer<1024>& buffer) {
+        EXPECT_EQ(buffer.data(), first);
+        return buffer[0];
+    });
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(scratch.stats().fallbacks, 0u);
+}
+
+TEST(SmartBufferPerCpuScratchTest, BusySlotFallsBackToPrivateBuffer) {
+    SmartBufferPerCpuScratch<1024> scratch(1);
+    auto outer = scratch.lease();
+    outer->data()[0] = 1;
+    {
+        auto inner = scratch.lease();
+        EXPECT_TRUE(inner.is_fallback());
+        EXPECT_NE(inner->data(), outer->data());
+    }
+    EXPECT_EQ(outer->data()[0], 1);
+    EXPECT_EQ(scratch.stats().fallbacks, 1u);
+}
+
+TEST(SmartBufferPerCpuScratchTest, LeasesAreExclusiveAcrossThreads) {
+    SmartBufferPerCpuScratch<256> scratch(2);
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 20000; ++i) {
+                scratch.with([&](SmartBuffer<256>& buffer) {
+                    buffer.fill(static_cast<std::uint8_t>(t));
+                    if (buffer[0] != t || buffer[255] != t) {
+                        ++errors;
+                    }
+                });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(errors.load(), 0);
+}
@@ -0,0 +1,104 @@
+#include <smart_buffer_rcu.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Counts live versions so tests can observe reclamation
+struct Tracked {
+    static inline std::atomic<int> live{0};
+    int value = 0;
+    
+    Tracked() { ++live; }
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    ~Tracked() { --live; }
+};
+
+} // namespace
+
+TEST(SmartBufferRcuTest, ReadersSeePublishedVersions) {
+    using Table = SmartBuffer<1 << 20>;
+    SmartBufferRcu<Table> rcu;
+    auto reader = rcu.make_reader();
+    {
+        auto guard = reader.read();
+        EXPECT_EQ((*guard)[0], 0);
+    }
+    rcu.update([](Table& table) { table[0] = 7; });
+    EXPECT_EQ(reader.read()->data()[0], 7);
+    EXPECT_EQ(rcu.version(), 1u);
+}
+
+TEST(SmartBufferRcuTest, OldVersionLivesWhilePinned) {
+    {
+        SmartBufferRcu<Tracked> rcu(std::make_unique<Tracked>(1));
+        auto reader = rcu.make_reader();
+        {
+            auto guard = reader.read();
+            rcu.publish(std::make_unique<Tracked>(2));
+            EXPECT_EQ(guard->value, 1);
+            EXPECT_EQ(rcu.retired(), 1u);
+            EXPECT_EQ(Tracked::live.load(), 2);
+            {
+                auto nested = reader.read();  // Nested sections keep the outer pin
+                EXPECT_EQ(nested->value, 2);
+            }
+            EXPECT_EQ(rcu.reclaim(), 0u);
+        }
+        EXPECT_EQ(rcu.reclaim(), 1u);
+        EXPECT_EQ(Tracked::live.load(), 1);
+        
+        // A reader that is not inside a read section does not hold anything back
+        rcu.publish(std::make_unique<Tracked>(3));
+        EXPECT_EQ(rcu.retired(), 0u);
+        EXPECT_EQ(reader.read()->value, 3);
+    }
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
+
+TEST(SmartBufferRcuTest, ReaderSlotsAreLimitedAndReused) {
+    SmartBufferRcu<Tracked> rcu(std::make_unique<Tracked>(), 2);
+    {
+        auto first = rcu.make_reader();
+        auto second = rcu.make_reader();
+        EXPECT_THROW(rcu.make_reader(), std::length_error);
+    }
+    auto again = rcu.make_reader();
+    EXPECT_EQ(again.read()->value, 0);
+}
+
+TEST(SmartBufferRcuTest, ConcurrentReadersSeeCompleteVersions) {
+    using Table = SmartBuffer<1 << 16>;
+    SmartBufferRcu<Table> rcu;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            auto reader = rcu.make_reader();
+            while (!done.load(std::memory_order_relaxed)) {
+                auto guard = reader.read();
+                const Table& table = *guard;
+                if (table[0] != table[table.size() / 2] || table[0] != table[table.size() - 1]) {
+                    ++torn;
+                }
+            }
+        });
+    }
+    for (int i = 1; i <= 200; ++i) {
+        rcu.update([i](Table& table) { table.fill(static_cast<std::uint8_t>(i)); });
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    rcu.synchronize();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(rcu.retired(), 0u);
+    EXPECT_EQ(rcu.version(), 200u);
+}
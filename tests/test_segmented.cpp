@@ -0,0 +1,79 @@
+#include <smart_buffer_segmented.hpp>
+#include <gtest/gtest.h>
+
+TEST(SmartBufferSegmentedTest, Geometry) {
+    SmartBufferSegmented<10000, 12> buffer;
+    EXPECT_EQ(buffer.size(), 10000u);
+    EXPECT_EQ(buffer.segment_size(), 4096u);
+    EXPECT_EQ(buffer.segment_count(), 3u);
+    EXPECT_EQ(buffer.segment(0).size, 4096u);
+    EXPECT_EQ(buffer.segment(2).size, 10000u - 8192u);
+    EXPECT_EQ(buffer.allocated_bytes(), 3u * 4096u);
+}
+
+TEST(SmartBufferSegmentedTest, RandomAccessAcrossSegments) {
+    SmartBufferSegmented<1 << 16, 10> buffer;
+    for (size_t i = 0; i < buffer.size(); i += 97) {
+        buffer[i] = static_cast<uint8_t>(i);
+    }
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        EXPECT_EQ(buffer[i], i % 97 == 0 ? static_cast<uint8_t>(i) : 0);
+    }
+    
+    // Segment spans alias the same bytes as operator[]
+    EXPECT_EQ(&buffer[1024 + 5], buffer.segment(1).data + 5);
+}
+
+TEST(SmartBufferSegmentedTest, SegmentIteration) {
+    SmartBufferSegmented<5000, 10> buffer;
+    buffer.fill(1);
+    
+    size_t total = 0;
+    size_t visited = 0;
+    const auto& view = buffer;
+    view.for_each_segment([&](size_t index, SmartBufferConstSegment segment) {
+        EXPECT_EQ(index, visited++);
+        for (size_t i = 0; i < segment.size; ++i) {
+            total += segment.data[i];
+        }
+    });
+    EXPECT_EQ(visited, buffer.segment_count());
+    EXPECT_EQ(total, 5000u);
+}
+
+TEST(SmartBufferSegmentedTest, LazyAllocation) {
+    SmartBufferSegmentedLazy<1 << 20, 12> buffer;
+    EXPECT_TRUE(buffer.is_lazy());
+    EXPECT_EQ(buffer.allocated_bytes(), 0u);
+    
+    // Const reads see zeros without allocating
+    const auto& view = buffer;
+    EXPECT_EQ(view[12345], 0);
+    EXPECT_EQ(buffer.allocated_bytes(), 0u);
+    
+    buffer[12345] = 0x42;
+    EXPECT_EQ(buffer.allocated_bytes(), 4096u);
+    EXPECT_TRUE(buffer.is_segment_allocated(12345 >> 12));
+    EXPECT_EQ(view[12345], 0x42);
+    
+    buffer.clear();
+    EXPECT_EQ(buffer.allocated_bytes(), 0u);
+    EXPECT_EQ(view[12345], 0);
+}
+
+TEST(SmartBufferSegmentedTest, CopyAndMove) {
+    SmartBufferSegmentedLazy<1 << 16, 10> original;
+    original[2000] = 7;
+    
+    SmartBufferSegmentedLazy<1 << 16, 10> copy(original);
+    EXPECT_EQ(copy.allocated_bytes(), 1024u);
+    EXPECT_EQ(copy[2000], 7);
+    copy[2000] = 8;
+    EXPECT_EQ(original[2000], 7);
+    
+    SmartBufferSegmentedLazy<1 << 16, 10> moved(std::move(copy));
+    EXPECT_EQ(moved[2000], 8);
+    
+    original = moved;
+    EXPECT_EQ(original[2000], 8);
+}
@@ -0,0 +1,75 @@
+#include <smart_buffer_seqlock.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+TEST(SmartBufferSeqlockTest, WriteAndReadSnapshot) {
+    SmartBufferSeqlock<64> lock;
+    EXPECT_EQ(lock.version(), 0u);
+    EXPECT_EQ(lock.load()[63], 0);
+    
+    lock.write([](SmartBufferAlwaysStatic<64>& buffer) {
+        buffer[0] = 1;
+        buffer[63] = 2;
+    });
+    EXPECT_EQ(lock.version(), 1u);
+    
+    // write() edits the previous snapshot rather than starting from zero
+    lock.write([](SmartBufferAlwaysStatic<64>& buffer) { buffer[1] = 3; });
+    SmartBufferAlwaysStatic<64> out;
+    ASSERT_TRUE(lock.try_read(out));
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 3);
+    EXPECT_EQ(out[63], 2);
+    EXPECT_EQ(lock.version(), 2u);
+}
+
+TEST(SmartBufferSeqlockTest, OddSizesAndInitialValue) {
+    SmartBufferAlwaysStatic<13> initial;
+    for (size_t i = 0; i < initial.size(); ++i) {
+        initial[i] = static_cast<uint8_t>(i + 1);
+    }
+    SmartBufferSeqlock<13> lock(initial);
+    EXPECT_EQ(lock.size(), 13u);
+    SmartBufferAlwaysStatic<13> out = lock.load();
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[12], 13);
+}
+
+TEST(SmartBufferSeqlockTest, ReadersNeverSeeTornSnapshots) {
+    SmartBufferSeqlock<64> lock;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<long> reads{0};
+    
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            SmartBufferAlwaysStatic<64> out;
+            while (!done.load(std::memory_order_relaxed)) {
+                lock.read(out);
+                for (size_t i = 1; i < 64; ++i) {
+                    if (out[i] != out[0]) {
+                        ++torn;
+                        break;
+                    }
+                }
+                ++reads;
+            }
+        });
+    }
+    for (int i = 0; i < 20000; ++i) {
+        lock.write([i](SmartBufferAlwaysStatic<64>& buffer) { buffer.fill(static_cast<uint8_t>(i)); });
+    }
+    while (reads.load() < 1000) {
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(lock.version(), 20000u);
+}
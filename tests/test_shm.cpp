@@ -0,0 +1,144 @@
+#include <smart_buffer_shm.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+TEST(SmartBufferShmPoolTest, AllocateAndFreeBlocks) {
+    auto pool = SmartBufferShmPool<4096>::create(8, 4);
+    EXPECT_EQ(pool.block_count(), 8u);
+    EXPECT_EQ(pool.ring_capacity(), 4u);
+    EXPECT_EQ(pool.free_blocks(), 8u);
+    
+    std::set<std::uint32_t> seen;
+    std::vector<SmartBufferShmHandle> handles;
+    while (auto handle = pool.try_allocate()) {
+        EXPECT_TRUE(seen.insert(handle->block).second);
+        EXPECT_EQ(pool.offset(*handle) % 4096, 0u);
+        handles.push_back(*handle);
+    }
+    EXPECT_EQ(handles.size(), 8u);
+    EXPECT_EQ(pool.free_blocks(), 0u);
+    
+    for (auto handle : handles) {
+        pool.free(handle);
+    }
+    EXPECT_EQ(pool.free_blocks(), 8u);
+}
+
+TEST(SmartBufferShmPoolTest, RingPassesHandlesInOrder) {
+    auto pool = SmartBufferShmPool<256>::create(16, 3);   // Rounded up to 4
+    EXPECT_EQ(pool.ring_capacity(), 4u);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(pool.try_send({i, i * 10}));
+    }
+    EXPECT_FALSE(pool.try_send({9, 0}));
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        auto handle = pool.try_receive();
+        ASSERT_TRUE(handle.has_value());
+        EXPECT_EQ(handle->block, i);
+        EXPECT_EQ(handle->size, i * 10);
+    }
+    EXPECT_FALSE(pool.try_receive().has_value());
+    EXPECT_FALSE(pool.receive_for(5ms).has_value());
+}
+
+TEST(SmartBufferShmPoolTest, AttachRejectsForeignDescriptors) {
+    auto pool = SmartBufferShmPool<4096>::create(2);
+    EXPECT_THROW(SmartBufferShmPool<8192>::attach(pool.fd()), std::invalid_argument);
+    
+    int fd = memfd_create("not_a_pool", MFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 65536), 0);
+    EXPECT_THROW(SmartBufferShmPool<4096>::attach(fd), std::invalid_argument);
+    close(fd);
+}
+
+TEST(SmartBufferShmPoolTest, HandsPayloadsToAnotherProcess) {
+    constexpr int kMessages = 2000;
+    auto pool = SmartBufferShmPool<4096>::create(16, 8);
+    int fd = pool.fd();
+    
+    // Consumer: checks every payload in place, frees the block, and reports through
+    // its exit status
+    pid_t pid = fork();
+    if (pid == 0) {
+        auto consumer = SmartBufferShmPool<4096>::attach(fd);
+        for (int i = 0; i < kMessages; ++i) {
+            SmartBufferShmHandle handle = consumer.receive();
+            const std::uint8_t* payload = consumer.data(handle);
+            std::uint32_t sequence = 0;
+            std::memcpy(&sequence, payload, sizeof(sequence));
+            if (sequence != static_cast<std::uint32_t>(i) || handle.size != static_cast<std::uint32_t>(100 + i % 3000) ||
+                payload[handle.size - 1] != static_cast<std::uint8_t>(i)) {
+                _exit(1);
+            }
+            consumer.free(handle);
+        }
+        _exit(0);
+    }
+    
+    // Producer: fills blocks in place; allocate() sleeps when the consumer falls behind
+    for (int i = 0; i < kMessages; ++i) {
+        SmartBufferShmHandle handle = pool.allocate();
+        handle.size = static_cast<std::uint32_t>(100 + i % 3000);
+        std::uint8_t* payload = pool.data(handle);
+        auto sequence = static_cast<std::uint32_t>(i);
+        std::memcpy(payload, &sequence, sizeof(sequence));
+        payload[handle.size - 1] = static_cast<std::uint8_t>(i);
+        pool.send(handle);
+    }
+    
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(pool.free_blocks(), 16u);
+}
+
+TEST(SmartBufferShmPoolTest, MultipleProducerProcesses) {
+    constexpr int kProducers = 3;
+    constexpr int kPerProducer = 500;
+    auto pool = SmartBufferShmPool<64>::create(32, 16);
+    int fd = pool.fd();
+    
+    std::vector<pid_t> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            auto producer = SmartBufferShmPool<64>::attach(fd);
+            for (int i = 0; i < kPerProducer; ++i) {
+                SmartBufferShmHandle handle = producer.allocate();
+                handle.size = 1;
+                producer.data(handle)[0] = static_cast<std::uint8_t>(p);
+                producer.send(handle);
+            }
+            _exit(0);
+        }
+        producers.push_back(pid);
+    }
+    
+    int counts[kProducers] = {};
+    for (int i = 0; i < kProducers * kPerProducer; ++i) {
+        auto handle = pool.receive_for(10s);
+        ASSERT_TRUE(handle.has_value());
+        ++counts[pool.data(*handle)[0]];
+        pool.free(*handle);
+    }
+    for (pid_t pid : producers) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    for (int count : counts) {
+        EXPECT_EQ(count, kPerProducer);
+    }
+    EXPECT_EQ(pool.free_blocks(), 32u);
+}
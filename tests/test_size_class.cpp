@@ -0,0 +1,146 @@
+#include <smart_buffer_size_class.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+TEST(SmartBufferHashTest, MatchesReferenceXXH64) {
+    EXPECT_EQ(smart_buffer_hash_bytes("", 0), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(smart_buffer_hash_bytes("abc", 3), 0x44BC2CF5AD770999ULL);
+    
+    std::string long_input(100, 'x');
+    std::uint64_t expected = smart_buffer_hash_bytes(long_input.data(), long_input.size(), 7);
+    EXPECT_EQ(smart_buffer_hash_bytes(long_input.data(), long_input.size(), 7), expected);
+    EXPECT_NE(smart_buffer_hash_bytes(long_input.data(), long_input.size(), 8), expected);
+}
+
+TEST(SmartBufferHashTest, FixedSizeHashMatchesRuntimeHash) {
+    SmartBuffer<32> static_buf;
+    SmartBuffer<100> dynamic_buf;
+    for (size_t i = 0; i < dynamic_buf.size(); ++i) {
+        dynamic_buf[i] = static_cast<uint8_t>(i * 7);
+    }
+    static_buf.fill(0x5A);
+    
+    EXPECT_EQ(smart_buffer_hash(static_buf), smart_buffer_hash_bytes(static_buf.data(), 32));
+    EXPECT_EQ(smart_buffer_hash(dynamic_buf, 3), smart_buffer_hash_bytes(dynamic_buf.data(), 100, 3));
+    
+    SmartBuffer<100> other(dynamic_buf);
+    EXPECT_TRUE(smart_buffer_equal(dynamic_buf, other));
+    other[99] ^= 1;
+    EXPECT_FALSE(smart_buffer_equal(dynamic_buf, other));
+}
+
+TEST(SmartBufferSizeClassTest, RoundsUpToClass) {
+    SmartBufferSizeClassPow2 tiny(1);
+    SmartBufferSizeClassPow2 exact(64);
+    SmartBufferSizeClassPow2 odd(1000);
+    
+    EXPECT_EQ(tiny.capacity(), 16u);
+    EXPECT_EQ(exact.capacity(), 64u);
+    EXPECT_EQ(odd.capacity(), 1024u);
+    EXPECT_EQ(odd.size(), 1000u);
+    EXPECT_EQ(SmartBufferSizeClassPow2::max_size(), 65536u);
+    EXPECT_THROW(SmartBufferSizeClassPow2(65537), std::length_error);
+    
+    for (size_t i = 0; i < odd.capacity(); ++i) {
+        EXPECT_EQ(odd[i], 0);
+    }
+}
+
+TEST(SmartBufferSizeClassTest, FillKeepsTailZero) {
+    SmartBufferSizeClassPow2 buffer(100);
+    buffer.fill(0xAB);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        EXPECT_EQ(buffer[i], 0xAB);
+    }
+    for (size_t i = buffer.size(); i < buffer.capacity(); ++i) {
+        EXPECT_EQ(buffer[i], 0);
+    }
+}
+
+TEST(SmartBufferSizeClassTest, CompareAndHash) {
+    std::vector<uint8_t> payload(300);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+    
+    SmartBufferSizeClassPow2 a(payload.data(), payload.size());
+    SmartBufferSizeClassPow2 b(payload.data(), payload.size());
+    SmartBufferSizeClassPow2 shorter(payload.data(), payload.size() - 1);
+    
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_NE(a, shorter);
+    EXPECT_NE(a.hash(), shorter.hash());
+    
+    b[299] ^= 0xFF;
+    EXPECT_NE(a, b);
+}
+
+TEST(SmartBufferSizeClassTest, CopyMoveAndAssign) {
+    SmartBufferSizeClassPow2 small("hello", 5);
+    SmartBufferSizeClassPow2 large(5000);
+    large.fill(0x11);
+    
+    SmartBufferSizeClassPow2 copy(small);
+    EXPECT_EQ(copy, small);
+    EXPECT_NE(copy.data(), small.data());
+    
+    // Static classes live inline, so the data pointer must follow the move
+    SmartBufferSizeClassPow2 moved(std::move(copy));
+    EXPECT_EQ(moved, small);
+    EXPECT_EQ(copy.size(), 0u);
+    EXPECT_EQ(copy.capacity(), 0u);
+    
+    const uint8_t* large_data = large.data();
+    SmartBufferSizeClassPow2 moved_large(std::move(large));
+    EXPECT_EQ(moved_large.data(), large_data);
+    
+    moved = moved_large;
+    EXPECT_EQ(moved, moved_large);
+    EXPECT_EQ(moved.capacity(), 8192u);
+    
+    moved.assign("abc", 3);
+    EXPECT_EQ(moved.capacity(), 16u);
+    EXPECT_EQ(moved, SmartBufferSizeClassPow2("abc", 3));
+}
+
+TEST(SmartBufferSizeClassTest, SmallClassesAreInline) {
+    SmartBufferSizeClassPow2 small(200);
+    SmartBufferSizeClassPow2 large(300);
+    EXPECT_TRUE(small.is_inline());
+    EXPECT_FALSE(large.is_inline());
+    
+    auto* begin = reinterpret_cast<const uint8_t*>(&small);
+    EXPECT_GE(small.data(), begin);
+    EXPECT_LT(small.data(), begin + sizeof(small));
+    
+    SmartBufferSizeClassPow2 moved(std::move(small));
+    EXPECT_TRUE(moved.is_inline());
+    EXPECT_EQ(moved.capacity(), 256u);
+}
+
+TEST(SmartBufferSizeClassTest, AssignFromOwnBytes) {
+    // Same class: the source overlaps the destination
+    SmartBufferSizeClassPow2 same("abcdefgh", 8);
+    same.assign(same.data() + 2, 6);
+    EXPECT_EQ(same, SmartBufferSizeClassPow2("cdefgh", 6));
+    
+    // Class change: the source lives in the storage being replaced
+    for (std::size_t length : {100u, 5000u}) {
+        SmartBufferSizeClassPow2 shrink(length);
+        for (std::size_t i = 0; i < length; ++i) {
+            shrink[i] = static_cast<uint8_t>(i + 1);
+        }
+        shrink.assign(shrink.data() + 1, 3);
+        EXPECT_EQ(shrink.capacity(), 16u);
+        EXPECT_EQ(shrink, SmartBufferSizeClassPow2("\x02\x03\x04", 3));
+    }
+}
+
+TEST(SmartBufferSizeClassTest, CustomClasses) {
+    using Buffer = SmartBufferSizeClass<24, 100, 1000>;
+    EXPECT_EQ(Buffer::class_count(), 3u);
+    EXPECT_EQ(Buffer(25).capacity(), 100u);
+    EXPECT_EQ(Buffer::class_index_for(1000), 2u);
+}
@@ -0,0 +1,104 @@
+#include <smart_buffer_slot_map.hpp>
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+
+TEST(SmartBufferSlotMapTest, InsertFindErase) {
+    SmartBufferSlotMap<64> map;
+    SmartBuffer<64> buffer;
+    buffer[0] = 1;
+    auto a = map.insert(buffer);
+    buffer[0] = 2;
+    auto b = map.insert(buffer);
+    EXPECT_NE(a, 0u);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ((*map.find(a))[0], 1);
+    EXPECT_EQ(map.at(b)[0], 2);
+    
+    EXPECT_TRUE(map.erase(a));
+    EXPECT_FALSE(map.erase(a));
+    EXPECT_FALSE(map.contains(a));
+    EXPECT_EQ(map.find(a), nullptr);
+    EXPECT_THROW(map.at(a), std::out_of_range);
+    EXPECT_EQ(map.at(b)[0], 2);   // Moved into the hole, handle still valid
+    EXPECT_FALSE(map.contains(0));
+}
+
+TEST(SmartBufferSlotMapTest, ReusedSlotGetsNewGeneration) {
+    SmartBufferSlotMap<64, std::uint32_t> map;
+    auto first = map.emplace();
+    map.erase(first);
+    auto second = map.emplace();
+    EXPECT_EQ(first & map.INDEX_MASK, second & map.INDEX_MASK);
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(map.contains(first));
+    EXPECT_TRUE(map.contains(second));
+}
+
+TEST(SmartBufferSlotMapTest, FreeSlotNeverMatchesThroughGenerationWrap) {
+    SmartBufferSlotMap<64, std::uint32_t> map;
+    SmartBuffer<64> buffer;
+    buffer[0] = 42;
+    auto keep = map.insert(buffer);
+    auto first = map.emplace();
+    ASSERT_TRUE(map.erase(first));
+    
+    // Cycle one slot through every generation: no handle it issued may find it while free
+    std::set<std::uint32_t> issued{first};
+    bool reissued = false;
+    for (std::uint32_t cycle = 0; cycle <= map.GENERATION_MASK; ++cycle) {
+        auto key = map.emplace();
+        ASSERT_EQ(key & map.INDEX_MASK, first & map.INDEX_MASK);
+        ASSERT_NE(key, 0u);
+        reissued |= !issued.insert(key).second;
+        ASSERT_TRUE(map.erase(key));
+        for (auto old : {first, key}) {
+            ASSERT_FALSE(map.contains(old)) << "cycle " << cycle;
+            ASSERT_EQ(map.find(old), nullptr) << "cycle " << cycle;
+            ASSERT_FALSE(map.erase(old)) << "cycle " << cycle;
+        }
+    }
+    EXPECT_TRUE(reissued);
+    EXPECT_EQ(issued.size(), (map.GENERATION_MASK + 1) / 2);
+    ASSERT_EQ(map.size(), 1u);
+    EXPECT_EQ(map.at(keep)[0], 42);
+    
+    // The free list is intact: the slot is reused, then a fresh one is appended
+    auto a = map.emplace();
+    auto b = map.emplace();
+    EXPECT_EQ(a & map.INDEX_MASK, first & map.INDEX_MASK);
+    EXPECT_EQ(b & map.INDEX_MASK, 2u);
+    EXPECT_EQ(map.size(), 3u);
+}
+
+TEST(SmartBufferSlotMapTest, DenseIterationMatchesHandles) {
+    SmartBufferSlotMap<256> map;
+    std::vector<std::uint64_t> keys;
+    for (int i = 0; i < 100; ++i) {
+        keys.push_back(map.emplace());
+        map.at(keys.back())[0] = static_cast<std::uint8_t>(i);
+    }
+    for (int i = 0; i < 100; i += 3) {
+        map.erase(keys[static_cast<std::size_t>(i)]);
+    }
+    EXPECT_EQ(map.size(), 66u);
+    
+    std::set<int> seen;
+    std::size_t position = 0;
+    for (auto& buffer : map) {
+        seen.insert(buffer[0]);
+        EXPECT_EQ(map.find(map.key_at(position)), &buffer);
+        ++position;
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(seen.count(i), i % 3 == 0 ? 0u : 1u);
+        EXPECT_EQ(map.contains(keys[static_cast<std::size_t>(i)]), i % 3 != 0);
+    }
+    
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    for (auto key : keys) {
+        EXPECT_FALSE(map.contains(key));
+    }
+}
@@ -0,0 +1,183 @@
+#include <smart_buffer_small_vector.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+static_assert(smart_buffer_trivially_relocatable_v<SmartBuffer<16>>);
+static_assert(smart_buffer_trivially_relocatable_v<SmartBuffer<64>>);
+static_assert(smart_buffer_trivially_relocatable_v<SmartBufferAlwaysDynamic<8>>);
+static_assert(smart_buffer_trivially_relocatable_v<int>);
+static_assert(SmartBufferSmallVector<SmartBuffer<64>>::relocates_bitwise);
+
+TEST(SmartBufferSmallVectorTest, InlineThenHeap) {
+    SmartBufferSmallVector<SmartBuffer<64>, 4> buffers;
+    EXPECT_TRUE(buffers.is_inline());
+    
+    for (size_t i = 0; i < 4; ++i) {
+        buffers.emplace_back()[0] = static_cast<uint8_t>(i);
+    }
+    EXPECT_TRUE(buffers.is_inline());
+    
+    buffers.emplace_back()[0] = 4;
+    EXPECT_FALSE(buffers.is_inline());
+    EXPECT_EQ(buffers.size(), 5u);
+    
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        EXPECT_EQ(buffers[i][0], static_cast<uint8_t>(i));
+    }
+}
+
+TEST(SmartBufferSmallVectorTest, RelocationKeepsDynamicStorage) {
+    SmartBufferSmallVector<SmartBuffer<128>, 2> buffers;
+    buffers.emplace_back();
+    const uint8_t* original = buffers[0].data();
+    
+    // Growth relocates the owning pointer, not the heap block it points to
+    for (int i = 0; i < 100; ++i) {
+        buffers.emplace_back();
+    }
+    EXPECT_EQ(buffers[0].data(), original);
+}
+
+TEST(SmartBufferSmallVectorTest, MoveAndCopy) {
+    SmartBufferSmallVector<SmartBuffer<64>, 2> inline_vec;
+    inline_vec.emplace_back().fill(0xAA);
+    
+    SmartBufferSmallVector<SmartBuffer<64>, 2> moved(std::move(inline_vec));
+    EXPECT_EQ(moved.size(), 1u);
+    EXPECT_EQ(moved[0][63], 0xAA);
+    EXPECT_TRUE(inline_vec.empty());
+    
+    SmartBufferSmallVector<SmartBuffer<64>, 2> copy(moved);
+    copy[0][0] = 0x11;
+    EXPECT_EQ(moved[0][0], 0xAA);
+    
+    for (int i = 0; i < 10; ++i) {
+        copy.emplace_back();
+    }
+    const uint8_t* heap_element = copy[0].data();
+    moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 11u);
+    EXPECT_EQ(moved[0].data(), heap_element);
+}
+
+TEST(SmartBufferSmallVectorTest, EraseShiftsTail) {
+    SmartBufferSmallVector<SmartBuffer<64>> buffers;
+    for (int i = 0; i < 5; ++i) {
+        buffers.emplace_back()[0] = static_cast<uint8_t>(i);
+    }
+    buffers.erase(buffers.begin() + 1);
+    ASSERT_EQ(buffers.size(), 4u);
+    EXPECT_EQ(buffers[0][0], 0);
+    EXPECT_EQ(buffers[1][0], 2);
+    EXPECT_EQ(buffers[3][0], 4);
+}
+
+TEST(SmartBufferSmallVectorTest, NonRelocatableFallback) {
+    SmartBufferSmallVector<std::string, 1> strings;
+    for (int i = 0; i < 20; ++i) {
+        strings.push_back(std::string(32, static_cast<char>('a' + i)));
+    }
+    strings.erase(strings.begin());
+    EXPECT_EQ(strings.size(), 19u);
+    EXPECT_EQ(strings[0], std::string(32, 'b'));
+}
+
+TEST(SmartBufferSmallVectorTest, PushBackOfOwnElementWhileGrowing) {
+    SmartBufferSmallVector<std::string, 4> strings;
+    for (int i = 0; i < 4; ++i) {
+        strings.push_back(std::string(32, static_cast<char>('a' + i)));
+    }
+    
+    // Inline to heap: the argument lives in the inline storage being vacated
+    ASSERT_EQ(strings.size(), strings.capacity());
+    strings.push_back(strings[0]);
+    EXPECT_FALSE(strings.is_inline());
+    EXPECT_EQ(strings[4], std::string(32, 'a'));
+    
+    // Heap to heap: the argument lives in the block being freed
+    while (strings.size() < strings.capacity()) {
+        strings.push_back(std::string(32, 'z'));
+    }
+    strings.emplace_back(strings[1]);
+    EXPECT_EQ(strings.back(), std::string(32, 'b'));
+    strings.emplace_back(std::move(strings[2]));
+    EXPECT_EQ(strings.back(), std::string(32, 'c'));
+    
+    SmartBufferSmallVector<SmartBuffer<64>, 2> buffers;
+    buffers.emplace_back()[0] = 7;
+    buffers.emplace_back()[0] = 8;
+    buffers.push_back(buffers[0]);
+    EXPECT_EQ(buffers[2][0], 7);
+    while (buffers.size() < buffers.capacity()) {
+        buffers.emplace_back();
+    }
+    buffers.push_back(buffers[1]);
+    EXPECT_EQ(buffers.back()[0], 8);
+}
+
+TEST(SmartBufferDequeTest, GrowthUnwrapsTheRing) {
+    static_assert(SmartBufferDeque<SmartBuffer<64>>::relocates_bitwise);
+    SmartBufferDeque<SmartBuffer<64>> buffers;
+    EXPECT_EQ(buffers.capacity(), 0u);
+    
+    // Wrap the ring before it fills: pop from the front, push at the back
+    for (int i = 0; i < 8; ++i) {
+        buffers.emplace_back()[0] = static_cast<uint8_t>(i);
+    }
+    buffers.pop_front();
+    buffers.pop_front();
+    buffers.emplace_back()[0] = 8;
+    buffers.emplace_back()[0] = 9;
+    ASSERT_EQ(buffers.capacity(), 8u);
+    const uint8_t* storage = buffers[5].data();
+    
+    buffers.emplace_back()[0] = 10;
+    EXPECT_EQ(buffers.capacity(), 16u);
+    ASSERT_EQ(buffers.size(), 9u);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        EXPECT_EQ(buffers[i][0], static_cast<uint8_t>(i + 2));
+    }
+    EXPECT_EQ(buffers[5].data(), storage);
+}
+
+TEST(SmartBufferDequeTest, PushAndPopAtBothEnds) {
+    SmartBufferDeque<std::string> strings;
+    for (int i = 0; i < 50; ++i) {
+        strings.push_back(std::to_string(i));
+        strings.push_front(std::to_string(-i - 1));
+    }
+    ASSERT_EQ(strings.size(), 100u);
+    EXPECT_EQ(strings.front(), "-50");
+    EXPECT_EQ(strings.back(), "49");
+    EXPECT_EQ(strings[50], "0");
+    
+    strings.pop_front();
+    strings.pop_back();
+    EXPECT_EQ(strings.front(), "-49");
+    EXPECT_EQ(strings.back(), "48");
+    
+    SmartBufferDeque<std::string> copy = strings;
+    SmartBufferDeque<std::string> moved = std::move(strings);
+    EXPECT_TRUE(strings.empty());
+    ASSERT_EQ(moved.size(), copy.size());
+    for (size_t i = 0; i < copy.size(); ++i) {
+        EXPECT_EQ(moved[i], copy[i]);
+    }
+}
+
+TEST(SmartBufferDequeTest, PushOfOwnElementWhileGrowing) {
+    SmartBufferDeque<std::string> strings;
+    for (int i = 0; i < 8; ++i) {
+        strings.push_back(std::string(32, static_cast<char>('a' + i)));
+    }
+    ASSERT_EQ(strings.size(), strings.capacity());
+    strings.push_back(strings[0]);
+    EXPECT_EQ(strings.back(), std::string(32, 'a'));
+    
+    while (strings.size() < strings.capacity()) {
+        strings.push_back(std::string(32, 'z'));
+    }
+    strings.push_front(strings[1]);
+    EXPECT_EQ(strings.front(), std::string(32, 'b'));
+    EXPECT_EQ(strings[2], std::string(32, 'b'));
+}
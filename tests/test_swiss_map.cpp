@@ -0,0 +1,105 @@
+#include <smart_buffer_swiss_map.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+SmartBuffer<32> make_key(std::uint64_t seed) {
+    SmartBuffer<32> key;
+    for (std::size_t i = 0; i < 4; ++i) {
+        std::uint64_t word = seed * 0x9E3779B97F4A7C15ULL + i;
+        std::memcpy(key.data() + i * 8, &word, 8);
+    }
+    return key;
+}
+
+// Collides every key into the same group to exercise probing and tombstones
+struct ConstantHash {
+    template<typename Key>
+    std::size_t operator()(const Key&) const noexcept { return 0x1234; }
+};
+
+} // namespace
+
+TEST(SmartBufferSwissMapTest, InsertFindErase) {
+    SmartBufferSwissMap<32, std::string> map;
+    EXPECT_EQ(map.find(make_key(1)), nullptr);
+    
+    auto [value, inserted] = map.insert(make_key(1), "one");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*value, "one");
+    EXPECT_FALSE(map.insert(make_key(1), "uno").second);
+    EXPECT_EQ(*map.find(make_key(1)), "one");
+    map.insert_or_assign(make_key(1), "uno");
+    EXPECT_EQ(*map.find(make_key(1)), "uno");
+    
+    map[make_key(2)] = "two";
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_TRUE(map.erase(make_key(1)));
+    EXPECT_FALSE(map.erase(make_key(1)));
+    EXPECT_FALSE(map.contains(make_key(1)));
+    EXPECT_EQ(*map.find(make_key(2)), "two");
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(SmartBufferSwissMapTest, AcceptsKeysWithAnyStaticThreshold) {
+    SmartBufferSwissMap<48, int> map;
+    SmartBuffer<48> dynamic_key;              // Heap-backed (above the default threshold)
+    dynamic_key[0] = 7;
+    map.insert(dynamic_key, 1);
+    SmartBufferAlwaysStatic<48> static_key;
+    static_key[0] = 7;
+    ASSERT_NE(map.find(static_key), nullptr);
+    EXPECT_EQ(*map.find(static_key), 1);
+}
+
+TEST(SmartBufferSwissMapTest, MatchesUnorderedMapUnderRandomOperations) {
+    SmartBufferSwissMap<32, std::uint64_t> map;
+    std::unordered_map<std::uint64_t, std::uint64_t> reference;
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 200000; ++i) {
+        std::uint64_t id = rng() % 5000;
+        std::uint64_t op = rng() % 3;
+        if (op == 0) {
+            EXPECT_EQ(map.insert(make_key(id), id * 3).second, reference.emplace(id, id * 3).second);
+        } else if (op == 1) {
+            EXPECT_EQ(map.erase(make_key(id)), reference.erase(id) == 1);
+        } else {
+            const std::uint64_t* found = map.find(make_key(id));
+            auto it = reference.find(id);
+            ASSERT_EQ(found != nullptr, it != reference.end());
+            if (found != nullptr) {
+                EXPECT_EQ(*found, it->second);
+            }
+        }
+    }
+    EXPECT_EQ(map.size(), reference.size());
+    std::size_t visited = 0;
+    map.for_each([&](const SmartBufferAlwaysStatic<32>&, std::uint64_t& value) {
+        EXPECT_EQ(reference.count(value / 3), 1u);
+        ++visited;
+    });
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST(SmartBufferSwissMapTest, HandlesCollisionsAndTombstones) {
+    SmartBufferSwissMap<32, std::unique_ptr<int>, ConstantHash> map;
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            map.try_emplace(make_key(static_cast<std::uint64_t>(round * 1000 + i)), std::make_unique<int>(i));
+        }
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_NE(map.find(make_key(static_cast<std::uint64_t>(round * 1000 + i))), nullptr);
+            EXPECT_TRUE(map.erase(make_key(static_cast<std::uint64_t>(round * 1000 + i))));
+        }
+    }
+    EXPECT_TRUE(map.empty());
+    EXPECT_LE(map.capacity(), 256u);   // Tombstones were purged, not grown over
+    
+    map.try_emplace(make_key(1), std::make_unique<int>(5));
+    map.clear();
+    EXPECT_EQ(map.find(make_key(1)), nullptr);
+}
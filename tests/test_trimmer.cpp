@@ -0,0 +1,204 @@
+#include <smart_buffer_trimmer.hpp>
+#include <smart_buffer_zeroing_pool.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+template<typename Pool>
+void fill_idle(Pool& pool, std::size_t count) {
+    std::vector<typename Pool::Buffer> buffers;
+    for (std::size_t i = 0; i < count; ++i) {
+        buffers.push_back(pool.acquire());
+    }
+    for (auto& buffer : buffers) {
+        pool.release(std::move(buffer));
+    }
+}
+
+void write_file(const std::string& path, const std::string& contents) {
+    std::ofstream out(path);
+    out << contents;
+}
+
+SmartBufferTrimConfig quiet_config() {
+    SmartBufferTrimConfig config;
+    config.psi_threshold = 0;
+    config.use_cgroup_events = false;
+    config.return_to_os = false;
+    config.cooldown = 100ms;
+    return config;
+}
+
+} // namespace
+
+TEST(SmartBufferPoolTest, TrimKeepsRequestedCount) {
+    SmartBufferPool<4096> pool;
+    fill_idle(pool, 10);
+    EXPECT_EQ(pool.trim(4), 6u);
+    EXPECT_EQ(pool.idle(), 4u);
+    EXPECT_EQ(pool.trim(8), 0u);
+    EXPECT_GE(pool.advise_idle(), 0u);
+    EXPECT_EQ(pool.idle(), 4u);
+}
+
+TEST(SmartBufferZeroingPoolTest, TrimDropsDirtyBuffersFirst) {
+    SmartBufferZeroingPool<65536> pool(false);
+    pool.reserve(3);
+    fill_idle(pool, 5);  // Takes the 3 clean ones, allocates 2, releases all 5 dirty
+    pool.zero_idle(2);
+    EXPECT_EQ(pool.stats().clean, 2u);
+    EXPECT_EQ(pool.trim(3), 2u);
+    SmartBufferZeroingPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.clean, 2u);
+    EXPECT_EQ(stats.dirty, 1u);
+    
+    // Advised clean buffers still read as zero
+    pool.zero_idle();
+    EXPECT_GT(pool.advise_idle(), 0u);
+    auto buffer = pool.acquire_zeroed();
+    EXPECT_EQ(buffer[30000], 0);
+    EXPECT_EQ(pool.stats().clean_hits, 1u);
+}
+
+TEST(SmartBufferTrimmerTest, WatermarksWithHysteresis) {
+    SmartBufferTrimConfig config = quiet_config();
+    config.high_watermark = 64 * 4096;
+    config.low_watermark = 16 * 4096;
+    SmartBufferPoolTrimmer trimmer(config);
+    SmartBufferPool<4096> pool;
+    trimmer.add(pool);
+    
+    auto start = SmartBufferPoolTrimmer::Clock::now();
+    fill_idle(pool, 64);
+    EXPECT_FALSE(trimmer.poll(start));  // At the high watermark, not above it
+    
+    fill_idle(pool, 100);
+    EXPECT_TRUE(trimmer.poll(start));
+    EXPECT_EQ(pool.idle(), 16u);
+    EXPECT_EQ(trimmer.idle_bytes(), 16u * 4096u);
+    
+    // Regrowing above the watermark within the cooldown does not trim again
+    fill_idle(pool, 80);
+    EXPECT_FALSE(trimmer.poll(start + 50ms));
+    EXPECT_EQ(pool.idle(), 80u);
+    EXPECT_TRUE(trimmer.poll(start + 150ms));
+    EXPECT_EQ(pool.idle(), 16u);
+    
+    SmartBufferTrimStats stats = trimmer.stats();
+    EXPECT_EQ(stats.watermark_trims, 2u);
+    EXPECT_EQ(stats.pressure_trims, 0u);
+    EXPECT_EQ(stats.buffers_freed, 84u + 64u);
+    EXPECT_EQ(stats.bytes_freed, stats.buffers_freed * 4096u);
+}
+
+TEST(SmartBufferTrimmerTest, SplitsLowWatermarkAcrossPools) {
+    SmartBufferTrimConfig config = quiet_config();
+    config.high_watermark = 0;
+    config.low_watermark = 8 * 4096;
+    SmartBufferPoolTrimmer trimmer(config);
+    SmartBufferPool<4096> medium;
+    SmartBufferZeroingPool<16384> large(false);
+    trimmer.add(medium);
+    trimmer.add(large);
+    fill_idle(medium, 16);   // 64 KiB idle
+    fill_idle(large, 4);     // 64 KiB idle
+    
+    EXPECT_TRUE(trimmer.poll());
+    EXPECT_EQ(medium.idle(), 4u);   // Half of the 32 KiB target each
+    EXPECT_EQ(large.idle(), 1u);
+}
+
+TEST(SmartBufferTrimmerTest, PsiPressureTrimsAndAdvises) {
+    std::string psi = testing::TempDir() + "smart_buffer_psi";
+    write_file(psi, "some avg10=0.50 avg60=0.10 avg300=0.00 total=100\n"
+                    "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+    EXPECT_DOUBLE_EQ(SmartBufferPoolTrimmer::read_psi_some_avg10(psi), 0.5);
+    EXPECT_LT(SmartBufferPoolTrimmer::read_psi_some_avg10(psi + ".missing"), 0.0);
+    
+    SmartBufferTrimConfig config = quiet_config();
+    config.psi_path = psi;
+    config.psi_threshold = 5.0;
+    config.low_watermark = 2 * 65536;
+    SmartBufferPoolTrimmer trimmer(config);
+    SmartBufferPool<65536> pool;
+    trimmer.add(pool);
+    fill_idle(pool, 8);
+    
+    EXPECT_FALSE(trimmer.poll());
+    write_file(psi, "some avg10=12.00 avg60=3.00 avg300=1.00 total=5000\n");
+    EXPECT_TRUE(trimmer.poll());
+    EXPECT_EQ(pool.idle(), 2u);
+    SmartBufferTrimStats stats = trimmer.stats();
+    EXPECT_EQ(stats.pressure_trims, 1u);
+    EXPECT_GT(stats.bytes_advised, 0u);
+}
+
+TEST(SmartBufferTrimmerTest, CgroupEventsTriggerOnGrowth) {
+    std::string events = testing::TempDir() + "smart_buffer_memory.events";
+    write_file(events, "low 0\nhigh 3\nmax 0\noom 0\noom_kill 0\n");
+    
+    SmartBufferTrimConfig config = quiet_config();
+    config.use_cgroup_events = true;
+    config.cgroup_events_path = events;
+    config.advise_kept = false;
+    SmartBufferPoolTrimmer trimmer(config);
+    SmartBufferPool<4096> pool;
+    trimmer.add(pool);
+    fill_idle(pool, 4);
+    
+    EXPECT_FALSE(trimmer.poll());   // Counters seen at construction are not new events
+    write_file(events, "low 0\nhigh 4\nmax 0\noom 0\noom_kill 0\n");
+    EXPECT_TRUE(trimmer.poll());
+    EXPECT_EQ(pool.idle(), 0u);
+    EXPECT_EQ(trimmer.stats().bytes_advised, 0u);
+}
+
+TEST(SmartBufferTrimmerTest, CgroupEventDuringCooldownIsNotLost) {
+    std::string events = testing::TempDir() + "smart_buffer_memory_cooldown.events";
+    write_file(events, "low 0\nhigh 0\nmax 0\noom 0\noom_kill 0\n");
+    
+    SmartBufferTrimConfig config = quiet_config();
+    config.use_cgroup_events = true;
+    config.cgroup_events_path = events;
+    config.advise_kept = false;
+    SmartBufferPoolTrimmer trimmer(config);
+    SmartBufferPool<4096> pool;
+    trimmer.add(pool);
+    
+    auto start = SmartBufferPoolTrimmer::Clock::now();
+    fill_idle(pool, 4);
+    write_file(events, "low 0\nhigh 1\nmax 0\noom 0\noom_kill 0\n");
+    EXPECT_TRUE(trimmer.poll(start));
+    
+    // The next event lands inside the cooldown and is held until it expires
+    fill_idle(pool, 4);
+    write_file(events, "low 0\nhigh 2\nmax 0\noom 0\noom_kill 0\n");
+    EXPECT_FALSE(trimmer.poll(start + 10ms));
+    EXPECT_EQ(pool.idle(), 4u);
+    EXPECT_TRUE(trimmer.poll(start + 200ms));
+    EXPECT_EQ(pool.idle(), 0u);
+    EXPECT_EQ(trimmer.stats().pressure_trims, 2u);
+}
+
+TEST(SmartBufferTrimmerTest, BackgroundThreadPolls) {
+    SmartBufferTrimConfig config = quiet_config();
+    config.high_watermark = 0;
+    SmartBufferPoolTrimmer trimmer(config);
+    SmartBufferPool<4096> pool;
+    trimmer.add(pool);
+    fill_idle(pool, 4);
+    
+    trimmer.start(1ms);
+    for (int i = 0; i < 1000 && pool.idle() != 0; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    trimmer.stop();
+    EXPECT_EQ(pool.idle(), 0u);
+    EXPECT_GE(trimmer.stats().polls, 1u);
+}
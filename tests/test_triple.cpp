@@ -0,0 +1,69 @@
+#include <smart_buffer_triple.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+TEST(SmartBufferTripleBufferTest, DeliversLatestFrameOnly) {
+    SmartBufferTripleBuffer<SmartBuffer<2048>> triple;
+    EXPECT_FALSE(triple.dirty());
+    EXPECT_EQ(triple.acquire_latest()[0], 0);
+    
+    for (std::uint8_t frame = 1; frame <= 3; ++frame) {
+        triple.write_buffer()[0] = frame;
+        triple.publish();
+    }
+    EXPECT_TRUE(triple.dirty());
+    const auto& latest = triple.acquire_latest();
+    EXPECT_EQ(latest[0], 3);
+    EXPECT_FALSE(triple.dirty());
+    
+    // Without a new frame the consumer keeps the same one
+    EXPECT_EQ(&triple.acquire_latest(), &latest);
+    EXPECT_EQ(triple.read_buffer()[0], 3);
+}
+
+TEST(SmartBufferTripleBufferTest, BuffersNeverAlias) {
+    SmartBufferTripleBuffer<SmartBuffer<64>> triple;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_NE(&triple.write_buffer(), &triple.read_buffer());
+        triple.publish();
+        EXPECT_NE(&triple.write_buffer(), &triple.acquire_latest());
+    }
+}
+
+TEST(SmartBufferTripleBufferTest, ConsumerSeesCompleteIncreasingFrames) {
+    using Frame = SmartBuffer<2048>;
+    SmartBufferTripleBuffer<Frame> triple;
+    constexpr std::uint32_t kFrames = 100000;
+    std::atomic<bool> done{false};
+    
+    std::thread producer([&] {
+        for (std::uint32_t seq = 1; seq <= kFrames; ++seq) {
+            Frame& frame = triple.write_buffer();
+            for (std::size_t offset = 0; offset < frame.size(); offset += sizeof(seq)) {
+                std::memcpy(frame.data() + offset, &seq, sizeof(seq));
+            }
+            triple.publish();
+        }
+        done = true;
+    });
+    
+    std::uint32_t last = 0;
+    int torn = 0;
+    int backwards = 0;
+    while (!done.load() || triple.dirty()) {
+        const Frame& frame = triple.acquire_latest();
+        std::uint32_t first = 0;
+        std::uint32_t tail = 0;
+        std::memcpy(&first, frame.data(), sizeof(first));
+        std::memcpy(&tail, frame.data() + frame.size() - sizeof(tail), sizeof(tail));
+        torn += first != tail;
+        backwards += first < last;
+        last = first;
+    }
+    producer.join();
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(backwards, 0);
+    EXPECT_EQ(last, kFrames);
+}
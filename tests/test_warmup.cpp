@@ -0,0 +1,107 @@
+#include <smart_buffer_warmup.hpp>
+#include <smart_buffer_pool.hpp>
+#include <smart_buffer_zeroing_pool.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+TEST(SmartBufferWarmupTest, FillsPoolToCount) {
+    SmartBufferPool<4096> pool;
+    EXPECT_EQ(smart_buffer_warmup(pool, 10), 10u);
+    EXPECT_EQ(pool.idle(), 10u);
+    EXPECT_EQ(smart_buffer_warmup(pool, 12), 2u);
+    EXPECT_EQ(smart_buffer_warmup(pool, 5), 0u);
+    EXPECT_EQ(pool.idle(), 12u);
+    EXPECT_EQ(pool.stats().allocations, 12u);
+}
+
+TEST(SmartBufferWarmupTest, ParallelWarmupProducesZeroedBuffers) {
+    SmartBufferZeroingPool<8192> pool(false);
+    EXPECT_EQ(smart_buffer_warmup(pool, 37, 4), 37u);
+    SmartBufferZeroingPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.clean, 37u);
+    EXPECT_EQ(stats.dirty, 0u);
+    
+    auto buffer = pool.acquire_zeroed();
+    EXPECT_EQ(buffer[8191], 0);
+    EXPECT_EQ(pool.stats().clean_hits, 1u);
+}
+
+TEST(SmartBufferWarmupTest, AdoptRespectsMaxIdle) {
+    SmartBufferPool<256> pool(3);
+    EXPECT_EQ(smart_buffer_warmup(pool, 8, 2), 3u);
+    EXPECT_EQ(pool.idle(), 3u);
+    
+    SmartBufferZeroingPool<256> zeroing(false, 2);
+    EXPECT_EQ(smart_buffer_warmup(zeroing, 5), 2u);
+    EXPECT_EQ(zeroing.stats().clean, 2u);
+    
+    std::vector<SmartBuffer<256>> extra(4);
+    EXPECT_EQ(pool.adopt(std::move(extra)), 0u);
+}
+
+TEST(SmartBufferWarmupTest, ProfileRecordsPeakLiveCounts) {
+    SmartBufferPool<1024> small;
+    SmartBufferPool<4096> large;
+    {
+        std::vector<SmartBuffer<1024>> held;
+        for (int i = 0; i < 5; ++i) {
+            held.push_back(small.acquire());
+        }
+        for (auto& buffer : held) {
+            small.release(std::move(buffer));
+        }
+        auto one = large.acquire();
+        large.release(std::move(one));
+    }
+    
+    SmartBufferWarmupProfile profile;
+    profile.record(small, large);
+    EXPECT_EQ(profile.count(1024), 5u);
+    EXPECT_EQ(profile.count(4096), 1u);
+    EXPECT_EQ(profile.count(64), 0u);
+    
+    profile.scale(1.5);
+    EXPECT_EQ(profile.count(1024), 8u);
+    EXPECT_EQ(profile.count(4096), 2u);
+    
+    // Recording a lower peak keeps the larger count
+    SmartBufferPool<1024> quiet;
+    profile.record(quiet);
+    EXPECT_EQ(profile.count(1024), 8u);
+}
+
+TEST(SmartBufferWarmupTest, ProfileRoundTripsAndDrivesWarmup) {
+    SmartBufferWarmupProfile recorded;
+    recorded.set(256, 4);
+    recorded.set(4096, 9);
+    std::stringstream text;
+    recorded.save(text);
+    
+    SmartBufferWarmupProfile loaded;
+    loaded.load(text);
+    EXPECT_EQ(loaded.counts(), recorded.counts());
+    
+    SmartBufferPool<256> small;
+    SmartBufferPool<4096> large;
+    SmartBufferPool<65536> unprofiled;
+    EXPECT_EQ(smart_buffer_warmup(loaded, 2, small, large, unprofiled), 13u);
+    EXPECT_EQ(small.idle(), 4u);
+    EXPECT_EQ(large.idle(), 9u);
+    EXPECT_EQ(unprofiled.idle(), 0u);
+}
+
+TEST(SmartBufferWarmupTest, ProfileLoadRejectsMalformedLines) {
+    SmartBufferWarmupProfile profile;
+    std::istringstream ok("# comment\n\n  1024 3\n");
+    profile.load(ok);
+    EXPECT_EQ(profile.count(1024), 3u);
+    
+    std::istringstream bad("4096 lots\n");
+    EXPECT_THROW(profile.load(bad), std::invalid_argument);
+    std::istringstream extra("4096 2 7\n");
+    EXPECT_THROW(profile.load(extra), std::invalid_argument);
+    
+    EXPECT_FALSE(profile.load_file("/nonexistent/smart_buffer_profile"));
+}
@@ -0,0 +1,138 @@
+#include <smart_buffer_zeroing_pool.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool all_zero(const SmartBuffer4K& buffer) {
+    return std::all_of(buffer.data(), buffer.data() + buffer.actual_size(), [](uint8_t b) { return b == 0; });
+}
+
+} // namespace
+
+TEST(SmartBufferZeroingPoolTest, IdleHookMovesDirtyBuffersToCleanList) {
+    SmartBufferZeroingPool<4096> pool(false);
+    EXPECT_FALSE(pool.has_background_thread());
+    
+    auto buffer = pool.acquire();
+    const uint8_t* storage = buffer.data();
+    buffer.fill(0xCD);
+    pool.release(std::move(buffer));
+    
+    SmartBufferZeroingPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.dirty, 1u);
+    EXPECT_EQ(stats.clean, 0u);
+    
+    EXPECT_EQ(pool.zero_idle(), 1u);
+    stats = pool.stats();
+    EXPECT_EQ(stats.dirty, 0u);
+    EXPECT_EQ(stats.clean, 1u);
+    EXPECT_EQ(stats.background_zeroes, 1u);
+    
+    auto clean = pool.acquire_zeroed();
+    EXPECT_EQ(clean.data(), storage);
+    EXPECT_TRUE(all_zero(clean));
+    EXPECT_EQ(pool.stats().clean_hits, 1u);
+}
+
+TEST(SmartBufferZeroingPoolTest, AcquireZeroedFallsBackToInlineZeroing) {
+    SmartBufferZeroingPool<4096> pool(false);
+    auto buffer = pool.acquire();
+    buffer.fill(0xFF);
+    pool.release(std::move(buffer));
+    
+    auto zeroed = pool.acquire_zeroed();
+    EXPECT_TRUE(all_zero(zeroed));
+    SmartBufferZeroingPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.inline_zeroes, 1u);
+    EXPECT_EQ(stats.clean_hits, 0u);
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_EQ(stats.live, 1u);
+}
+
+TEST(SmartBufferZeroingPoolTest, AcquirePrefersDirtyBuffers) {
+    SmartBufferZeroingPool<4096> pool(false);
+    pool.reserve(1);
+    auto dirty = pool.acquire();
+    dirty.fill(1);
+    const uint8_t* dirty_storage = dirty.data();
+    pool.release(std::move(dirty));
+    pool.reserve(1);  // reserve() only counts clean buffers
+    
+    auto buffer = pool.acquire();
+    EXPECT_EQ(buffer.data(), dirty_storage);
+    EXPECT_EQ(pool.stats().clean, 1u);
+}
+
+TEST(SmartBufferZeroingPoolTest, BackgroundThreadCleansReleasedBuffers) {
+    SmartBufferZeroingPool<4096> pool;
+    EXPECT_TRUE(pool.has_background_thread());
+    
+    std::vector<SmartBuffer4K> buffers;
+    for (int i = 0; i < 16; ++i) {
+        buffers.push_back(pool.acquire());
+        buffers.back().fill(static_cast<uint8_t>(i + 1));
+    }
+    for (auto& buffer : buffers) {
+        pool.release(std::move(buffer));
+    }
+    pool.wait_clean();
+    
+    SmartBufferZeroingPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.clean, 16u);
+    EXPECT_EQ(stats.dirty, 0u);
+    EXPECT_EQ(stats.background_zeroes, 16u);
+    
+    for (int i = 0; i < 16; ++i) {
+        auto buffer = pool.acquire_zeroed();
+        EXPECT_TRUE(all_zero(buffer));
+    }
+    EXPECT_EQ(pool.stats().clean_hits, 16u);
+}
+
+TEST(SmartBufferZeroingPoolTest, WaitCleanReturnsWhenIdleHookZeroesLastBuffer) {
+    SmartBufferZeroingPool<4096> pool;
+    for (int round = 0; round < 200; ++round) {
+        std::vector<SmartBuffer4K> buffers;
+        for (int i = 0; i < 8; ++i) {
+            buffers.push_back(pool.acquire());
+        }
+        for (auto& buffer : buffers) {
+            pool.release(std::move(buffer));
+        }
+        // The idle hook races the worker for the dirty list
+        std::thread idle([&pool] { pool.zero_idle(); });
+        pool.wait_clean();
+        idle.join();
+        ASSERT_EQ(pool.stats().dirty, 0u) << "round " << round;
+    }
+    EXPECT_EQ(pool.stats().background_zeroes, 200u * 8);
+}
+
+TEST(SmartBufferZeroingPoolTest, MaxIdleLimitsRetainedBuffers) {
+    SmartBufferZeroingPool<4096> pool(false, 2);
+    std::vector<SmartBuffer4K> buffers;
+    for (int i = 0; i < 4; ++i) {
+        buffers.push_back(pool.acquire());
+    }
+    for (auto& buffer : buffers) {
+        pool.release(std::move(buffer));
+    }
+    SmartBufferZeroingPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.dirty, 2u);
+    EXPECT_EQ(stats.live, 0u);
+    EXPECT_EQ(stats.peak_live, 4u);
+    
+    pool.shrink();
+    EXPECT_EQ(pool.stats().dirty, 0u);
+}
+
+TEST(SmartBufferZeroingPoolTest, NonTemporalZeroHandlesUnalignedEdges) {
+    std::vector<uint8_t> block(300, 0xAA);
+    smart_buffer_detail::zero_nontemporal(block.data() + 3, 290);
+    EXPECT_EQ(block[2], 0xAA);
+    EXPECT_TRUE(std::all_of(block.begin() + 3, block.begin() + 293, [](uint8_t b) { return b == 0; }));
+    EXPECT_EQ(block[293], 0xAA);
+}